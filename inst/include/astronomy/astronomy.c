@@ -42,6 +42,20 @@
 #endif
 #endif
 
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#define EPHEM_MMAP_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#define EPHEM_MMAP_WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
 #include "astronomy.h"
 
 #ifdef __FAST_MATH__
@@ -128,6 +142,26 @@ struct astro_grav_sim_s
     gravsim_endpoint_t *curr;
 };
 
+typedef struct
+{
+    astro_time_t  time;
+    body_state_t  gravitators[1 + BODY_SUN];
+    double       *rx, *ry, *rz;     /* positions [au] */
+    double       *vx, *vy, *vz;     /* velocities [au/day] */
+    double       *ax, *ay, *az;     /* accelerations [au/day^2] */
+}
+grav_batch_endpoint_t;
+
+struct astro_grav_batch_s
+{
+    astro_body_t            originBody;
+    int                     numBodies;
+    double                  stepDays;       /* adaptive step size to try next, or 0 before the first adaptive step */
+    grav_batch_endpoint_t   endpoint[2];
+    grav_batch_endpoint_t  *prev;
+    grav_batch_endpoint_t  *curr;
+};
+
 typedef struct
 {
     double ra;
@@ -143,6 +177,73 @@ stardef_t;
 
 /** @endcond */
 
+/*------------------ atomic pointers ------------------*/
+
+/*
+    Lazily built tables (Pluto orbit segments, compiled ephemerides) are filled
+    privately and then published with an atomic compare-and-swap, so concurrent
+    readers never observe a partially filled table.
+*/
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+static void *AtomicLoadPtr(void **slot)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+    return _InterlockedCompareExchangePointer((void * volatile *)slot, NULL, NULL);
+#else
+    /* No atomic primitives available: lazily built tables are only safe for single-threaded use. */
+    return *slot;
+#endif
+}
+
+static void *AtomicExchangePtr(void **slot, void *ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_exchange_n(slot, ptr, __ATOMIC_ACQ_REL);
+#elif defined(_MSC_VER)
+    return _InterlockedExchangePointer((void * volatile *)slot, ptr);
+#else
+    void *old = *slot;
+    *slot = ptr;
+    return old;
+#endif
+}
+
+/* Stores `ptr` into an empty slot. Returns 0 if another pointer was stored there first. */
+static int AtomicPublishPtr(void **slot, void *ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    void *expected = NULL;
+    return __atomic_compare_exchange_n(slot, &expected, ptr, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+    return _InterlockedCompareExchangePointer((void * volatile *)slot, ptr, NULL) == NULL;
+#else
+    if (*slot != NULL)
+        return 0;
+    *slot = ptr;
+    return 1;
+#endif
+}
+
+/*
+    ASTRO_THREAD_LOCAL marks small per-thread memo tables. It is left undefined
+    on compilers without thread-local storage, and the memos are then disabled.
+*/
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define ASTRO_THREAD_LOCAL  thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define ASTRO_THREAD_LOCAL  _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#define ASTRO_THREAD_LOCAL  __thread
+#elif defined(_MSC_VER)
+#define ASTRO_THREAD_LOCAL  __declspec(thread)
+#endif
+
 #define NSTARS 8
 static stardef_t StarTable[NSTARS];
 
@@ -896,8 +997,118 @@ double Astronomy_DeltaT_JplHorizons(double ut)
     return Astronomy_DeltaT_EspenakMeeus(ut);
 }
 
+/** @cond DOXYGEN_SKIP */
+#define DELTAT_TABLE_FIRST_YEAR  (-2000)
+#define DELTAT_TABLE_LAST_YEAR   (+3000)
+#define DELTAT_TABLE_SIZE        (DELTAT_TABLE_LAST_YEAR - DELTAT_TABLE_FIRST_YEAR + 1)
+
+typedef struct
+{
+    double value[DELTAT_TABLE_SIZE];    /* Espenak-Meeus Delta T at the start of each year */
+    double slope[DELTAT_TABLE_SIZE];    /* monotone (Fritsch-Carlson) derivative, seconds per year */
+}
+deltat_table_t;
+/** @endcond */
+
+/*
+    The Delta T table is built on first use and published atomically,
+    like the Pluto segments. If two threads race, the loser frees its copy.
+*/
+static void *deltat_table;
+
+static double DeltaTYear(double y)
+{
+    return Astronomy_DeltaT_EspenakMeeus((y - 2000.0)*DAYS_PER_TROPICAL_YEAR + 14.0);
+}
+
+static const deltat_table_t *DeltaTTable(void)
+{
+    deltat_table_t *table;
+    double left, right;
+    int i;
+
+    table = (deltat_table_t *) AtomicLoadPtr(&deltat_table);
+    if (table != NULL)
+        return table;
+
+    table = (deltat_table_t *) malloc(sizeof(deltat_table_t));
+    if (table == NULL)
+        return NULL;
+
+    for (i=0; i < DELTAT_TABLE_SIZE; ++i)
+        table->value[i] = DeltaTYear(DELTAT_TABLE_FIRST_YEAR + i);
+
+    /* Fritsch-Carlson slopes: zero at local extrema, so the interpolant never overshoots the samples. */
+    table->slope[0] = table->value[1] - table->value[0];
+    table->slope[DELTAT_TABLE_SIZE - 1] = table->value[DELTAT_TABLE_SIZE - 1] - table->value[DELTAT_TABLE_SIZE - 2];
+    for (i=1; i < DELTAT_TABLE_SIZE - 1; ++i)
+    {
+        left  = table->value[i] - table->value[i-1];
+        right = table->value[i+1] - table->value[i];
+        if (left * right <= 0.0)
+            table->slope[i] = 0.0;
+        else
+            table->slope[i] = 2.0 / (1.0/left + 1.0/right);
+    }
+
+    if (!AtomicPublishPtr(&deltat_table, table))
+    {
+        free(table);
+        table = (deltat_table_t *) AtomicLoadPtr(&deltat_table);
+    }
+    return table;
+}
+
+/**
+ * @brief A table-driven approximation of the default Delta T function.
+ *
+ * Samples #Astronomy_DeltaT_EspenakMeeus once per year from -2000 to +3000
+ * and interpolates between the samples with a monotone cubic Hermite spline,
+ * so each call costs a table lookup instead of a chain of polynomial branches.
+ * The table is built on first use. Within the table the result agrees with
+ * #Astronomy_DeltaT_EspenakMeeus to a small fraction of a second, except within
+ * a year of the boundaries between its polynomial pieces, where this
+ * function is continuous and the original is not.
+ * Outside the table, and if the table cannot be allocated, this function
+ * returns #Astronomy_DeltaT_EspenakMeeus unchanged.
+ *
+ * @param ut
+ *      The floating point number of days since noon UTC on January 1, 2000.
+ *
+ * @returns
+ *      The estimated difference TT-UT on the given date, expressed in seconds.
+ */
+double Astronomy_DeltaT_Table(double ut)
+{
+    const deltat_table_t *table;
+    double x, u, u2, u3;
+    int k;
+
+    x = ((ut - 14) / DAYS_PER_TROPICAL_YEAR) + (2000 - DELTAT_TABLE_FIRST_YEAR);
+    if (!(x >= 0.0 && x < DELTAT_TABLE_SIZE - 1))
+        return Astronomy_DeltaT_EspenakMeeus(ut);
+
+    table = DeltaTTable();
+    if (table == NULL)
+        return Astronomy_DeltaT_EspenakMeeus(ut);
+
+    k = (int) x;
+    u = x - k;
+    u2 = u*u;
+    u3 = u*u2;
+    return
+        (2*u3 - 3*u2 + 1) * table->value[k] +
+        (u3 - 2*u2 + u)   * table->slope[k] +
+        (-2*u3 + 3*u2)    * table->value[k+1] +
+        (u3 - u2)         * table->slope[k+1];
+}
+
 static astro_deltat_func DeltaTFunc = Astronomy_DeltaT_EspenakMeeus;
 
+#if defined(ASTRO_THREAD_LOCAL)
+static ASTRO_THREAD_LOCAL astro_deltat_func ThreadDeltaTFunc;
+#endif
+
 /**
  * @brief Changes the function Astronomy Engine uses to calculate Delta T.
  *
@@ -918,9 +1129,50 @@ void Astronomy_SetDeltaTFunction(astro_deltat_func func)
     DeltaTFunc = func;
 }
 
+/**
+ * @brief Changes the Delta T function for the calling thread only.
+ *
+ * Overrides the function set by #Astronomy_SetDeltaTFunction for time
+ * conversions made on the calling thread, so that concurrent jobs on
+ * different threads can use different Delta T models.
+ * Passing NULL removes the override, and the thread goes back to the
+ * process-wide function. New threads start without an override.
+ *
+ * On compilers without thread-local storage there is no per-thread state,
+ * and this function changes the process-wide function instead
+ * (passing NULL restores #Astronomy_DeltaT_EspenakMeeus).
+ *
+ * @param func
+ *      A pointer to a function to convert UT values to DeltaT values, or NULL.
+ */
+void Astronomy_SetThreadDeltaTFunction(astro_deltat_func func)
+{
+#if defined(ASTRO_THREAD_LOCAL)
+    ThreadDeltaTFunc = func;
+#else
+    DeltaTFunc = (func != NULL) ? func : Astronomy_DeltaT_EspenakMeeus;
+#endif
+}
+
+/**
+ * @brief Returns the Delta T function in effect on the calling thread.
+ *
+ * @returns
+ *      The function set by #Astronomy_SetThreadDeltaTFunction on this thread,
+ *      or otherwise the process-wide function set by #Astronomy_SetDeltaTFunction.
+ */
+astro_deltat_func Astronomy_GetDeltaTFunction(void)
+{
+#if defined(ASTRO_THREAD_LOCAL)
+    if (ThreadDeltaTFunc != NULL)
+        return ThreadDeltaTFunc;
+#endif
+    return DeltaTFunc;
+}
+
 static double TerrestrialTime(double ut)
 {
-    return ut + DeltaTFunc(ut)/86400.0;
+    return ut + Astronomy_GetDeltaTFunction()(ut)/86400.0;
 }
 
 /**
@@ -1372,50 +1624,128 @@ astro_observer_t Astronomy_MakeObserver(double latitude, double longitude, doubl
     return observer;
 }
 
-static void iau2000b(astro_time_t *time)
-{
-    /* Truncated and hand-optimized nutation model. */
+#if defined(ASTRO_THREAD_LOCAL)
+/*
+    The nutation angles, the precession and nutation rotations, and the sidereal
+    time are pure functions of the time, but callers usually pass a fresh
+    astro_time_t for each calculation, so the values cached inside it are lost.
+    Each thread therefore remembers them for its most recently used times.
+    Only the FROM_2000 rotations are kept: the INTO_2000 ones are their transposes.
+*/
+#define FRAME_MEMO_SIZE  8
 
-    if ((time != NULL) && isnan(time->psi))
-    {
-        double t, elp, f, d, om, arg, dp, de, sarg, carg;
+typedef struct
+{
+    double tt;                      /* terrestrial time this entry describes */
+    double psi;                     /* nutation angles, or NAN if not yet calculated */
+    double eps;
+    double st_ut;                   /* UT that `st` was calculated for, or NAN */
+    double st;                      /* Greenwich apparent sidereal time */
+    int has_prec;
+    int has_nut;
+    astro_rotation_t prec;          /* precession_rot(FROM_2000) */
+    astro_rotation_t nut;           /* nutation_rot(FROM_2000) */
+}
+frame_memo_entry_t;
 
-        t = time->tt / 36525.0;
-        elp = fmod(1287104.79305 + t * 129596581.0481,  ASEC360) * ASEC2RAD;
-        f   = fmod(335779.526232 + t * 1739527262.8478, ASEC360) * ASEC2RAD;
-        d   = fmod(1072260.70369 + t * 1602961601.2090, ASEC360) * ASEC2RAD;
-        om  = fmod(450160.398036 - t * 6962890.5431,    ASEC360) * ASEC2RAD;
+typedef struct
+{
+    int count;
+    int next;
+    frame_memo_entry_t entry[FRAME_MEMO_SIZE];
+}
+frame_memo_t;
 
-        sarg = sin(om);
-        carg = cos(om);
-        dp = (-172064161.0 - 174666.0*t)*sarg + 33386.0*carg;
-        de = (92052331.0 + 9086.0*t)*carg + 15377.0*sarg;
+static ASTRO_THREAD_LOCAL frame_memo_t FrameMemo;
 
-        arg = 2.0*(f - d + om);
-        sarg = sin(arg);
-        carg = cos(arg);
-        dp += (-13170906.0 - 1675.0*t)*sarg - 13696.0*carg;
-        de += (5730336.0 - 3015.0*t)*carg - 4587.0*sarg;
+/* Finds the calling thread's memo entry for `tt`, replacing the oldest entry if there is none. */
+static frame_memo_entry_t *FrameMemoEntry(double tt)
+{
+    frame_memo_t *memo = &FrameMemo;
+    frame_memo_entry_t *entry;
+    int i, k;
 
-        arg = 2.0*(f + om);
-        sarg = sin(arg);
-        carg = cos(arg);
-        dp += (-2276413.0 - 234.0*t)*sarg + 2796.0*carg;
-        de += (978459.0 - 485.0*t)*carg + 1374.0*sarg;
+    for (i=1; i <= memo->count; ++i)
+    {
+        /* Search from the most recently added entry backward. */
+        k = (memo->next - i + FRAME_MEMO_SIZE) % FRAME_MEMO_SIZE;
+        if (memo->entry[k].tt == tt)
+            return &memo->entry[k];
+    }
 
-        arg = 2.0*om;
-        sarg = sin(arg);
-        carg = cos(arg);
-        dp += (2074554.0 + 207.0*t)*sarg - 698.0*carg;
-        de += (-897492.0 + 470.0*t)*carg - 291.0*sarg;
+    entry = &memo->entry[memo->next];
+    entry->tt = tt;
+    entry->psi = entry->eps = NAN;
+    entry->st_ut = entry->st = NAN;
+    entry->has_prec = entry->has_nut = 0;
+    memo->next = (memo->next + 1) % FRAME_MEMO_SIZE;
+    if (memo->count < FRAME_MEMO_SIZE)
+        ++memo->count;
+    return entry;
+}
+#endif
 
-        sarg = sin(elp);
-        carg = cos(elp);
-        dp += (1475877.0 - 3633.0*t)*sarg + 11817.0*carg;
-        de += (73871.0 - 184.0*t)*carg - 1924.0*sarg;
+static void iau2000b_angles(double tt, double *psi, double *eps)
+{
+    /* Truncated and hand-optimized nutation model. */
+    double t, elp, f, d, om, arg, dp, de, sarg, carg;
+
+    t = tt / 36525.0;
+    elp = fmod(1287104.79305 + t * 129596581.0481,  ASEC360) * ASEC2RAD;
+    f   = fmod(335779.526232 + t * 1739527262.8478, ASEC360) * ASEC2RAD;
+    d   = fmod(1072260.70369 + t * 1602961601.2090, ASEC360) * ASEC2RAD;
+    om  = fmod(450160.398036 - t * 6962890.5431,    ASEC360) * ASEC2RAD;
+
+    sarg = sin(om);
+    carg = cos(om);
+    dp = (-172064161.0 - 174666.0*t)*sarg + 33386.0*carg;
+    de = (92052331.0 + 9086.0*t)*carg + 15377.0*sarg;
+
+    arg = 2.0*(f - d + om);
+    sarg = sin(arg);
+    carg = cos(arg);
+    dp += (-13170906.0 - 1675.0*t)*sarg - 13696.0*carg;
+    de += (5730336.0 - 3015.0*t)*carg - 4587.0*sarg;
+
+    arg = 2.0*(f + om);
+    sarg = sin(arg);
+    carg = cos(arg);
+    dp += (-2276413.0 - 234.0*t)*sarg + 2796.0*carg;
+    de += (978459.0 - 485.0*t)*carg + 1374.0*sarg;
+
+    arg = 2.0*om;
+    sarg = sin(arg);
+    carg = cos(arg);
+    dp += (2074554.0 + 207.0*t)*sarg - 698.0*carg;
+    de += (-897492.0 + 470.0*t)*carg - 291.0*sarg;
+
+    sarg = sin(elp);
+    carg = cos(elp);
+    dp += (1475877.0 - 3633.0*t)*sarg + 11817.0*carg;
+    de += (73871.0 - 184.0*t)*carg - 1924.0*sarg;
+
+    *psi = -0.000135 + (dp * 1.0e-7);
+    *eps = +0.000388 + (de * 1.0e-7);
+}
 
-        time->psi = -0.000135 + (dp * 1.0e-7);
-        time->eps = +0.000388 + (de * 1.0e-7);
+static void iau2000b(astro_time_t *time)
+{
+    if ((time != NULL) && isnan(time->psi))
+    {
+#if defined(ASTRO_THREAD_LOCAL)
+        frame_memo_entry_t *entry = FrameMemoEntry(time->tt);
+        if (!isnan(entry->psi))
+        {
+            time->psi = entry->psi;
+            time->eps = entry->eps;
+            return;
+        }
+#endif
+        iau2000b_angles(time->tt, &time->psi, &time->eps);
+#if defined(ASTRO_THREAD_LOCAL)
+        entry->psi = time->psi;
+        entry->eps = time->eps;
+#endif
     }
 }
 
@@ -1479,7 +1809,7 @@ static void ecl2equ_vec(astro_time_t time, const double ecl[3], double equ[3])
     obl_ecl2equ_vec(obl, time, ecl, equ);
 }
 
-static astro_rotation_t precession_rot(astro_time_t time, precess_dir_t dir)
+static astro_rotation_t precession_rot_calc(astro_time_t time, precess_dir_t dir)
 {
     /*
         dir==INTO_2000: converts mean equator of date (EQM) to J2000 mean equator (EQJ).
@@ -1567,6 +1897,22 @@ static astro_rotation_t precession_rot(astro_time_t time, precess_dir_t dir)
 }
 
 
+static astro_rotation_t precession_rot(astro_time_t time, precess_dir_t dir)
+{
+#if defined(ASTRO_THREAD_LOCAL)
+    frame_memo_entry_t *entry = FrameMemoEntry(time.tt);
+    if (!entry->has_prec)
+    {
+        entry->prec = precession_rot_calc(time, FROM_2000);
+        entry->has_prec = 1;
+    }
+    return (dir == FROM_2000) ? entry->prec : Astronomy_InverseRotation(entry->prec);
+#else
+    return precession_rot_calc(time, dir);
+#endif
+}
+
+
 static void rotate(const double invec[3], const double rot[3][3], double outvec[3])
 {
     outvec[0] = rot[0][0]*invec[0] + rot[1][0]*invec[1] + rot[2][0]*invec[2];
@@ -1645,7 +1991,7 @@ static astro_equatorial_t vector2radec(const double pos[3], astro_time_t time)
 }
 
 
-static astro_rotation_t nutation_rot(astro_time_t *time, precess_dir_t dir)
+static astro_rotation_t nutation_rot_calc(astro_time_t *time, precess_dir_t dir)
 {
     /*
         Creates a rotation matrix that adds/removes nutation from
@@ -1723,6 +2069,32 @@ static astro_rotation_t nutation_rot(astro_time_t *time, precess_dir_t dir)
     return rotation;
 }
 
+static astro_rotation_t nutation_rot(astro_time_t *time, precess_dir_t dir)
+{
+#if defined(ASTRO_THREAD_LOCAL)
+    frame_memo_entry_t *entry;
+
+    if (time == NULL)
+        return RotationErr(ASTRO_INVALID_PARAMETER);
+
+    entry = FrameMemoEntry(time->tt);
+    if (!entry->has_nut)
+    {
+        entry->nut = nutation_rot_calc(time, FROM_2000);
+        entry->has_nut = 1;
+    }
+    else if (isnan(time->psi))
+    {
+        /* Leave the nutation angles cached in the caller's time, as nutation_rot_calc would. */
+        iau2000b(time);
+    }
+    return (dir == FROM_2000) ? entry->nut : Astronomy_InverseRotation(entry->nut);
+#else
+    return nutation_rot_calc(time, dir);
+#endif
+}
+
+
 static void nutation(
     const double inpos[3],
     astro_time_t *time,
@@ -1757,6 +2129,28 @@ static double era(double ut)        /* Earth Rotation Angle */
     return theta;
 }
 
+/*
+    Sidereal time in hours [0, 24) from the Earth Rotation Angle `theta` in degrees
+    and the equation of the equinoxes `eqeq` in arcseconds.
+    Passing eqeq = 0 gives mean sidereal time (GMST) instead of apparent (GAST).
+*/
+static double sidereal_hours(double theta, double tt, double eqeq)
+{
+    double t = tt / 36525.0;
+    double st = (eqeq + 0.014506 +
+        (((( -    0.0000000368   * t
+            -    0.000029956  ) * t
+            -    0.00000044   ) * t
+            +    1.3915817    ) * t
+            + 4612.156534     ) * t);
+
+    double gst = fmod(st/3600.0 + theta, 360.0) / 15.0;
+    if (gst < 0.0)
+        gst += 24.0;
+
+    return gst;
+}
+
 /**
  * @brief Calculates Greenwich Apparent Sidereal Time (GAST).
  *
@@ -1791,26 +2185,100 @@ double Astronomy_SiderealTime(astro_time_t *time)
 
     if (isnan(time->st))
     {
-        double t = time->tt / 36525.0;
-        double eqeq = 15.0 * e_tilt(time).ee;    /* Replace with eqeq=0 to get GMST instead of GAST (if we ever need it) */
-        double theta = era(time->ut);
-        double st = (eqeq + 0.014506 +
-            (((( -    0.0000000368   * t
-                -    0.000029956  ) * t
-                -    0.00000044   ) * t
-                +    1.3915817    ) * t
-                + 4612.156534     ) * t);
-
-        double gst = fmod(st/3600.0 + theta, 360.0) / 15.0;
-        if (gst < 0.0)
-            gst += 24.0;
+#if defined(ASTRO_THREAD_LOCAL)
+        frame_memo_entry_t *entry = FrameMemoEntry(time->tt);
+        if (entry->st_ut == time->ut)
+        {
+            time->st = entry->st;
+            return time->st;
+        }
+#endif
+        double eqeq = 15.0 * e_tilt(time).ee;
+        double gst = sidereal_hours(era(time->ut), time->tt, eqeq);
 
         time->st = gst;
+#if defined(ASTRO_THREAD_LOCAL)
+        entry->st_ut = time->ut;
+        entry->st = gst;
+#endif
     }
 
     return time->st;     /* return sidereal hours in the half-open range [0, 24). */
 }
 
+/**
+ * @brief Calculates the Earth Rotation Angle and sidereal time for many times.
+ *
+ * For each `i` in `0 .. count-1`, fills in whichever of the following arrays are not NULL:
+ * `angle[i]` with the Earth Rotation Angle in degrees [0, 360),
+ * `gmst[i]` with Greenwich Mean Sidereal Time in sidereal hours [0, 24), and
+ * `gast[i]` with Greenwich Apparent Sidereal Time in sidereal hours [0, 24),
+ * the same value as `Astronomy_SiderealTime(&time[i])`.
+ *
+ * The loop works on plain numbers: the nutation angles are only calculated
+ * when `gast` is requested and `time[i]` does not already hold them, and the
+ * times themselves are not modified, so no per-thread state is touched.
+ *
+ * @param count     The number of times.
+ * @param time      An array of `count` times.
+ * @param angle     An array of `count` Earth Rotation Angles, or NULL.
+ * @param gmst      An array of `count` mean sidereal times, or NULL.
+ * @param gast      An array of `count` apparent sidereal times, or NULL.
+ *
+ * @return
+ *      `ASTRO_SUCCESS`, or `ASTRO_INVALID_PARAMETER` if `count` is negative
+ *      or `time` is NULL when `count` is positive.
+ */
+astro_status_t Astronomy_SiderealTimeBatch(
+    int count,
+    const astro_time_t *time,
+    double *angle,
+    double *gmst,
+    double *gast)
+{
+    int i;
+    double theta, psi, eps, eqeq;
+
+    if (count < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (count == 0)
+        return ASTRO_SUCCESS;
+
+    if (time == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    for (i=0; i < count; ++i)
+    {
+        theta = era(time[i].ut);
+
+        if (angle != NULL)
+            angle[i] = theta;
+
+        if (gmst != NULL)
+            gmst[i] = sidereal_hours(theta, time[i].tt, 0.0);
+
+        if (gast != NULL)
+        {
+            if (!isnan(time[i].st))
+            {
+                gast[i] = time[i].st;
+                continue;
+            }
+
+            psi = time[i].psi;
+            if (isnan(psi))
+                iau2000b_angles(time[i].tt, &psi, &eps);
+
+            /* Same expression as e_tilt(): eqeq = 15 * ee. */
+            eqeq = 15.0 * (psi * cos(mean_obliq(time[i].tt) * DEG2RAD) / 15.0);
+            gast[i] = sidereal_hours(theta, time[i].tt, eqeq);
+        }
+    }
+
+    return ASTRO_SUCCESS;
+}
+
 static astro_observer_t inverse_terra(const double ovec[3], double st)
 {
     double x, y, z, p, F, W, D, c, s, c2, s2;
@@ -2123,23 +2591,162 @@ static void AddSol(
     SINPI += coeffp*x;
 }
 
-#define ADDN(coeffn,p,q,r,s)    ( Term(ctx, (p),(q),(r),(s),&x,&y), (N += (coeffn)*y) )
+typedef struct
+{
+    double  l;          /* longitude coefficient [arcseconds] */
+    double  s;          /* coefficient of the argument of latitude [arcseconds] */
+    double  g;          /* latitude coefficient [arcseconds] */
+    double  p;          /* parallax coefficient [arcseconds] */
+    int     arg[4];     /* multiples of L, LS, F, D in the term's argument */
+}
+moon_term_t;
+
+static const moon_term_t MoonSolarTerms[] =
+{
+    {     13.9020,     14.0600,    -0.0010,     0.2607, {  0,  0,  0,  4 } },
+    {      0.4030,     -4.0100,     0.3940,     0.0023, {  0,  0,  0,  3 } },
+    {   2369.9120,   2373.3600,     0.6010,    28.2333, {  0,  0,  0,  2 } },
+    {   -125.1540,   -112.7900,    -0.7250,    -0.9781, {  0,  0,  0,  1 } },
+    {      1.9790,      6.9800,    -0.4450,     0.0433, {  1,  0,  0,  4 } },
+    {    191.9530,    192.7200,     0.0290,     3.0861, {  1,  0,  0,  2 } },
+    {     -8.4660,    -13.5100,     0.4550,    -0.1093, {  1,  0,  0,  1 } },
+    {  22639.5000,  22609.0700,     0.0790,   186.5398, {  1,  0,  0,  0 } },
+    {     18.6090,      3.5900,    -0.0940,     0.0118, {  1,  0,  0, -1 } },
+    {  -4586.4650,  -4578.1300,    -0.0770,    34.3117, {  1,  0,  0, -2 } },
+    {      3.2150,      5.4400,     0.1920,    -0.0386, {  1,  0,  0, -3 } },
+    {    -38.4280,    -38.6400,     0.0010,     0.6008, {  1,  0,  0, -4 } },
+    {     -0.3930,     -1.4300,    -0.0920,     0.0086, {  1,  0,  0, -6 } },
+    {     -0.2890,     -1.5900,     0.1230,    -0.0053, {  0,  1,  0,  4 } },
+    {    -24.4200,    -25.1000,     0.0400,    -0.3000, {  0,  1,  0,  2 } },
+    {     18.0230,     17.9300,     0.0070,     0.1494, {  0,  1,  0,  1 } },
+    {   -668.1460,   -126.9800,    -1.3020,    -0.3997, {  0,  1,  0,  0 } },
+    {      0.5600,      0.3200,    -0.0010,    -0.0037, {  0,  1,  0, -1 } },
+    {   -165.1450,   -165.0600,     0.0540,     1.9178, {  0,  1,  0, -2 } },
+    {     -1.8770,     -6.4600,    -0.4160,     0.0339, {  0,  1,  0, -4 } },
+    {      0.2130,      1.0200,    -0.0740,     0.0054, {  2,  0,  0,  4 } },
+    {     14.3870,     14.7800,    -0.0170,     0.2833, {  2,  0,  0,  2 } },
+    {     -0.5860,     -1.2000,     0.0540,    -0.0100, {  2,  0,  0,  1 } },
+    {    769.0160,    767.9600,     0.1070,    10.1657, {  2,  0,  0,  0 } },
+    {      1.7500,      2.0100,    -0.0180,     0.0155, {  2,  0,  0, -1 } },
+    {   -211.6560,   -152.5300,     5.6790,    -0.3039, {  2,  0,  0, -2 } },
+    {      1.2250,      0.9100,    -0.0300,    -0.0088, {  2,  0,  0, -3 } },
+    {    -30.7730,    -34.0700,    -0.3080,     0.3722, {  2,  0,  0, -4 } },
+    {     -0.5700,     -1.4000,    -0.0740,     0.0109, {  2,  0,  0, -6 } },
+    {     -2.9210,    -11.7500,     0.7870,    -0.0484, {  1,  1,  0,  2 } },
+    {      1.2670,      1.5200,    -0.0220,     0.0164, {  1,  1,  0,  1 } },
+    {   -109.6730,   -115.1800,     0.4610,    -0.9490, {  1,  1,  0,  0 } },
+    {   -205.9620,   -182.3600,     2.0560,     1.4437, {  1,  1,  0, -2 } },
+    {      0.2330,      0.3600,     0.0120,    -0.0025, {  1,  1,  0, -3 } },
+    {     -4.3910,     -9.6600,    -0.4710,     0.0673, {  1,  1,  0, -4 } },
+    {      0.2830,      1.5300,    -0.1110,     0.0060, {  1, -1,  0,  4 } },
+    {     14.5770,     31.7000,    -1.5400,     0.2302, {  1, -1,  0,  2 } },
+    {    147.6870,    138.7600,     0.6790,     1.1528, {  1, -1,  0,  0 } },
+    {     -1.0890,      0.5500,     0.0210,     0.0000, {  1, -1,  0, -1 } },
+    {     28.4750,     23.5900,    -0.4430,    -0.2257, {  1, -1,  0, -2 } },
+    {     -0.2760,     -0.3800,    -0.0060,    -0.0036, {  1, -1,  0, -3 } },
+    {      0.6360,      2.2700,     0.1460,    -0.0102, {  1, -1,  0, -4 } },
+    {     -0.1890,     -1.6800,     0.1310,    -0.0028, {  0,  2,  0,  2 } },
+    {     -7.4860,     -0.6600,    -0.0370,    -0.0086, {  0,  2,  0,  0 } },
+    {     -8.0960,    -16.3500,    -0.7400,     0.0918, {  0,  2,  0, -2 } },
+    {     -5.7410,     -0.0400,     0.0000,    -0.0009, {  0,  0,  2,  2 } },
+    {      0.2550,      0.0000,     0.0000,     0.0000, {  0,  0,  2,  1 } },
+    {   -411.6080,     -0.2000,     0.0000,    -0.0124, {  0,  0,  2,  0 } },
+    {      0.5840,      0.8400,     0.0000,     0.0071, {  0,  0,  2, -1 } },
+    {    -55.1730,    -52.1400,     0.0000,    -0.1052, {  0,  0,  2, -2 } },
+    {      0.2540,      0.2500,     0.0000,    -0.0017, {  0,  0,  2, -3 } },
+    {      0.0250,     -1.6700,     0.0000,     0.0031, {  0,  0,  2, -4 } },
+    {      1.0600,      2.9600,    -0.1660,     0.0243, {  3,  0,  0,  2 } },
+    {     36.1240,     50.6400,    -1.3000,     0.6215, {  3,  0,  0,  0 } },
+    {    -13.1930,    -16.4000,     0.2580,    -0.1187, {  3,  0,  0, -2 } },
+    {     -1.1870,     -0.7400,     0.0420,     0.0074, {  3,  0,  0, -4 } },
+    {     -0.2930,     -0.3100,    -0.0020,     0.0046, {  3,  0,  0, -6 } },
+    {     -0.2900,     -1.4500,     0.1160,    -0.0051, {  2,  1,  0,  2 } },
+    {     -7.6490,    -10.5600,     0.2590,    -0.1038, {  2,  1,  0,  0 } },
+    {     -8.6270,     -7.5900,     0.0780,    -0.0192, {  2,  1,  0, -2 } },
+    {     -2.7400,     -2.5400,     0.0220,     0.0324, {  2,  1,  0, -4 } },
+    {      1.1810,      3.3200,    -0.2120,     0.0213, {  2, -1,  0,  2 } },
+    {      9.7030,     11.6700,    -0.1510,     0.1268, {  2, -1,  0,  0 } },
+    {     -0.3520,     -0.3700,     0.0010,    -0.0028, {  2, -1,  0, -1 } },
+    {     -2.4940,     -1.1700,    -0.0030,    -0.0017, {  2, -1,  0, -2 } },
+    {      0.3600,      0.2000,    -0.0120,    -0.0043, {  2, -1,  0, -4 } },
+    {     -1.1670,     -1.2500,     0.0080,    -0.0106, {  1,  2,  0,  0 } },
+    {     -7.4120,     -6.1200,     0.1170,     0.0484, {  1,  2,  0, -2 } },
+    {     -0.3110,     -0.6500,    -0.0320,     0.0044, {  1,  2,  0, -4 } },
+    {      0.7570,      1.8200,    -0.1050,     0.0112, {  1, -2,  0,  2 } },
+    {      2.5800,      2.3200,     0.0270,     0.0196, {  1, -2,  0,  0 } },
+    {      2.5330,      2.4000,    -0.0140,    -0.0212, {  1, -2,  0, -2 } },
+    {     -0.3440,     -0.5700,    -0.0250,     0.0036, {  0,  3,  0, -2 } },
+    {     -0.9920,     -0.0200,     0.0000,     0.0000, {  1,  0,  2,  2 } },
+    {    -45.0990,     -0.0200,     0.0000,    -0.0010, {  1,  0,  2,  0 } },
+    {     -0.1790,     -9.5200,     0.0000,    -0.0833, {  1,  0,  2, -2 } },
+    {     -0.3010,     -0.3300,     0.0000,     0.0014, {  1,  0,  2, -4 } },
+    {     -6.3820,     -3.3700,     0.0000,    -0.0481, {  1,  0, -2,  2 } },
+    {     39.5280,     85.1300,     0.0000,    -0.7136, {  1,  0, -2,  0 } },
+    {      9.3660,      0.7100,     0.0000,    -0.0112, {  1,  0, -2, -2 } },
+    {      0.2020,      0.0200,     0.0000,     0.0000, {  1,  0, -2, -4 } },
+    {      0.4150,      0.1000,     0.0000,     0.0013, {  0,  1,  2,  0 } },
+    {     -2.1520,     -2.2600,     0.0000,    -0.0066, {  0,  1,  2, -2 } },
+    {     -1.4400,     -1.3000,     0.0000,     0.0014, {  0,  1, -2,  2 } },
+    {      0.3840,     -0.0400,     0.0000,     0.0000, {  0,  1, -2, -2 } },
+    {      1.9380,      3.6000,    -0.1450,     0.0401, {  4,  0,  0,  0 } },
+    {     -0.9520,     -1.5800,     0.0520,    -0.0130, {  4,  0,  0, -2 } },
+    {     -0.5510,     -0.9400,     0.0320,    -0.0097, {  3,  1,  0,  0 } },
+    {     -0.4820,     -0.5700,     0.0050,    -0.0045, {  3,  1,  0, -2 } },
+    {      0.6810,      0.9600,    -0.0260,     0.0115, {  3, -1,  0,  0 } },
+    {     -0.2970,     -0.2700,     0.0020,    -0.0009, {  2,  2,  0, -2 } },
+    {      0.2540,      0.2100,    -0.0030,     0.0000, {  2, -2,  0, -2 } },
+    {     -0.2500,     -0.2200,     0.0040,     0.0014, {  1,  3,  0, -2 } },
+    {     -3.9960,      0.0000,     0.0000,     0.0004, {  2,  0,  2,  0 } },
+    {      0.5570,     -0.7500,     0.0000,    -0.0090, {  2,  0,  2, -2 } },
+    {     -0.4590,     -0.3800,     0.0000,    -0.0053, {  2,  0, -2,  2 } },
+    {     -1.2980,      0.7400,     0.0000,     0.0004, {  2,  0, -2,  0 } },
+    {      0.5380,      1.1400,     0.0000,    -0.0141, {  2,  0, -2, -2 } },
+    {      0.2630,      0.0200,     0.0000,     0.0000, {  1,  1,  2,  0 } },
+    {      0.4260,      0.0700,     0.0000,    -0.0006, {  1,  1, -2, -2 } },
+    {     -0.3040,      0.0300,     0.0000,     0.0003, {  1, -1,  2,  0 } },
+    {     -0.3720,     -0.1900,     0.0000,    -0.0027, {  1, -1, -2,  2 } },
+    {      0.4180,      0.0000,     0.0000,     0.0000, {  0,  0,  4,  0 } },
+    {     -0.3300,     -0.0400,     0.0000,     0.0000, {  3,  0,  2,  0 } }
+};
+
+#define MOON_NUM_SOLAR_TERMS   ((int)ASTRO_ARRAYSIZE(MoonSolarTerms))
+
+typedef struct
+{
+    double  n;          /* latitude coefficient [arcseconds] */
+    int     arg[4];     /* multiples of L, LS, F, D in the term's argument */
+}
+moon_node_term_t;
+
+static const moon_node_term_t MoonNodeTerms[] =
+{
+    { -526.069, {  0,  0,  1, -2 } },
+    {   -3.352, {  0,  0,  1, -4 } },
+    {  +44.297, { +1,  0,  1, -2 } },
+    {   -6.000, { +1,  0,  1, -4 } },
+    {  +20.599, { -1,  0,  1,  0 } },
+    {  -30.598, { -1,  0,  1, -2 } },
+    {  -24.649, { -2,  0,  1,  0 } },
+    {   -2.000, { -2,  0,  1, -2 } },
+    {  -22.571, {  0, +1,  1, -2 } },
+    {  +10.985, {  0, -1,  1, -2 } }
+};
+
+#define MOON_NUM_NODE_TERMS    ((int)ASTRO_ARRAYSIZE(MoonNodeTerms))
 
 static void SolarN(MoonContext *ctx)
 {
+    int i;
     double x, y;
+    const moon_node_term_t *term;
 
     N = 0.0;
-    ADDN(-526.069, 0, 0,1,-2);
-    ADDN(  -3.352, 0, 0,1,-4);
-    ADDN( +44.297,+1, 0,1,-2);
-    ADDN(  -6.000,+1, 0,1,-4);
-    ADDN( +20.599,-1, 0,1, 0);
-    ADDN( -30.598,-1, 0,1,-2);
-    ADDN( -24.649,-2, 0,1, 0);
-    ADDN(  -2.000,-2, 0,1,-2);
-    ADDN( -22.571, 0,+1,1,-2);
-    ADDN( +10.985, 0,-1,1,-2);
+    for (i=0; i < MOON_NUM_NODE_TERMS; ++i)
+    {
+        term = &MoonNodeTerms[i];
+        Term(ctx, term->arg[0], term->arg[1], term->arg[2], term->arg[3], &x, &y);
+        N += term->n * y;
+    }
 }
 
 static void Planetary(MoonContext *ctx)
@@ -2155,123 +2762,14 @@ static void Planetary(MoonContext *ctx)
 
 int _CalcMoonCount;     /* Undocumented global for performance tuning. */
 
-static void CalcMoon(
-    double centuries_since_j2000,
-    double *geo_eclip_lon,      /* (LAMBDA) equinox of date */
-    double *geo_eclip_lat,      /* (BETA)   equinox of date */
-    double *distance_au)        /* (R) */
+/* Finishes a lunar calculation once the solar perturbation sums in `ctx` are complete. */
+static void MoonResult(
+    MoonContext *ctx,
+    double *geo_eclip_lon,
+    double *geo_eclip_lat,
+    double *distance_au)
 {
     double lat_seconds;
-    MoonContext context;
-    MoonContext *ctx = &context;    /* goofy, but makes macros work inside this function */
-
-    context.t = centuries_since_j2000;
-    Init(ctx);
-
-    AddSol(ctx,    13.9020,    14.0600,    -0.0010,     0.2607, 0, 0, 0, 4);
-    AddSol(ctx,     0.4030,    -4.0100,     0.3940,     0.0023, 0, 0, 0, 3);
-    AddSol(ctx,  2369.9120,  2373.3600,     0.6010,    28.2333, 0, 0, 0, 2);
-    AddSol(ctx,  -125.1540,  -112.7900,    -0.7250,    -0.9781, 0, 0, 0, 1);
-    AddSol(ctx,     1.9790,     6.9800,    -0.4450,     0.0433, 1, 0, 0, 4);
-    AddSol(ctx,   191.9530,   192.7200,     0.0290,     3.0861, 1, 0, 0, 2);
-    AddSol(ctx,    -8.4660,   -13.5100,     0.4550,    -0.1093, 1, 0, 0, 1);
-    AddSol(ctx, 22639.5000, 22609.0700,     0.0790,   186.5398, 1, 0, 0, 0);
-    AddSol(ctx,    18.6090,     3.5900,    -0.0940,     0.0118, 1, 0, 0,-1);
-    AddSol(ctx, -4586.4650, -4578.1300,    -0.0770,    34.3117, 1, 0, 0,-2);
-    AddSol(ctx,     3.2150,     5.4400,     0.1920,    -0.0386, 1, 0, 0,-3);
-    AddSol(ctx,   -38.4280,   -38.6400,     0.0010,     0.6008, 1, 0, 0,-4);
-    AddSol(ctx,    -0.3930,    -1.4300,    -0.0920,     0.0086, 1, 0, 0,-6);
-    AddSol(ctx,    -0.2890,    -1.5900,     0.1230,    -0.0053, 0, 1, 0, 4);
-    AddSol(ctx,   -24.4200,   -25.1000,     0.0400,    -0.3000, 0, 1, 0, 2);
-    AddSol(ctx,    18.0230,    17.9300,     0.0070,     0.1494, 0, 1, 0, 1);
-    AddSol(ctx,  -668.1460,  -126.9800,    -1.3020,    -0.3997, 0, 1, 0, 0);
-    AddSol(ctx,     0.5600,     0.3200,    -0.0010,    -0.0037, 0, 1, 0,-1);
-    AddSol(ctx,  -165.1450,  -165.0600,     0.0540,     1.9178, 0, 1, 0,-2);
-    AddSol(ctx,    -1.8770,    -6.4600,    -0.4160,     0.0339, 0, 1, 0,-4);
-    AddSol(ctx,     0.2130,     1.0200,    -0.0740,     0.0054, 2, 0, 0, 4);
-    AddSol(ctx,    14.3870,    14.7800,    -0.0170,     0.2833, 2, 0, 0, 2);
-    AddSol(ctx,    -0.5860,    -1.2000,     0.0540,    -0.0100, 2, 0, 0, 1);
-    AddSol(ctx,   769.0160,   767.9600,     0.1070,    10.1657, 2, 0, 0, 0);
-    AddSol(ctx,     1.7500,     2.0100,    -0.0180,     0.0155, 2, 0, 0,-1);
-    AddSol(ctx,  -211.6560,  -152.5300,     5.6790,    -0.3039, 2, 0, 0,-2);
-    AddSol(ctx,     1.2250,     0.9100,    -0.0300,    -0.0088, 2, 0, 0,-3);
-    AddSol(ctx,   -30.7730,   -34.0700,    -0.3080,     0.3722, 2, 0, 0,-4);
-    AddSol(ctx,    -0.5700,    -1.4000,    -0.0740,     0.0109, 2, 0, 0,-6);
-    AddSol(ctx,    -2.9210,   -11.7500,     0.7870,    -0.0484, 1, 1, 0, 2);
-    AddSol(ctx,     1.2670,     1.5200,    -0.0220,     0.0164, 1, 1, 0, 1);
-    AddSol(ctx,  -109.6730,  -115.1800,     0.4610,    -0.9490, 1, 1, 0, 0);
-    AddSol(ctx,  -205.9620,  -182.3600,     2.0560,     1.4437, 1, 1, 0,-2);
-    AddSol(ctx,     0.2330,     0.3600,     0.0120,    -0.0025, 1, 1, 0,-3);
-    AddSol(ctx,    -4.3910,    -9.6600,    -0.4710,     0.0673, 1, 1, 0,-4);
-    AddSol(ctx,     0.2830,     1.5300,    -0.1110,     0.0060, 1,-1, 0, 4);
-    AddSol(ctx,    14.5770,    31.7000,    -1.5400,     0.2302, 1,-1, 0, 2);
-    AddSol(ctx,   147.6870,   138.7600,     0.6790,     1.1528, 1,-1, 0, 0);
-    AddSol(ctx,    -1.0890,     0.5500,     0.0210,     0.0000, 1,-1, 0,-1);
-    AddSol(ctx,    28.4750,    23.5900,    -0.4430,    -0.2257, 1,-1, 0,-2);
-    AddSol(ctx,    -0.2760,    -0.3800,    -0.0060,    -0.0036, 1,-1, 0,-3);
-    AddSol(ctx,     0.6360,     2.2700,     0.1460,    -0.0102, 1,-1, 0,-4);
-    AddSol(ctx,    -0.1890,    -1.6800,     0.1310,    -0.0028, 0, 2, 0, 2);
-    AddSol(ctx,    -7.4860,    -0.6600,    -0.0370,    -0.0086, 0, 2, 0, 0);
-    AddSol(ctx,    -8.0960,   -16.3500,    -0.7400,     0.0918, 0, 2, 0,-2);
-    AddSol(ctx,    -5.7410,    -0.0400,     0.0000,    -0.0009, 0, 0, 2, 2);
-    AddSol(ctx,     0.2550,     0.0000,     0.0000,     0.0000, 0, 0, 2, 1);
-    AddSol(ctx,  -411.6080,    -0.2000,     0.0000,    -0.0124, 0, 0, 2, 0);
-    AddSol(ctx,     0.5840,     0.8400,     0.0000,     0.0071, 0, 0, 2,-1);
-    AddSol(ctx,   -55.1730,   -52.1400,     0.0000,    -0.1052, 0, 0, 2,-2);
-    AddSol(ctx,     0.2540,     0.2500,     0.0000,    -0.0017, 0, 0, 2,-3);
-    AddSol(ctx,     0.0250,    -1.6700,     0.0000,     0.0031, 0, 0, 2,-4);
-    AddSol(ctx,     1.0600,     2.9600,    -0.1660,     0.0243, 3, 0, 0, 2);
-    AddSol(ctx,    36.1240,    50.6400,    -1.3000,     0.6215, 3, 0, 0, 0);
-    AddSol(ctx,   -13.1930,   -16.4000,     0.2580,    -0.1187, 3, 0, 0,-2);
-    AddSol(ctx,    -1.1870,    -0.7400,     0.0420,     0.0074, 3, 0, 0,-4);
-    AddSol(ctx,    -0.2930,    -0.3100,    -0.0020,     0.0046, 3, 0, 0,-6);
-    AddSol(ctx,    -0.2900,    -1.4500,     0.1160,    -0.0051, 2, 1, 0, 2);
-    AddSol(ctx,    -7.6490,   -10.5600,     0.2590,    -0.1038, 2, 1, 0, 0);
-    AddSol(ctx,    -8.6270,    -7.5900,     0.0780,    -0.0192, 2, 1, 0,-2);
-    AddSol(ctx,    -2.7400,    -2.5400,     0.0220,     0.0324, 2, 1, 0,-4);
-    AddSol(ctx,     1.1810,     3.3200,    -0.2120,     0.0213, 2,-1, 0, 2);
-    AddSol(ctx,     9.7030,    11.6700,    -0.1510,     0.1268, 2,-1, 0, 0);
-    AddSol(ctx,    -0.3520,    -0.3700,     0.0010,    -0.0028, 2,-1, 0,-1);
-    AddSol(ctx,    -2.4940,    -1.1700,    -0.0030,    -0.0017, 2,-1, 0,-2);
-    AddSol(ctx,     0.3600,     0.2000,    -0.0120,    -0.0043, 2,-1, 0,-4);
-    AddSol(ctx,    -1.1670,    -1.2500,     0.0080,    -0.0106, 1, 2, 0, 0);
-    AddSol(ctx,    -7.4120,    -6.1200,     0.1170,     0.0484, 1, 2, 0,-2);
-    AddSol(ctx,    -0.3110,    -0.6500,    -0.0320,     0.0044, 1, 2, 0,-4);
-    AddSol(ctx,     0.7570,     1.8200,    -0.1050,     0.0112, 1,-2, 0, 2);
-    AddSol(ctx,     2.5800,     2.3200,     0.0270,     0.0196, 1,-2, 0, 0);
-    AddSol(ctx,     2.5330,     2.4000,    -0.0140,    -0.0212, 1,-2, 0,-2);
-    AddSol(ctx,    -0.3440,    -0.5700,    -0.0250,     0.0036, 0, 3, 0,-2);
-    AddSol(ctx,    -0.9920,    -0.0200,     0.0000,     0.0000, 1, 0, 2, 2);
-    AddSol(ctx,   -45.0990,    -0.0200,     0.0000,    -0.0010, 1, 0, 2, 0);
-    AddSol(ctx,    -0.1790,    -9.5200,     0.0000,    -0.0833, 1, 0, 2,-2);
-    AddSol(ctx,    -0.3010,    -0.3300,     0.0000,     0.0014, 1, 0, 2,-4);
-    AddSol(ctx,    -6.3820,    -3.3700,     0.0000,    -0.0481, 1, 0,-2, 2);
-    AddSol(ctx,    39.5280,    85.1300,     0.0000,    -0.7136, 1, 0,-2, 0);
-    AddSol(ctx,     9.3660,     0.7100,     0.0000,    -0.0112, 1, 0,-2,-2);
-    AddSol(ctx,     0.2020,     0.0200,     0.0000,     0.0000, 1, 0,-2,-4);
-    AddSol(ctx,     0.4150,     0.1000,     0.0000,     0.0013, 0, 1, 2, 0);
-    AddSol(ctx,    -2.1520,    -2.2600,     0.0000,    -0.0066, 0, 1, 2,-2);
-    AddSol(ctx,    -1.4400,    -1.3000,     0.0000,     0.0014, 0, 1,-2, 2);
-    AddSol(ctx,     0.3840,    -0.0400,     0.0000,     0.0000, 0, 1,-2,-2);
-    AddSol(ctx,     1.9380,     3.6000,    -0.1450,     0.0401, 4, 0, 0, 0);
-    AddSol(ctx,    -0.9520,    -1.5800,     0.0520,    -0.0130, 4, 0, 0,-2);
-    AddSol(ctx,    -0.5510,    -0.9400,     0.0320,    -0.0097, 3, 1, 0, 0);
-    AddSol(ctx,    -0.4820,    -0.5700,     0.0050,    -0.0045, 3, 1, 0,-2);
-    AddSol(ctx,     0.6810,     0.9600,    -0.0260,     0.0115, 3,-1, 0, 0);
-    AddSol(ctx,    -0.2970,    -0.2700,     0.0020,    -0.0009, 2, 2, 0,-2);
-    AddSol(ctx,     0.2540,     0.2100,    -0.0030,     0.0000, 2,-2, 0,-2);
-    AddSol(ctx,    -0.2500,    -0.2200,     0.0040,     0.0014, 1, 3, 0,-2);
-    AddSol(ctx,    -3.9960,     0.0000,     0.0000,     0.0004, 2, 0, 2, 0);
-    AddSol(ctx,     0.5570,    -0.7500,     0.0000,    -0.0090, 2, 0, 2,-2);
-    AddSol(ctx,    -0.4590,    -0.3800,     0.0000,    -0.0053, 2, 0,-2, 2);
-    AddSol(ctx,    -1.2980,     0.7400,     0.0000,     0.0004, 2, 0,-2, 0);
-    AddSol(ctx,     0.5380,     1.1400,     0.0000,    -0.0141, 2, 0,-2,-2);
-    AddSol(ctx,     0.2630,     0.0200,     0.0000,     0.0000, 1, 1, 2, 0);
-    AddSol(ctx,     0.4260,     0.0700,     0.0000,    -0.0006, 1, 1,-2,-2);
-    AddSol(ctx,    -0.3040,     0.0300,     0.0000,     0.0003, 1,-1, 2, 0);
-    AddSol(ctx,    -0.3720,    -0.1900,     0.0000,    -0.0027, 1,-1,-2, 2);
-    AddSol(ctx,     0.4180,     0.0000,     0.0000,     0.0000, 0, 0, 4, 0);
-    AddSol(ctx,    -0.3300,    -0.0400,     0.0000,     0.0000, 3, 0, 2, 0);
 
     SolarN(ctx);
     Planetary(ctx);
@@ -2285,28 +2783,234 @@ static void CalcMoon(
     ++_CalcMoonCount;
 }
 
-#undef T
-#undef DGAM
-#undef DLAM
-#undef N
-#undef GAM1C
-#undef SINPI
-#undef L0
-#undef L
-#undef LS
-#undef F
-#undef D
-#undef S
-#undef DL0
-#undef DL
-#undef DLS
-#undef DF
-#undef DD
-#undef DS
-#undef CO
-#undef SI
-
-/** @endcond */
+#if defined(ASTRO_THREAD_LOCAL)
+/*
+    Searches for lunar events often evaluate the Moon at the same time more than once,
+    for example when one step of a search needs both the Moon's longitude and distance.
+    Each thread remembers its last few results so those repeats cost nothing.
+*/
+#define MOON_MEMO_SIZE  4
+
+typedef struct
+{
+    double t;
+    double lon;
+    double lat;
+    double dist;
+}
+moon_memo_entry_t;
+
+typedef struct
+{
+    int count;
+    int next;
+    moon_memo_entry_t entry[MOON_MEMO_SIZE];
+}
+moon_memo_t;
+
+static ASTRO_THREAD_LOCAL moon_memo_t MoonMemo;
+#endif
+
+static void CalcMoon(
+    double centuries_since_j2000,
+    double *geo_eclip_lon,      /* (LAMBDA) equinox of date */
+    double *geo_eclip_lat,      /* (BETA)   equinox of date */
+    double *distance_au)        /* (R) */
+{
+    int i;
+    const moon_term_t *term;
+    MoonContext context;
+    MoonContext *ctx = &context;    /* goofy, but makes macros work inside this function */
+
+#if defined(ASTRO_THREAD_LOCAL)
+    moon_memo_t *memo = &MoonMemo;
+    moon_memo_entry_t *entry;
+    for (i=0; i < memo->count; ++i)
+    {
+        entry = &memo->entry[i];
+        if (entry->t == centuries_since_j2000)
+        {
+            *geo_eclip_lon = entry->lon;
+            *geo_eclip_lat = entry->lat;
+            *distance_au = entry->dist;
+            return;
+        }
+    }
+#endif
+
+    context.t = centuries_since_j2000;
+    Init(ctx);
+
+    for (i=0; i < MOON_NUM_SOLAR_TERMS; ++i)
+    {
+        term = &MoonSolarTerms[i];
+        AddSol(ctx, term->l, term->s, term->g, term->p, term->arg[0], term->arg[1], term->arg[2], term->arg[3]);
+    }
+
+    MoonResult(ctx, geo_eclip_lon, geo_eclip_lat, distance_au);
+
+#if defined(ASTRO_THREAD_LOCAL)
+    entry = &memo->entry[memo->next];
+    entry->t = centuries_since_j2000;
+    entry->lon = *geo_eclip_lon;
+    entry->lat = *geo_eclip_lat;
+    entry->dist = *distance_au;
+    memo->next = (memo->next + 1) % MOON_MEMO_SIZE;
+    if (memo->count < MOON_MEMO_SIZE)
+        ++memo->count;
+#endif
+}
+
+
+/** @cond DOXYGEN_SKIP */
+#define MOON_BATCH  8       /* number of times evaluated together by CalcMoonBatch */
+/** @endcond */
+
+/*
+    Calculates the Moon for many times, like calling CalcMoon for each.
+    The trigonometric set-up of each time is done as in CalcMoon, but the
+    solar perturbation series is then summed for MOON_BATCH times at once:
+    each term's coefficients are read once, and the multiples of the
+    fundamental arguments are held in structure-of-arrays form so the
+    inner loops over times can be vectorized. The results are identical
+    to CalcMoon's.
+*/
+static void CalcMoonBatch(
+    int count,
+    const double *centuries_since_j2000,
+    double *geo_eclip_lon,
+    double *geo_eclip_lat,
+    double *distance_au)
+{
+    MoonContext batch[MOON_BATCH];
+    double co[4][13][MOON_BATCH];       /* [argument][multiple + 6][time] */
+    double si[4][13][MOON_BATCH];
+    double x[MOON_BATCH], y[MOON_BATCH];
+    double dlam[MOON_BATCH], ds[MOON_BATCH], gam1c[MOON_BATCH], sinpi[MOON_BATCH];
+    double cx, sx, tmp;
+    const moon_term_t *term;
+    int first, n, i, j, k, m;
+
+    for (first=0; first < count; first += MOON_BATCH)
+    {
+        n = (count - first < MOON_BATCH) ? (count - first) : MOON_BATCH;
+        for (j=0; j < MOON_BATCH; ++j)
+        {
+            /* Pad a partial batch by repeating its last time. */
+            batch[j].t = centuries_since_j2000[first + ((j < n) ? j : n-1)];
+            Init(&batch[j]);
+            for (k=0; k < 4; ++k)
+            {
+                for (m=0; m < 13; ++m)
+                {
+                    co[k][m][j] = batch[j].co[m][k];
+                    si[k][m][j] = batch[j].si[m][k];
+                }
+            }
+            dlam[j]  = batch[j].dlam;
+            ds[j]    = batch[j].ds;
+            gam1c[j] = batch[j].gam1c;
+            sinpi[j] = batch[j].sinpi;
+        }
+
+        for (i=0; i < MOON_NUM_SOLAR_TERMS; ++i)
+        {
+            term = &MoonSolarTerms[i];
+            for (j=0; j < MOON_BATCH; ++j)
+            {
+                x[j] = 1.0;
+                y[j] = 0.0;
+            }
+            for (k=0; k < 4; ++k)
+            {
+                if (term->arg[k] != 0)
+                {
+                    m = term->arg[k] + 6;
+                    for (j=0; j < MOON_BATCH; ++j)
+                    {
+                        cx = co[k][m][j];
+                        sx = si[k][m][j];
+                        tmp  = x[j]*cx - y[j]*sx;
+                        y[j] = y[j]*cx + x[j]*sx;
+                        x[j] = tmp;
+                    }
+                }
+            }
+            for (j=0; j < MOON_BATCH; ++j)
+            {
+                dlam[j]  += term->l * y[j];
+                ds[j]    += term->s * y[j];
+                gam1c[j] += term->g * x[j];
+                sinpi[j] += term->p * x[j];
+            }
+        }
+
+        for (j=0; j < n; ++j)
+        {
+            batch[j].dlam  = dlam[j];
+            batch[j].ds    = ds[j];
+            batch[j].gam1c = gam1c[j];
+            batch[j].sinpi = sinpi[j];
+            MoonResult(&batch[j], &geo_eclip_lon[first+j], &geo_eclip_lat[first+j], &distance_au[first+j]);
+        }
+    }
+}
+
+#undef T
+#undef DGAM
+#undef DLAM
+#undef N
+#undef GAM1C
+#undef SINPI
+#undef L0
+#undef L
+#undef LS
+#undef F
+#undef D
+#undef S
+#undef DL0
+#undef DL
+#undef DLS
+#undef DF
+#undef DD
+#undef DS
+#undef CO
+#undef SI
+
+/** @endcond */
+
+/* Converts CalcMoon's ecliptic spherical coordinates of date to a J2000 equatorial vector. */
+static astro_vector_t MoonVector(
+    astro_time_t time,
+    double geo_eclip_lon,
+    double geo_eclip_lat,
+    double distance_au)
+{
+    double dist_cos_lat;
+    astro_vector_t vector;
+    double gepos[3];
+    double mpos1[3];
+    double mpos2[3];
+
+    /* Convert geocentric ecliptic spherical coordinates to Cartesian coordinates. */
+    dist_cos_lat = distance_au * cos(geo_eclip_lat);
+    gepos[0] = dist_cos_lat * cos(geo_eclip_lon);
+    gepos[1] = dist_cos_lat * sin(geo_eclip_lon);
+    gepos[2] = distance_au * sin(geo_eclip_lat);
+
+    /* Convert ecliptic coordinates to equatorial coordinates, both in mean equinox of date. */
+    ecl2equ_vec(time, gepos, mpos1);
+
+    /* Convert equatorial coordinates from mean equinox of date to J2000 mean equinox. */
+    precession(mpos1, time, INTO_2000, mpos2);
+
+    vector.status = ASTRO_SUCCESS;
+    vector.x = mpos2[0];
+    vector.y = mpos2[1];
+    vector.z = mpos2[2];
+    vector.t = time;
+    return vector;
+}
 
 /**
  * @brief Calculates equatorial geocentric position of the Moon at a given time.
@@ -2331,32 +3035,51 @@ static void CalcMoon(
 astro_vector_t Astronomy_GeoMoon(astro_time_t time)
 {
     double geo_eclip_lon, geo_eclip_lat, distance_au;
-    double dist_cos_lat;
-    astro_vector_t vector;
-    double gepos[3];
-    double mpos1[3];
-    double mpos2[3];
 
     CalcMoon(time.tt / 36525.0, &geo_eclip_lon, &geo_eclip_lat, &distance_au);
+    return MoonVector(time, geo_eclip_lon, geo_eclip_lat, distance_au);
+}
 
-    /* Convert geocentric ecliptic spherical coordinates to Cartesian coordinates. */
-    dist_cos_lat = distance_au * cos(geo_eclip_lat);
-    gepos[0] = dist_cos_lat * cos(geo_eclip_lon);
-    gepos[1] = dist_cos_lat * sin(geo_eclip_lon);
-    gepos[2] = distance_au * sin(geo_eclip_lat);
 
-    /* Convert ecliptic coordinates to equatorial coordinates, both in mean equinox of date. */
-    ecl2equ_vec(time, gepos, mpos1);
+/** @cond DOXYGEN_SKIP */
+#define MOON_VECTOR_BATCH  64
+/** @endcond */
 
-    /* Convert equatorial coordinates from mean equinox of date to J2000 mean equinox. */
-    precession(mpos1, time, INTO_2000, mpos2);
+/**
+ * @brief Calculates the equatorial geocentric position of the Moon for many times.
+ *
+ * Fills `vector[i]` with the same result as `Astronomy_GeoMoon(time[i])`
+ * for each `i` in `0 .. count-1`. The lunar series is summed for several
+ * times at once, which is considerably faster than calling
+ * #Astronomy_GeoMoon in a loop.
+ *
+ * @param count   The number of times in `time` and vectors in `vector`.
+ * @param time    An array of `count` times at which to calculate the Moon's position.
+ * @param vector  An array of `count` vectors that receives the results.
+ * @return `ASTRO_SUCCESS`, or `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing.
+ */
+astro_status_t Astronomy_GeoMoonBatch(int count, const astro_time_t *time, astro_vector_t *vector)
+{
+    double centuries[MOON_VECTOR_BATCH];
+    double lon[MOON_VECTOR_BATCH];
+    double lat[MOON_VECTOR_BATCH];
+    double dist[MOON_VECTOR_BATCH];
+    int first, n, i;
 
-    vector.status = ASTRO_SUCCESS;
-    vector.x = mpos2[0];
-    vector.y = mpos2[1];
-    vector.z = mpos2[2];
-    vector.t = time;
-    return vector;
+    if (count < 0 || (count > 0 && (time == NULL || vector == NULL)))
+        return ASTRO_INVALID_PARAMETER;
+
+    for (first=0; first < count; first += MOON_VECTOR_BATCH)
+    {
+        n = (count - first < MOON_VECTOR_BATCH) ? (count - first) : MOON_VECTOR_BATCH;
+        for (i=0; i < n; ++i)
+            centuries[i] = time[first+i].tt / 36525.0;
+        CalcMoonBatch(n, centuries, lon, lat, dist);
+        for (i=0; i < n; ++i)
+            vector[first+i] = MoonVector(time[first+i], lon[i], lat[i], dist[i]);
+    }
+
+    return ASTRO_SUCCESS;
 }
 
 
@@ -2500,46 +3223,27 @@ astro_state_vector_t Astronomy_GeoEmbState(astro_time_t time)
 }
 
 
-/**
- * @brief Calculates the Moon's libration angles at a given moment in time.
- *
- * Libration is an observed back-and-forth wobble of the portion of the
- * Moon visible from the Earth. It is caused by the imperfect tidal locking
- * of the Moon's fixed rotation rate, compared to its variable angular speed
- * of orbit around the Earth.
- *
- * This function calculates a pair of perpendicular libration angles,
- * one representing rotation of the Moon in ecliptic longitude `elon`, the other
- * in ecliptic latitude `elat`, both relative to the Moon's mean Earth-facing position.
- *
- * This function also returns the geocentric position of the Moon
- * expressed in ecliptic longitude `mlon`, ecliptic latitude `mlat`, the
- * distance `dist_km` between the centers of the Earth and Moon expressed in kilometers,
- * and the apparent angular diameter of the Moon `diam_deg`.
- *
- * @param time  The date and time for which to calculate libration angles.
- * @return The Moon's ecliptic position and libration angles as seen from the Earth.
- */
-astro_libration_t Astronomy_Libration(astro_time_t time)
+/*
+    Calculates the libration angles at `t` Julian centuries after J2000 (TT),
+    given the Moon's geocentric ecliptic longitude `mlon` and latitude `mlat`
+    in radians and its distance in AU, as found by CalcMoon.
+*/
+static astro_libration_t LibrationFromMoon(double t, double mlon, double mlat, double distance_au)
 {
     astro_libration_t lib;
-    double t, t2, t3, t4;
+    double t2, t3, t4;
     double f, omega, w, a, ldash, ldash2, bdash, bdash2;
     double k1, k2, m, mdash, d, e, rho, sigma, tau;
     const double sin_I = sin(MOON_AXIS_INCLINATION_RADIANS);
     const double cos_I = cos(MOON_AXIS_INCLINATION_RADIANS);
 
-    t = time.tt / 36525.0;
     t2 = t * t;
     t3 = t2 * t;
     t4 = t2 * t2;
 
-    double mlon;    /* Moon's ecliptic longitude in radians. */
-    double mlat;    /* Moon's ecliptic latitude in radians. */
-    CalcMoon(t, &mlon, &mlat, &lib.dist_km);
     lib.mlon = RAD2DEG * mlon;
     lib.mlat = RAD2DEG * mlat;
-    lib.dist_km *= KM_PER_AU;
+    lib.dist_km = distance_au * KM_PER_AU;
     lib.diam_deg = (2.0 * RAD2DEG) * atan(MOON_MEAN_RADIUS_KM / sqrt(lib.dist_km*lib.dist_km - MOON_MEAN_RADIUS_KM*MOON_MEAN_RADIUS_KM));
 
     /* Moon's argument of latitude in radians. */
@@ -2632,6 +3336,85 @@ astro_libration_t Astronomy_Libration(astro_time_t time)
 }
 
 
+/**
+ * @brief Calculates the Moon's libration angles at a given moment in time.
+ *
+ * Libration is an observed back-and-forth wobble of the portion of the
+ * Moon visible from the Earth. It is caused by the imperfect tidal locking
+ * of the Moon's fixed rotation rate, compared to its variable angular speed
+ * of orbit around the Earth.
+ *
+ * This function calculates a pair of perpendicular libration angles,
+ * one representing rotation of the Moon in ecliptic longitude `elon`, the other
+ * in ecliptic latitude `elat`, both relative to the Moon's mean Earth-facing position.
+ *
+ * This function also returns the geocentric position of the Moon
+ * expressed in ecliptic longitude `mlon`, ecliptic latitude `mlat`, the
+ * distance `dist_km` between the centers of the Earth and Moon expressed in kilometers,
+ * and the apparent angular diameter of the Moon `diam_deg`.
+ *
+ * @param time  The date and time for which to calculate libration angles.
+ * @return The Moon's ecliptic position and libration angles as seen from the Earth.
+ */
+astro_libration_t Astronomy_Libration(astro_time_t time)
+{
+    double t = time.tt / 36525.0;
+    double mlon;    /* Moon's ecliptic longitude in radians. */
+    double mlat;    /* Moon's ecliptic latitude in radians. */
+    double dist;    /* Moon's distance in AU. */
+
+    CalcMoon(t, &mlon, &mlat, &dist);
+    return LibrationFromMoon(t, mlon, mlat, dist);
+}
+
+
+/**
+ * @brief Calculates the Moon's libration angles and geocentric position for many times.
+ *
+ * Fills `lib[i]` with the same result as `Astronomy_Libration(time[i])`
+ * for each `i` in `0 .. count-1`. The lunar series is summed for several
+ * times at once, as #Astronomy_GeoMoonBatch does, which is considerably
+ * faster than calling #Astronomy_Libration in a loop.
+ *
+ * The same evaluation of the lunar series also gives the Moon's equatorial
+ * geocentric position, so a caller that needs both can ask for `vector`
+ * instead of calling #Astronomy_GeoMoonBatch as well.
+ *
+ * @param count   The number of times in `time` and results in `lib`.
+ * @param time    An array of `count` times at which to calculate the libration.
+ * @param lib     An array of `count` libration results.
+ * @param vector  If not NULL, an array of `count` vectors that receives the same results as #Astronomy_GeoMoon.
+ * @return `ASTRO_SUCCESS`, or `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing.
+ */
+astro_status_t Astronomy_LibrationBatch(int count, const astro_time_t *time, astro_libration_t *lib, astro_vector_t *vector)
+{
+    double centuries[MOON_VECTOR_BATCH];
+    double lon[MOON_VECTOR_BATCH];
+    double lat[MOON_VECTOR_BATCH];
+    double dist[MOON_VECTOR_BATCH];
+    int first, n, i;
+
+    if (count < 0 || (count > 0 && (time == NULL || lib == NULL)))
+        return ASTRO_INVALID_PARAMETER;
+
+    for (first=0; first < count; first += MOON_VECTOR_BATCH)
+    {
+        n = (count - first < MOON_VECTOR_BATCH) ? (count - first) : MOON_VECTOR_BATCH;
+        for (i=0; i < n; ++i)
+            centuries[i] = time[first+i].tt / 36525.0;
+        CalcMoonBatch(n, centuries, lon, lat, dist);
+        for (i=0; i < n; ++i)
+        {
+            lib[first+i] = LibrationFromMoon(centuries[i], lon[i], lat[i], dist[i]);
+            if (vector != NULL)
+                vector[first+i] = MoonVector(time[first+i], lon[i], lat[i], dist[i]);
+        }
+    }
+
+    return ASTRO_SUCCESS;
+}
+
+
 /*------------------ VSOP ------------------*/
 
 /** @cond DOXYGEN_SKIP */
@@ -3590,13 +4373,11 @@ static void VsopSphereToRect(double lon, double lat, double radius, double pos[3
 static const double DAYS_PER_MILLENNIUM = 365250.0;
 
 
-static astro_vector_t CalcVsop(const vsop_model_t *model, astro_time_t time)
+static terse_vector_t VsopPosition(const vsop_model_t *model, double tt)
 {
-    double t = time.tt / DAYS_PER_MILLENNIUM;
+    double t = tt / DAYS_PER_MILLENNIUM;
     double sphere[3];       /* lon, lat, rad */
     double eclip[3];
-    astro_vector_t vector;
-    terse_vector_t pos;
 
     /* Calculate the VSOP "B" trigonometric series to obtain ecliptic spherical coordinates. */
     VsopCoords(model, t, sphere);
@@ -3605,448 +4386,1962 @@ static astro_vector_t CalcVsop(const vsop_model_t *model, astro_time_t time)
     VsopSphereToRect(sphere[LON_INDEX], sphere[LAT_INDEX], sphere[RAD_INDEX], eclip);
 
     /* Convert ecliptic Cartesian coordinates to equatorial Cartesian coordinates. */
-    pos = VsopRotate(eclip);
+    return VsopRotate(eclip);
+}
 
-    /* Package the position as astro_vector_t. */
-    vector.status = ASTRO_SUCCESS;
-    vector.t = time;
-    vector.x = pos.x;
-    vector.y = pos.y;
-    vector.z = pos.z;
+/*------------------ compiled ephemeris ------------------*/
 
-    return vector;
+/** @cond DOXYGEN_SKIP */
+
+#define EPHEM_NUM_BODIES    8       /* Mercury..Neptune, indexed by astro_body_t */
+#define EPHEM_MAX_COEFF    16
+
+typedef struct
+{
+    double  granule;    /* number of days covered by each polynomial */
+    int     ncoeff;     /* number of Chebyshev coefficients per coordinate */
 }
+ephem_layout_t;
 
+/*
+    Granule lengths and polynomial sizes for each planet.
+    Each is the cheapest layout that reproduces the VSOP87 series to within
+    1.0e-12 AU in position, which is the round-off level of the series itself.
+    The Earth needs short granules because its series includes the monthly
+    wobble caused by the Moon.
+*/
+static const ephem_layout_t EphemLayout[EPHEM_NUM_BODIES] =
+{
+    {   8.0, 12 },  /* Mercury */
+    {  32.0, 12 },  /* Venus */
+    {   8.0, 10 },  /* Earth */
+    {  64.0, 12 },  /* Mars */
+    { 128.0,  8 },  /* Jupiter */
+    { 128.0,  8 },  /* Saturn */
+    { 128.0,  8 },  /* Uranus */
+    { 128.0,  8 }   /* Neptune */
+};
 
-static void VsopDeriv(const vsop_model_t *model, double t, double deriv[3])
+typedef struct
 {
-    int k, s, i;
+    double          tt_start;   /* TT of the start of the first granule */
+    double          granule;    /* number of days covered by each polynomial */
+    int             ngranules;  /* number of consecutive polynomials */
+    int             ncoeff;     /* number of Chebyshev coefficients per coordinate */
+    const double   *coeff;      /* [ngranules][3][ncoeff] coefficients of the EQJ x, y, z coordinates */
+}
+ephem_body_t;
 
-    for (k=0; k < 3; ++k)
-    {
-        double tpower = 1.0;        /* t^s */
-        double dpower = 0.0;        /* t^(s-1) */
-        const vsop_formula_t *formula = &model->formula[k];
-        deriv[k] = 0.0;
-        for (s=0; s < formula->nseries; ++s)
-        {
-            double sin_sum = 0.0;
-            double cos_sum = 0.0;
-            const vsop_series_t *series = &formula->series[s];
-            for (i=0; i < series->nterms; ++i)
-            {
-                const vsop_term_t *term = &series->term[i];
-                double angle = term->phase + (t * term->frequency);
-                sin_sum += term->amplitude * term->frequency * sin(angle);
-                if (s > 0)
-                    cos_sum += term->amplitude * cos(angle);
-            }
-            deriv[k] += (s * dpower * cos_sum) - (tpower * sin_sum);
-            dpower = tpower;
-            tpower *= t;
-        }
-    }
+typedef struct
+{
+    double          tt_start;   /* TT at which every body's polynomials begin */
+    double          tt_stop;    /* TT at which the caller's requested range ends */
+    size_t          nbytes;     /* total memory held by the table */
+    double         *storage;    /* coefficient memory owned by the table */
+    const void     *image;      /* read-only mapping of an ephemeris file, or NULL */
+    size_t          image_bytes;
+    ephem_body_t    body[EPHEM_NUM_BODIES];
 }
+ephem_table_t;
 
+/*
+    Layout of an ephemeris file written by Astronomy_EphemerisWrite.
+    All values use the byte order of the machine that wrote the file.
+    The header is followed by `nbodies` body records, and then by each body's
+    coefficient array, starting on a multiple of EPHEM_FILE_ALIGN bytes
+    so that the arrays can be used in place from a memory-mapped file.
+*/
+#define EPHEM_FILE_MAGIC        "ASTREPH"       /* 7 characters plus the terminating NUL */
+#define EPHEM_FILE_VERSION      1
+#define EPHEM_FILE_BYTE_ORDER   0x01020304u
+#define EPHEM_FILE_ALIGN        64
 
-static body_state_t CalcVsopPosVel(const vsop_model_t *model, double tt)
+typedef struct
 {
-    body_state_t state;
-    double t = tt / DAYS_PER_MILLENNIUM;
-    double sphere[3];   /* lon, lat, r */
-    double deriv[3];    /* d(lon)/dt, d(lat)/dt, dr/dt */
-    double eclip[3];
-    double dr_dt, dlat_dt, dlon_dt;
-    double r, coslat, coslon, sinlat, sinlon;
+    char        magic[8];       /* EPHEM_FILE_MAGIC */
+    uint32_t    version;        /* EPHEM_FILE_VERSION */
+    uint32_t    byte_order;     /* EPHEM_FILE_BYTE_ORDER as stored by the writer */
+    uint32_t    nbodies;        /* number of ephem_file_body_t records */
+    uint32_t    double_bytes;   /* sizeof(double) */
+    double      tt_start;       /* beginning of the compiled range */
+    double      tt_stop;        /* end of the compiled range */
+    uint64_t    file_bytes;     /* total size of the file, to detect truncation */
+    uint64_t    reserved[2];
+}
+ephem_file_header_t;
 
-    state.tt = tt;
-    VsopCoords(model, t, sphere);
-    VsopSphereToRect(sphere[LON_INDEX], sphere[LAT_INDEX], sphere[RAD_INDEX], eclip);
-    state.r = VsopRotate(eclip);
+typedef struct
+{
+    int32_t     body;           /* astro_body_t value */
+    int32_t     ncoeff;         /* Chebyshev coefficients per coordinate */
+    int32_t     ngranules;      /* number of consecutive polynomials */
+    int32_t     reserved;
+    double      tt_start;       /* TT of the start of the first granule */
+    double      granule;        /* number of days covered by each polynomial */
+    uint64_t    offset;         /* byte offset of the coefficient array from the start of the file */
+    uint64_t    count;          /* number of doubles in the coefficient array: ngranules * 3 * ncoeff */
+}
+ephem_file_body_t;
 
-    VsopDeriv(model, t, deriv);
+/* The compiled ephemeris, or NULL when the VSOP87 series are evaluated directly. */
+static void *ephem_table;
 
-    /* Use spherical coords and spherical derivatives to calculate */
-    /* the velocity vector in rectangular coordinates. */
+/** @endcond */
 
-    /* Calculate mnemonic variables to help keep the math straight. */
-    coslon = cos(sphere[LON_INDEX]);
-    sinlon = sin(sphere[LON_INDEX]);
-    coslat = cos(sphere[LAT_INDEX]);
-    sinlat = sin(sphere[LAT_INDEX]);
-    r = sphere[RAD_INDEX];
-    dlon_dt = deriv[LON_INDEX];
-    dlat_dt = deriv[LAT_INDEX];
-    dr_dt   = deriv[RAD_INDEX];
 
-    /* vx = dx/dt */
-    eclip[0] = (dr_dt * coslat * coslon) - (r * sinlat * coslon * dlat_dt) - (r * coslat * sinlon * dlon_dt);
+static void ChebSum(const double *c, int n, double x, double *f, double *df)
+{
+    int k;
+    double b1 = 0.0, b2 = 0.0;      /* Clenshaw recurrence for sum(c[k] T_k(x)) */
+    double d1 = 0.0, d2 = 0.0;      /* Clenshaw recurrence for sum(k c[k] U_{k-1}(x)) */
+    double tmp;
 
-    /* vy = dy/dt */
-    eclip[1] = (dr_dt * coslat * sinlon) - (r * sinlat * sinlon * dlat_dt) + (r * coslat * coslon * dlon_dt);
+    for (k = n-1; k >= 1; --k)
+    {
+        tmp = c[k] + 2.0*x*b1 - b2;
+        b2 = b1;
+        b1 = tmp;
 
-    /* vz = dz/dt */
-    eclip[2] = (dr_dt * sinlat) + (r * coslat * dlat_dt);
+        tmp = k*c[k] + 2.0*x*d1 - d2;
+        d2 = d1;
+        d1 = tmp;
+    }
 
-    /* Rotate the velocity vector from ecliptic to equatorial coordinates. */
-    state.v = VsopRotate(eclip);
+    *f = c[0] + x*b1 - b2;
+    if (df != NULL)
+        *df = d1;
+}
 
-    /* Convert speed units from [AU/millennium] to [AU/day]. */
-    VecScale(&state.v, 1 / DAYS_PER_MILLENNIUM);
 
-    return state;
+/* Evaluates the compiled ephemeris. Returns 0 if it does not cover this body and time. */
+static int EphemState(int body, double tt, terse_vector_t *pos, terse_vector_t *vel)
+{
+    const ephem_table_t *table;
+    const ephem_body_t *eb;
+    const double *c;
+    double u, x, scale;
+    int g;
+
+    table = (const ephem_table_t *) AtomicLoadPtr(&ephem_table);
+    if (table == NULL || body < 0 || body >= EPHEM_NUM_BODIES)
+        return 0;
+
+    eb = &table->body[body];
+    if (eb->ngranules == 0)
+        return 0;       /* this body is not in a loaded ephemeris file */
+
+    u = (tt - eb->tt_start) / eb->granule;
+    if (!(u >= 0.0 && u <= eb->ngranules))
+        return 0;       /* outside the table, or NAN */
+
+    g = (int) u;
+    if (g == eb->ngranules)
+        --g;            /* the final instant belongs to the last granule */
+
+    x = 2.0*(u - g) - 1.0;
+    c = eb->coeff + (size_t)g * 3 * eb->ncoeff;
+    if (vel == NULL)
+    {
+        ChebSum(c,                  eb->ncoeff, x, &pos->x, NULL);
+        ChebSum(c + eb->ncoeff,     eb->ncoeff, x, &pos->y, NULL);
+        ChebSum(c + 2*eb->ncoeff,   eb->ncoeff, x, &pos->z, NULL);
+    }
+    else
+    {
+        ChebSum(c,                  eb->ncoeff, x, &pos->x, &vel->x);
+        ChebSum(c + eb->ncoeff,     eb->ncoeff, x, &pos->y, &vel->y);
+        ChebSum(c + 2*eb->ncoeff,   eb->ncoeff, x, &pos->z, &vel->z);
+
+        /* Convert d/dx to d/dt in AU/day. */
+        scale = 2.0 / eb->granule;
+        vel->x *= scale;
+        vel->y *= scale;
+        vel->z *= scale;
+    }
+    return 1;
 }
 
 
-static double VsopHelioDistance(const vsop_model_t *model, astro_time_t time)
+/* Fits one granule of Chebyshev coefficients to the VSOP87 series by interpolating at the Chebyshev nodes. */
+static void EphemFitGranule(const vsop_model_t *model, double tt1, double granule, int ncoeff, double *coeff)
 {
-    int s, i;
-    double t = time.tt / DAYS_PER_MILLENNIUM;
-    double distance = 0.0;
-    double tpower = 1.0;
-    const vsop_formula_t *formula = &model->formula[2];     /* [2] is the distance part of the formula */
+    double node[3][EPHEM_MAX_COEFF];
+    terse_vector_t pos;
+    double sum[3];
+    double angle;
+    int j, k, m;
 
-    /*
-        The caller only wants to know the distance between the planet and the Sun.
-        So we only need to calculate the radial component of the spherical coordinates.
-    */
+    for (j=0; j < ncoeff; ++j)
+    {
+        angle = PI * (j + 0.5) / ncoeff;
+        pos = VsopPosition(model, tt1 + granule * (cos(angle) + 1.0) / 2.0);
+        node[0][j] = pos.x;
+        node[1][j] = pos.y;
+        node[2][j] = pos.z;
+    }
 
-    for (s=0; s < formula->nseries; ++s)
+    for (k=0; k < ncoeff; ++k)
     {
-        double sum = 0.0;
-        const vsop_series_t *series = &formula->series[s];
-        for (i=0; i < series->nterms; ++i)
+        sum[0] = sum[1] = sum[2] = 0.0;
+        for (j=0; j < ncoeff; ++j)
         {
-            const vsop_term_t *term = &series->term[i];
-            sum += term->amplitude * cos(term->phase + (t * term->frequency));
+            angle = cos(PI * k * (j + 0.5) / ncoeff);
+            for (m=0; m < 3; ++m)
+                sum[m] += node[m][j] * angle;
         }
-        distance += tpower * sum;
-        tpower *= t;
+        for (m=0; m < 3; ++m)
+            coeff[m*ncoeff + k] = (k == 0 ? 1.0 : 2.0) * sum[m] / ncoeff;
     }
-
-    return distance;
 }
 
 
-static void AdjustBarycenter(astro_vector_t *ssb, astro_time_t time, astro_body_t body, double planet_gm)
+static void EphemUnmapFile(const void *image, size_t size)
 {
-    astro_vector_t planet;
-    double shift;
-
-    shift = planet_gm / (planet_gm + SUN_GM);
-    planet = CalcVsop(&vsop[body], time);
-    ssb->x += shift * planet.x;
-    ssb->y += shift * planet.y;
-    ssb->z += shift * planet.z;
+#if defined(EPHEM_MMAP_POSIX)
+    munmap((void *)image, size);
+#elif defined(EPHEM_MMAP_WIN32)
+    (void)size;
+    UnmapViewOfFile(image);
+#else
+    (void)image;
+    (void)size;
+#endif
 }
 
 
-static astro_vector_t CalcSolarSystemBarycenter(astro_time_t time)
+static void EphemFree(ephem_table_t *table)
 {
-    astro_vector_t ssb;
+    if (table != NULL)
+    {
+        if (table->image != NULL)
+            EphemUnmapFile(table->image, table->image_bytes);
+        free(table->storage);
+        free(table);
+    }
+}
 
-    ssb.status = ASTRO_SUCCESS;
-    ssb.t = time;
-    ssb.x = ssb.y = ssb.z = 0.0;
 
-    AdjustBarycenter(&ssb, time, BODY_JUPITER, JUPITER_GM);
-    AdjustBarycenter(&ssb, time, BODY_SATURN,  SATURN_GM);
-    AdjustBarycenter(&ssb, time, BODY_URANUS,  URANUS_GM);
-    AdjustBarycenter(&ssb, time, BODY_NEPTUNE, NEPTUNE_GM);
+/**
+ * @brief Fits Chebyshev polynomials to the planets' positions over a range of times.
+ *
+ * The heliocentric positions of Mercury through Neptune normally come from
+ * summing thousands of trigonometric terms of the VSOP87 model for each call.
+ * This function compiles those series into piecewise Chebyshev polynomials
+ * covering the time range from `startTime` to `stopTime`. Each planet gets its
+ * own granule length and polynomial size, chosen so that the polynomials
+ * reproduce the series to within 1.0e-12 AU, far below the error of the model itself.
+ *
+ * While a compiled ephemeris is active, every calculation that needs the position
+ * or velocity of one of these planets inside the compiled range, including
+ * #Astronomy_HelioVector, #Astronomy_HelioState and the Earth's position used by
+ * geocentric calculations, evaluates the polynomials instead of the series.
+ * Times outside the range are calculated from the series as usual.
+ *
+ * Calling this function again replaces the previous ephemeris.
+ * Compiling or freeing the ephemeris is not thread-safe: do not call
+ * this function while another thread may be calculating planet positions.
+ * Once compiled, the ephemeris may be read by any number of threads.
+ *
+ * @param startTime
+ *      The beginning of the time range to compile.
+ *
+ * @param stopTime
+ *      The end of the time range to compile.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if the ephemeris was compiled,
+ *      `ASTRO_INVALID_PARAMETER` if the range is not finite or too long,
+ *      or `ASTRO_OUT_OF_MEMORY` if the table could not be allocated.
+ */
+astro_status_t Astronomy_EphemerisCompile(astro_time_t startTime, astro_time_t stopTime)
+{
+    ephem_table_t *table;
+    ephem_body_t *eb;
+    double *coeff;
+    double tt1 = startTime.tt;
+    double tt2 = stopTime.tt;
+    double span;
+    size_t ncoeff = 0;
+    int body, g;
+
+    if (!isfinite(tt1) || !isfinite(tt2))
+        return ASTRO_INVALID_PARAMETER;
 
-    return ssb;
+    if (tt2 < tt1)
+    {
+        double swap = tt1;
+        tt1 = tt2;
+        tt2 = swap;
+    }
+
+    span = tt2 - tt1;
+    if (span > 1.0e+7)
+        return ASTRO_INVALID_PARAMETER;     /* more than 27,000 years */
+
+    table = (ephem_table_t *) calloc(1, sizeof(ephem_table_t));
+    if (table == NULL)
+        return ASTRO_OUT_OF_MEMORY;
+
+    table->tt_start = tt1;
+    table->tt_stop = tt2;
+    for (body=0; body < EPHEM_NUM_BODIES; ++body)
+    {
+        eb = &table->body[body];
+        eb->tt_start = tt1;
+        eb->granule = EphemLayout[body].granule;
+        eb->ncoeff = EphemLayout[body].ncoeff;
+        eb->ngranules = (int) ceil(span / eb->granule);
+        if (eb->ngranules < 1)
+            eb->ngranules = 1;
+        ncoeff += (size_t)eb->ngranules * 3 * eb->ncoeff;
+    }
+
+    table->storage = (double *) malloc(ncoeff * sizeof(double));
+    if (table->storage == NULL)
+    {
+        free(table);
+        return ASTRO_OUT_OF_MEMORY;
+    }
+    table->nbytes = sizeof(ephem_table_t) + ncoeff * sizeof(double);
+
+    coeff = table->storage;
+    for (body=0; body < EPHEM_NUM_BODIES; ++body)
+    {
+        eb = &table->body[body];
+        eb->coeff = coeff;
+        for (g=0; g < eb->ngranules; ++g)
+        {
+            EphemFitGranule(&vsop[body], eb->tt_start + g*eb->granule, eb->granule, eb->ncoeff, coeff);
+            coeff += 3 * eb->ncoeff;
+        }
+    }
+
+    EphemFree((ephem_table_t *) AtomicExchangePtr(&ephem_table, table));
+    return ASTRO_SUCCESS;
 }
 
-/*------------------ begin general gravity simulator ------------------*/
 
-static terse_vector_t UpdatePosition(double dt, terse_vector_t r, terse_vector_t v, terse_vector_t a)
+/**
+ * @brief Frees the ephemeris compiled by #Astronomy_EphemerisCompile.
+ *
+ * Afterwards, planet positions are calculated from the VSOP87 series again.
+ * This function is not thread-safe: do not call it while another thread
+ * may be calculating planet positions.
+ */
+void Astronomy_EphemerisFree(void)
 {
-    r.x += (v.x + a.x*dt/2) * dt;
-    r.y += (v.y + a.y*dt/2) * dt;
-    r.z += (v.z + a.z*dt/2) * dt;
-    return r;
+    EphemFree((ephem_table_t *) AtomicExchangePtr(&ephem_table, NULL));
 }
 
 
-static terse_vector_t UpdateVelocity(double dt, terse_vector_t v, terse_vector_t a)
+/**
+ * @brief Describes the ephemeris compiled by #Astronomy_EphemerisCompile.
+ *
+ * @return
+ *      If an ephemeris is active, `status` is `ASTRO_SUCCESS`, `start` and `stop`
+ *      hold the compiled time range, and `bytes` is the memory it occupies.
+ *      Otherwise `status` is `ASTRO_NOT_INITIALIZED`.
+ */
+astro_ephemeris_info_t Astronomy_EphemerisInfo(void)
 {
-    v.x += dt * a.x;
-    v.y += dt * a.y;
-    v.z += dt * a.z;
-    return v;
+    astro_ephemeris_info_t info;
+    const ephem_table_t *table = (const ephem_table_t *) AtomicLoadPtr(&ephem_table);
+
+    if (table == NULL)
+    {
+        info.status = ASTRO_NOT_INITIALIZED;
+        info.start = info.stop = TimeError();
+        info.bytes = 0;
+    }
+    else
+    {
+        info.status = ASTRO_SUCCESS;
+        info.start = Astronomy_TerrestrialTime(table->tt_start);
+        info.stop = Astronomy_TerrestrialTime(table->tt_stop);
+        info.bytes = table->nbytes;
+    }
+    return info;
 }
 
 
-static body_state_t AdjustBarycenterPosVel(body_state_t *ssb, double tt, astro_body_t body, double planet_gm)
+static size_t EphemAlign(size_t offset)
 {
-    body_state_t planet;
-    double shift;
-
-    /*
-        This function does 2 important things:
-        1. Adjusts 'ssb' by the effect of one major body on the Solar System Barycenter.
-        2, Returns the heliocentric position of that major body.
-    */
+    return (offset + (EPHEM_FILE_ALIGN - 1)) & ~(size_t)(EPHEM_FILE_ALIGN - 1);
+}
 
-    shift = planet_gm / (planet_gm + SUN_GM);
-    planet = CalcVsopPosVel(&vsop[body], tt);
-    VecIncr(&ssb->r, VecMul(shift, planet.r));
-    VecIncr(&ssb->v, VecMul(shift, planet.v));
 
-    return planet;
+static int EphemWritePadding(FILE *outfile, size_t count)
+{
+    static const char zeros[EPHEM_FILE_ALIGN] = { 0 };
+    return count == 0 || fwrite(zeros, 1, count, outfile) == count;
 }
 
 
-static void MajorBodyBary(major_bodies_t *bary, double tt)
+/**
+ * @brief Writes the compiled ephemeris to a file.
+ *
+ * Saves the polynomials built by #Astronomy_EphemerisCompile (or loaded by
+ * #Astronomy_EphemerisLoad) in a versioned binary format that
+ * #Astronomy_EphemerisLoad can map into memory without parsing.
+ * The file starts with a header describing the compiled time range,
+ * followed by one record per body giving its granule length, coefficient count
+ * and the location of its coefficients. The coefficient arrays follow,
+ * each aligned to a 64-byte boundary.
+ *
+ * The file uses the byte order of the machine that wrote it, and can only
+ * be loaded on machines with the same byte order.
+ *
+ * @param filename
+ *      The name of the file to create or overwrite.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if the file was written,
+ *      `ASTRO_NOT_INITIALIZED` if no ephemeris is active,
+ *      or `ASTRO_INVALID_PARAMETER` if the file could not be written.
+ */
+astro_status_t Astronomy_EphemerisWrite(const char *filename)
 {
-    /* Initialize the Sun's position as a zero vector, then adjust it from pulls from the planets. */
-    bary->Sun.tt = tt;
-    bary->Sun.r = VecZero;
-    bary->Sun.v = VecZero;
+    const ephem_table_t *table;
+    ephem_file_header_t header;
+    ephem_file_body_t record[EPHEM_NUM_BODIES];
+    size_t offset, position;
+    FILE *outfile;
+    int body, ok;
 
-    /* Calculate heliocentric planet positions and SSB. */
-    bary->Jupiter = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_JUPITER, JUPITER_GM);
-    bary->Saturn  = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_SATURN,  SATURN_GM);
-    bary->Uranus  = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_URANUS,  URANUS_GM);
-    bary->Neptune = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_NEPTUNE, NEPTUNE_GM);
+    table = (const ephem_table_t *) AtomicLoadPtr(&ephem_table);
+    if (table == NULL)
+        return ASTRO_NOT_INITIALIZED;
 
-    /* Convert planet [pos, vel] from heliocentric to barycentric. */
-    VecDecr(&bary->Jupiter.r, bary->Sun.r);  VecDecr(&bary->Jupiter.v, bary->Sun.v);
-    VecDecr(&bary->Saturn.r,  bary->Sun.r);  VecDecr(&bary->Saturn.v,  bary->Sun.v);
-    VecDecr(&bary->Uranus.r,  bary->Sun.r);  VecDecr(&bary->Uranus.v,  bary->Sun.v);
-    VecDecr(&bary->Neptune.r, bary->Sun.r);  VecDecr(&bary->Neptune.v, bary->Sun.v);
+    if (filename == NULL)
+        return ASTRO_INVALID_PARAMETER;
 
-    /* Convert heliocentric SSB to barycentric Sun. */
-    VecScale(&bary->Sun.r, -1.0);
-    VecScale(&bary->Sun.v, -1.0);
-}
+    offset = sizeof(header) + EPHEM_NUM_BODIES * sizeof(ephem_file_body_t);
+    memset(record, 0, sizeof(record));
+    for (body=0; body < EPHEM_NUM_BODIES; ++body)
+    {
+        const ephem_body_t *eb = &table->body[body];
+        offset = EphemAlign(offset);
+        record[body].body = body;
+        record[body].ncoeff = eb->ncoeff;
+        record[body].ngranules = eb->ngranules;
+        record[body].tt_start = eb->tt_start;
+        record[body].granule = eb->granule;
+        record[body].offset = offset;
+        record[body].count = (uint64_t)eb->ngranules * 3 * eb->ncoeff;
+        offset += (size_t)record[body].count * sizeof(double);
+    }
 
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EPHEM_FILE_MAGIC, sizeof(header.magic));
+    header.version = EPHEM_FILE_VERSION;
+    header.byte_order = EPHEM_FILE_BYTE_ORDER;
+    header.nbodies = EPHEM_NUM_BODIES;
+    header.double_bytes = sizeof(double);
+    header.tt_start = table->tt_start;
+    header.tt_stop = table->tt_stop;
+    header.file_bytes = offset;
+
+    outfile = fopen(filename, "wb");
+    if (outfile == NULL)
+        return ASTRO_INVALID_PARAMETER;
 
-static void AddAcceleration(terse_vector_t *acc, terse_vector_t small_pos, double gm, terse_vector_t major_pos)
-{
-    double dx, dy, dz, r2, pull;
+    ok = (fwrite(&header, sizeof(header), 1, outfile) == 1);
+    ok = ok && (fwrite(record, sizeof(record), 1, outfile) == 1);
+    position = sizeof(header) + sizeof(record);
+    for (body=0; ok && body < EPHEM_NUM_BODIES; ++body)
+    {
+        ok = EphemWritePadding(outfile, (size_t)record[body].offset - position);
+        ok = ok && (fwrite(table->body[body].coeff, sizeof(double), (size_t)record[body].count, outfile) == (size_t)record[body].count);
+        position = (size_t)record[body].offset + (size_t)record[body].count * sizeof(double);
+    }
 
-    dx = major_pos.x - small_pos.x;
-    dy = major_pos.y - small_pos.y;
-    dz = major_pos.z - small_pos.z;
+    if (fclose(outfile) != 0)
+        ok = 0;
 
-    r2 = dx*dx + dy*dy + dz*dz;
-    pull = gm / (r2 * sqrt(r2));
+    if (!ok)
+    {
+        remove(filename);
+        return ASTRO_INVALID_PARAMETER;
+    }
 
-    acc->x += dx * pull;
-    acc->y += dy * pull;
-    acc->z += dz * pull;
+    return ASTRO_SUCCESS;
 }
 
 
-static terse_vector_t SmallBodyAcceleration(terse_vector_t small_pos, const major_bodies_t *bary)
+/* Maps a file into read-only memory, or reads it into allocated memory on platforms without mmap. */
+static astro_status_t EphemMapFile(const char *filename, const void **image, size_t *size, double **storage)
 {
-    terse_vector_t acc = VecZero;
+#if defined(EPHEM_MMAP_POSIX)
+    struct stat info;
+    void *data;
+    int fd;
 
-    /* Use barycentric coordinates of the Sun and major planets to calculate gravitational accelerations. */
-    AddAcceleration(&acc, small_pos, SUN_GM,     bary->Sun.r);
-    AddAcceleration(&acc, small_pos, JUPITER_GM, bary->Jupiter.r);
-    AddAcceleration(&acc, small_pos, SATURN_GM,  bary->Saturn.r);
-    AddAcceleration(&acc, small_pos, URANUS_GM,  bary->Uranus.r);
-    AddAcceleration(&acc, small_pos, NEPTUNE_GM, bary->Neptune.r);
+    *storage = NULL;
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return ASTRO_INVALID_PARAMETER;
 
-    return acc;
-}
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        return ASTRO_INVALID_PARAMETER;
+    }
 
+    data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return ASTRO_OUT_OF_MEMORY;
 
-body_grav_calc_t GravSim(           /* out: [pos, vel, acc] of the simulated body at time tt2 */
-    major_bodies_t *bary2,          /* temp: work area for major body barycentric state */
-    double tt2,                     /* in:  a target time to be calculated (either before or after tt1) */
-    const body_grav_calc_t *calc1)  /* in:  [pos, vel, acc] of the simulated body at time tt1 */
-{
-    body_grav_calc_t calc2;
-    terse_vector_t approx_pos;
-    terse_vector_t acc;
-    const double dt = tt2 - calc1->tt;
+    *image = data;
+    *size = (size_t)info.st_size;
+    return ASTRO_SUCCESS;
+#elif defined(EPHEM_MMAP_WIN32)
+    HANDLE file, mapping;
+    LARGE_INTEGER length;
+    void *data;
+
+    *storage = NULL;
+    file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return ASTRO_INVALID_PARAMETER;
 
-    /* Calculate where the major bodies (Sun, Jupiter...Neptune) will be at the next time step. */
-    MajorBodyBary(bary2, tt2);
+    if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return ASTRO_INVALID_PARAMETER;
+    }
 
-    /* Estimate position of small body as if current acceleration applies across the whole time interval. */
-    /* approx_pos = pos1 + vel1*dt + (1/2)acc*dt^2 */
-    approx_pos = UpdatePosition(dt, calc1->r, calc1->v, calc1->a);
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL)
+        return ASTRO_OUT_OF_MEMORY;
 
-    /* Calculate acceleration experienced by small body at approximate next location. */
-    acc = SmallBodyAcceleration(approx_pos, bary2);
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == NULL)
+        return ASTRO_OUT_OF_MEMORY;
 
-    /* Calculate the average acceleration of the endpoints. */
-    /* This becomes our estimate of the mean effective acceleration over the whole interval. */
-    acc = VecMean(acc, calc1->a);
+    *image = data;
+    *size = (size_t)length.QuadPart;
+    return ASTRO_SUCCESS;
+#else
+    FILE *infile;
+    long length;
 
-    /* Refine the estimates of [pos, vel, acc] at tt2 using the mean acceleration. */
-    calc2.r = UpdatePosition(dt, calc1->r, calc1->v, acc);
-    calc2.v = UpdateVelocity(dt, calc1->v, acc);
-    calc2.a = SmallBodyAcceleration(calc2.r, bary2);
-    calc2.tt = tt2;
-    return calc2;
+    *image = NULL;
+    *storage = NULL;
+    infile = fopen(filename, "rb");
+    if (infile == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (fseek(infile, 0, SEEK_END) != 0 || (length = ftell(infile)) <= 0 || fseek(infile, 0, SEEK_SET) != 0)
+    {
+        fclose(infile);
+        return ASTRO_INVALID_PARAMETER;
+    }
+
+    *storage = (double *) malloc((size_t)length);
+    if (*storage == NULL)
+    {
+        fclose(infile);
+        return ASTRO_OUT_OF_MEMORY;
+    }
+
+    if (fread(*storage, 1, (size_t)length, infile) != (size_t)length)
+    {
+        fclose(infile);
+        free(*storage);
+        *storage = NULL;
+        return ASTRO_INVALID_PARAMETER;
+    }
+
+    fclose(infile);
+    *size = (size_t)length;
+    return ASTRO_SUCCESS;
+#endif
 }
 
 
-static body_grav_calc_t GravFromState(major_bodies_t *bary, const body_state_t *state)
+/* Validates an ephemeris file image and points the table's coefficient arrays into it. */
+static astro_status_t EphemAttach(ephem_table_t *table, const char *data, size_t size)
 {
-    body_grav_calc_t calc;
+    ephem_file_header_t header;
+    ephem_file_body_t record;
+    uint32_t i;
+    int body;
 
-    MajorBodyBary(bary, state->tt);
+    if (size < sizeof(header))
+        return ASTRO_INVALID_PARAMETER;
 
-    calc.tt = state->tt;
-    calc.r  = VecAdd(state->r, bary->Sun.r);      /* convert heliocentric to barycentric */
-    calc.v  = VecAdd(state->v, bary->Sun.v);      /* convert heliocentric to barycentric */
-    calc.a  = SmallBodyAcceleration(calc.r, bary);
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, EPHEM_FILE_MAGIC, sizeof(header.magic)) != 0)
+        return ASTRO_INVALID_PARAMETER;
 
-    return calc;
+    if (header.version != EPHEM_FILE_VERSION || header.byte_order != EPHEM_FILE_BYTE_ORDER || header.double_bytes != sizeof(double))
+        return ASTRO_INVALID_PARAMETER;
+
+    if (header.file_bytes != size || header.nbodies > EPHEM_NUM_BODIES)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (size < sizeof(header) + header.nbodies * sizeof(record))
+        return ASTRO_INVALID_PARAMETER;
+
+    if (!isfinite(header.tt_start) || !isfinite(header.tt_stop))
+        return ASTRO_INVALID_PARAMETER;
+
+    table->tt_start = header.tt_start;
+    table->tt_stop = header.tt_stop;
+    for (i=0; i < header.nbodies; ++i)
+    {
+        memcpy(&record, data + sizeof(header) + i*sizeof(record), sizeof(record));
+        body = record.body;
+        if (body < 0 || body >= EPHEM_NUM_BODIES || table->body[body].ngranules != 0)
+            return ASTRO_INVALID_PARAMETER;     /* unknown or duplicate body */
+
+        if (record.ncoeff < 1 || record.ncoeff > EPHEM_MAX_COEFF || record.ngranules < 1)
+            return ASTRO_INVALID_PARAMETER;
+
+        if (!isfinite(record.tt_start) || !isfinite(record.granule) || record.granule <= 0.0)
+            return ASTRO_INVALID_PARAMETER;
+
+        if (record.count != (uint64_t)record.ngranules * 3 * record.ncoeff)
+            return ASTRO_INVALID_PARAMETER;
+
+        if (record.offset % sizeof(double) != 0 || record.offset > size || record.count > (size - record.offset) / sizeof(double))
+            return ASTRO_INVALID_PARAMETER;
+
+        table->body[body].tt_start = record.tt_start;
+        table->body[body].granule = record.granule;
+        table->body[body].ncoeff = record.ncoeff;
+        table->body[body].ngranules = record.ngranules;
+        table->body[body].coeff = (const double *)(data + record.offset);
+    }
+
+    return ASTRO_SUCCESS;
 }
 
 
-static void CalcSolarSystem(astro_grav_sim_t *sim)
+/**
+ * @brief Loads an ephemeris file written by #Astronomy_EphemerisWrite.
+ *
+ * The file is mapped read-only into memory and its coefficient arrays
+ * are used in place, so loading costs no parsing, and processes that load
+ * the same file share one copy of it through the operating system's page cache.
+ * On platforms without memory mapping, the file is read into memory instead.
+ *
+ * The loaded ephemeris replaces any active one and is used exactly like
+ * a freshly compiled ephemeris; see #Astronomy_EphemerisCompile.
+ * The file must not be modified while it is loaded.
+ * Loading or freeing the ephemeris is not thread-safe: do not call
+ * this function while another thread may be calculating planet positions.
+ *
+ * @param filename
+ *      The name of the file to load.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if the ephemeris was loaded,
+ *      `ASTRO_INVALID_PARAMETER` if the file could not be read or is not
+ *      a valid ephemeris file for this machine,
+ *      or `ASTRO_OUT_OF_MEMORY` if the file could not be mapped.
+ *      On failure, the active ephemeris is left unchanged.
+ */
+astro_status_t Astronomy_EphemerisLoad(const char *filename)
 {
-    int body;
-    double tt = sim->curr->time.tt;
-    body_state_t *grav = sim->curr->gravitators;
-    body_state_t *sun = &grav[BODY_SUN];
+    ephem_table_t *table;
+    const void *image = NULL;
+    double *storage = NULL;
+    size_t size = 0;
+    astro_status_t status;
 
-    /* Initialize the Sun's position/velocity as zero vectors, then adjust from pulls from the planets. */
-    sun->tt = tt;
-    sun->r  = VecZero;
-    sun->v  = VecZero;
+    if (filename == NULL)
+        return ASTRO_INVALID_PARAMETER;
 
-    /* Calculate the position of each planet, and adjust the SSB position accordingly. */
-    grav[BODY_MERCURY] = AdjustBarycenterPosVel(sun, tt, BODY_MERCURY, MERCURY_GM);
-    grav[BODY_VENUS  ] = AdjustBarycenterPosVel(sun, tt, BODY_VENUS,   VENUS_GM);
-    grav[BODY_EARTH  ] = AdjustBarycenterPosVel(sun, tt, BODY_EARTH,   EARTH_GM + MOON_GM);
-    grav[BODY_MARS   ] = AdjustBarycenterPosVel(sun, tt, BODY_MARS,    MARS_GM);
-    grav[BODY_JUPITER] = AdjustBarycenterPosVel(sun, tt, BODY_JUPITER, JUPITER_GM);
-    grav[BODY_SATURN ] = AdjustBarycenterPosVel(sun, tt, BODY_SATURN,  SATURN_GM);
-    grav[BODY_URANUS ] = AdjustBarycenterPosVel(sun, tt, BODY_URANUS,  URANUS_GM);
-    grav[BODY_NEPTUNE] = AdjustBarycenterPosVel(sun, tt, BODY_NEPTUNE, NEPTUNE_GM);
+    table = (ephem_table_t *) calloc(1, sizeof(ephem_table_t));
+    if (table == NULL)
+        return ASTRO_OUT_OF_MEMORY;
 
-    /* Convert planet state vectors from heliocentric to barycentric. */
-    for (body = BODY_MERCURY; body <= BODY_NEPTUNE; ++body)
+    status = EphemMapFile(filename, &image, &size, &storage);
+    if (status != ASTRO_SUCCESS)
     {
-        VecDecr(&grav[body].r, sun->r);
-        VecDecr(&grav[body].v, sun->v);
+        free(table);
+        return status;
     }
 
-    /* Convert heliocentric SSB to barycentric Sun. */
-    VecScale(&sun->r, -1.0);
-    VecScale(&sun->v, -1.0);
+    table->image = image;
+    table->image_bytes = size;
+    table->storage = storage;
+    table->nbytes = sizeof(ephem_table_t) + size;
+
+    status = EphemAttach(table, (image != NULL) ? (const char *)image : (const char *)storage, size);
+    if (status != ASTRO_SUCCESS)
+    {
+        EphemFree(table);
+        return status;
+    }
+
+    EphemFree((ephem_table_t *) AtomicExchangePtr(&ephem_table, table));
+    return ASTRO_SUCCESS;
 }
 
 
-static void CalcBodyAccelerations(astro_grav_sim_t *sim)
+static astro_vector_t CalcVsop(const vsop_model_t *model, astro_time_t time)
 {
-    int i;
-    const body_state_t *grav = sim->curr->gravitators;
+    astro_vector_t vector;
+    terse_vector_t pos;
 
-    /* Calculate the gravitational acceleration experienced by the simulated bodies. */
-    for (i = 0; i < sim->numBodies; ++i)
-    {
-        body_grav_calc_t *calc = &sim->curr->bodies[i];
+    if (!EphemState((int)(model - vsop), time.tt, &pos, NULL))
+        pos = VsopPosition(model, time.tt);
 
-        calc->a = VecZero;
+    /* Package the position as astro_vector_t. */
+    vector.status = ASTRO_SUCCESS;
+    vector.t = time;
+    vector.x = pos.x;
+    vector.y = pos.y;
+    vector.z = pos.z;
 
-        AddAcceleration(&calc->a, calc->r, SUN_GM,              grav[BODY_SUN    ].r);
-        AddAcceleration(&calc->a, calc->r, MERCURY_GM,          grav[BODY_MERCURY].r);
-        AddAcceleration(&calc->a, calc->r, VENUS_GM,            grav[BODY_VENUS  ].r);
-        AddAcceleration(&calc->a, calc->r, EARTH_GM + MOON_GM,  grav[BODY_EARTH  ].r);
-        AddAcceleration(&calc->a, calc->r, MARS_GM,             grav[BODY_MARS   ].r);
-        AddAcceleration(&calc->a, calc->r, JUPITER_GM,          grav[BODY_JUPITER].r);
-        AddAcceleration(&calc->a, calc->r, SATURN_GM,           grav[BODY_SATURN ].r);
-        AddAcceleration(&calc->a, calc->r, URANUS_GM,           grav[BODY_URANUS ].r);
-        AddAcceleration(&calc->a, calc->r, NEPTUNE_GM,          grav[BODY_NEPTUNE].r);
+    return vector;
+}
+
+
+/** @cond DOXYGEN_SKIP */
+#define VSOP_BATCH          8           /* number of times evaluated together by VsopPositionBatch */
+#define VSOP_FAST_COS_LIMIT 1.0e+6      /* largest angle [radians] that VsopCosBatch reduces accurately */
+/** @endcond */
+
+
+/*
+    Calculates cos(angle[j]) for a batch of angles.
+    The loop has no branches or library calls, so compilers can turn it into
+    SSE2/AVX2/NEON instructions. The angle is reduced to [-pi/4, +pi/4] using
+    a 3-part Cody-Waite split of pi/2, then a sine or cosine polynomial is
+    chosen by the quadrant. The result is within 1 ulp of the C library's cos()
+    for angles up to VSOP_FAST_COS_LIMIT; larger angles must use cos() instead.
+*/
+static void VsopCosBatch(const double angle[VSOP_BATCH], double result[VSOP_BATCH])
+{
+    const double round = 6755399441055744.0;    /* 1.5 * 2^52: adding it rounds to an integer held in the low mantissa bits */
+    double shifted, q, r, z, sinr, cosr, value;
+    uint64_t quadrant;
+    int j;
+
+    for (j=0; j < VSOP_BATCH; ++j)
+    {
+        shifted = angle[j]*0.63661977236758134308 + round;
+        q = shifted - round;
+        memcpy(&quadrant, &shifted, sizeof(quadrant));
+        r = ((angle[j] - q*1.57079632673412561417e+00) - q*6.07710050630396597660e-11) - q*2.02226624871116645580e-21;
+        z = r*r;
+        sinr = r + r*z*(-1.66666666666666324348e-01 + z*(8.33333333332248946124e-03 + z*(-1.98412698298579493134e-04 + z*(2.75573137070700676789e-06 + z*(-2.50507602534068634195e-08 + z*1.58969099521155010221e-10)))));
+        cosr = 1.0 - 0.5*z + z*z*(4.16666666666666019037e-02 + z*(-1.38888888888741095749e-03 + z*(2.48015872894767294178e-05 + z*(-2.75573143513906633035e-07 + z*(2.08757232129817482790e-09 + z*-1.13596475577881948265e-11)))));
+        value = (quadrant & 1) ? sinr : cosr;
+        result[j] = ((quadrant + 1) & 2) ? -value : value;
     }
 }
 
 
-static body_state_t *GravSimBodyStatePtr(astro_grav_sim_t *sim, astro_body_t body)
+/*
+    Like VsopCosBatch, but calculates both the sine and cosine of each angle
+    from a single argument reduction. Either output may be NULL.
+*/
+static void VsopSinCosBatch(const double angle[VSOP_BATCH], double sine[VSOP_BATCH], double cosine[VSOP_BATCH])
 {
-    /*
-        Return a pointer to the place where we cache the barycentric
-        state of the given body, or NULL if this body is not one
-        that we use for calculating gravitational interactions.
-    */
+    const double round = 6755399441055744.0;
+    double shifted, q, r, z, sinr, cosr, value;
+    uint64_t quadrant;
+    int j;
 
-    if ((body == BODY_SUN) || (body >= BODY_MERCURY && body <= BODY_NEPTUNE))
-        return &sim->curr->gravitators[body];
+    for (j=0; j < VSOP_BATCH; ++j)
+    {
+        shifted = angle[j]*0.63661977236758134308 + round;
+        q = shifted - round;
+        memcpy(&quadrant, &shifted, sizeof(quadrant));
+        r = ((angle[j] - q*1.57079632673412561417e+00) - q*6.07710050630396597660e-11) - q*2.02226624871116645580e-21;
+        z = r*r;
+        sinr = r + r*z*(-1.66666666666666324348e-01 + z*(8.33333333332248946124e-03 + z*(-1.98412698298579493134e-04 + z*(2.75573137070700676789e-06 + z*(-2.50507602534068634195e-08 + z*1.58969099521155010221e-10)))));
+        cosr = 1.0 - 0.5*z + z*z*(4.16666666666666019037e-02 + z*(-1.38888888888741095749e-03 + z*(2.48015872894767294178e-05 + z*(-2.75573143513906633035e-07 + z*(2.08757232129817482790e-09 + z*-1.13596475577881948265e-11)))));
+        if (sine != NULL)
+        {
+            value = (quadrant & 1) ? cosr : sinr;
+            sine[j] = (quadrant & 2) ? -value : value;
+        }
+        if (cosine != NULL)
+        {
+            value = (quadrant & 1) ? sinr : cosr;
+            cosine[j] = ((quadrant + 1) & 2) ? -value : value;
+        }
+    }
+}
 
-    return NULL;
+
+/*
+    Evaluates the VSOP87 series for VSOP_BATCH times at once.
+    Each term is read once and applied to every time in the batch,
+    instead of walking the whole term table once per time as VsopCoords does.
+*/
+static void VsopPositionBatch(const vsop_model_t *model, const double tt[VSOP_BATCH], terse_vector_t pos[VSOP_BATCH])
+{
+    double t[VSOP_BATCH];
+    double sphere[3][VSOP_BATCH];
+    double tpower[VSOP_BATCH];
+    double sum[VSOP_BATCH];
+    double angle[VSOP_BATCH];
+    double cosine[VSOP_BATCH];
+    double eclip[3];
+    double tmax = 0.0;
+    double incr;
+    int j, k, s, i;
+
+    for (j=0; j < VSOP_BATCH; ++j)
+    {
+        t[j] = tt[j] / DAYS_PER_MILLENNIUM;
+        if (fabs(t[j]) > tmax)
+            tmax = fabs(t[j]);
+    }
+
+    for (k=0; k < 3; ++k)
+    {
+        const vsop_formula_t *formula = &model->formula[k];
+        for (j=0; j < VSOP_BATCH; ++j)
+        {
+            tpower[j] = 1.0;
+            sphere[k][j] = 0.0;
+        }
+        for (s=0; s < formula->nseries; ++s)
+        {
+            const vsop_series_t *series = &formula->series[s];
+            for (j=0; j < VSOP_BATCH; ++j)
+                sum[j] = 0.0;
+
+            for (i=0; i < series->nterms; ++i)
+            {
+                const vsop_term_t *term = &series->term[i];
+                for (j=0; j < VSOP_BATCH; ++j)
+                    angle[j] = term->phase + (t[j] * term->frequency);
+
+                VsopCosBatch(angle, cosine);
+                if (!(fabs(term->phase) + tmax*fabs(term->frequency) < VSOP_FAST_COS_LIMIT))
+                {
+                    /* Decide per time, so that each result does not depend on the rest of the batch. */
+                    for (j=0; j < VSOP_BATCH; ++j)
+                        if (!(fabs(angle[j]) < VSOP_FAST_COS_LIMIT))
+                            cosine[j] = cos(angle[j]);
+                }
+
+                for (j=0; j < VSOP_BATCH; ++j)
+                    sum[j] += term->amplitude * cosine[j];
+            }
+
+            for (j=0; j < VSOP_BATCH; ++j)
+            {
+                incr = tpower[j] * sum[j];
+                if (k == LON_INDEX)
+                    incr = fmod(incr, PI2);     /* improve precision for longitudes, which can be hundreds of radians */
+                sphere[k][j] += incr;
+                tpower[j] *= t[j];
+            }
+        }
+    }
+
+    for (j=0; j < VSOP_BATCH; ++j)
+    {
+        VsopSphereToRect(sphere[LON_INDEX][j], sphere[LAT_INDEX][j], sphere[RAD_INDEX][j], eclip);
+        pos[j] = VsopRotate(eclip);
+    }
 }
 
 
-static astro_state_vector_t GravSimOriginState(astro_grav_sim_t *sim)
+/* Evaluates a partial or full batch of times, then scatters the positions into `vector`. */
+static void VsopFlushBatch(const vsop_model_t *model, int n, double tt[VSOP_BATCH], const int index[VSOP_BATCH], astro_vector_t *vector)
 {
-    const body_state_t *optr;
-    astro_time_t time = sim->curr->time;
+    terse_vector_t pos[VSOP_BATCH];
+    int j;
 
-    if (sim->originBody == BODY_SSB)
+    /* Pad a partial batch by repeating its last time. */
+    for (j=n; j < VSOP_BATCH; ++j)
+        tt[j] = tt[n-1];
+
+    VsopPositionBatch(model, tt, pos);
+    for (j=0; j < n; ++j)
     {
-        /* The barycentric state of the SSB is zero, by definition. */
-        astro_state_vector_t state;
-        state.status = ASTRO_SUCCESS;
-        state.t  = time;
-        state.x  = 0.0;
-        state.y  = 0.0;
-        state.z  = 0.0;
-        state.vx = 0.0;
-        state.vy = 0.0;
-        state.vz = 0.0;
-        return state;
+        vector[index[j]].x = pos[j].x;
+        vector[index[j]].y = pos[j].y;
+        vector[index[j]].z = pos[j].z;
     }
+}
 
-    optr = GravSimBodyStatePtr(sim, sim->originBody);
-    if (optr != NULL)
-        return ExportState(*optr, time);
 
-    /* We only support the VSOP bodies, for efficiency. */
-    return StateVecError(ASTRO_INVALID_BODY, time);
+/*
+    Calculates the position of a VSOP87 planet at many times, like calling CalcVsop for each.
+    Times covered by a compiled ephemeris use its polynomials; the rest are
+    gathered into batches for VsopPositionBatch.
+*/
+static void CalcVsopBatch(const vsop_model_t *model, int count, const astro_time_t *time, astro_vector_t *vector)
+{
+    int body = (int)(model - vsop);
+    int index[VSOP_BATCH];
+    double tt[VSOP_BATCH];
+    terse_vector_t pos;
+    int i, n = 0;
+
+    for (i=0; i < count; ++i)
+    {
+        vector[i].status = ASTRO_SUCCESS;
+        vector[i].t = time[i];
+        if (EphemState(body, time[i].tt, &pos, NULL))
+        {
+            vector[i].x = pos.x;
+            vector[i].y = pos.y;
+            vector[i].z = pos.z;
+        }
+        else
+        {
+            index[n] = i;
+            tt[n] = time[i].tt;
+            if (++n == VSOP_BATCH)
+            {
+                VsopFlushBatch(model, n, tt, index, vector);
+                n = 0;
+            }
+        }
+    }
+
+    if (n > 0)
+        VsopFlushBatch(model, n, tt, index, vector);
 }
 
 
-static void GravSimDuplicate(astro_grav_sim_t *sim)
-{
-    /* Copy the current state into the previous state, so that both become the same moment in time. */
-    sim->prev->time = sim->curr->time;
-    memcpy(sim->prev->gravitators, sim->curr->gravitators, sizeof(sim->prev->gravitators));
-    memcpy(sim->prev->bodies, sim->curr->bodies, ((size_t)sim->numBodies) * sizeof(sim->prev->bodies[0]));
+static void VsopDeriv(const vsop_model_t *model, double t, double deriv[3])
+{
+    int k, s, i;
+
+    for (k=0; k < 3; ++k)
+    {
+        double tpower = 1.0;        /* t^s */
+        double dpower = 0.0;        /* t^(s-1) */
+        const vsop_formula_t *formula = &model->formula[k];
+        deriv[k] = 0.0;
+        for (s=0; s < formula->nseries; ++s)
+        {
+            double sin_sum = 0.0;
+            double cos_sum = 0.0;
+            const vsop_series_t *series = &formula->series[s];
+            for (i=0; i < series->nterms; ++i)
+            {
+                const vsop_term_t *term = &series->term[i];
+                double angle = term->phase + (t * term->frequency);
+                sin_sum += term->amplitude * term->frequency * sin(angle);
+                if (s > 0)
+                    cos_sum += term->amplitude * cos(angle);
+            }
+            deriv[k] += (s * dpower * cos_sum) - (tpower * sin_sum);
+            dpower = tpower;
+            tpower *= t;
+        }
+    }
+}
+
+
+static body_state_t CalcVsopPosVel(const vsop_model_t *model, double tt)
+{
+    body_state_t state;
+    double t = tt / DAYS_PER_MILLENNIUM;
+    double sphere[3];   /* lon, lat, r */
+    double deriv[3];    /* d(lon)/dt, d(lat)/dt, dr/dt */
+    double eclip[3];
+    double dr_dt, dlat_dt, dlon_dt;
+    double r, coslat, coslon, sinlat, sinlon;
+
+    state.tt = tt;
+    if (EphemState((int)(model - vsop), tt, &state.r, &state.v))
+        return state;
+
+    VsopCoords(model, t, sphere);
+    VsopSphereToRect(sphere[LON_INDEX], sphere[LAT_INDEX], sphere[RAD_INDEX], eclip);
+    state.r = VsopRotate(eclip);
+
+    VsopDeriv(model, t, deriv);
+
+    /* Use spherical coords and spherical derivatives to calculate */
+    /* the velocity vector in rectangular coordinates. */
+
+    /* Calculate mnemonic variables to help keep the math straight. */
+    coslon = cos(sphere[LON_INDEX]);
+    sinlon = sin(sphere[LON_INDEX]);
+    coslat = cos(sphere[LAT_INDEX]);
+    sinlat = sin(sphere[LAT_INDEX]);
+    r = sphere[RAD_INDEX];
+    dlon_dt = deriv[LON_INDEX];
+    dlat_dt = deriv[LAT_INDEX];
+    dr_dt   = deriv[RAD_INDEX];
+
+    /* vx = dx/dt */
+    eclip[0] = (dr_dt * coslat * coslon) - (r * sinlat * coslon * dlat_dt) - (r * coslat * sinlon * dlon_dt);
+
+    /* vy = dy/dt */
+    eclip[1] = (dr_dt * coslat * sinlon) - (r * sinlat * sinlon * dlat_dt) + (r * coslat * coslon * dlon_dt);
+
+    /* vz = dz/dt */
+    eclip[2] = (dr_dt * sinlat) + (r * coslat * dlat_dt);
+
+    /* Rotate the velocity vector from ecliptic to equatorial coordinates. */
+    state.v = VsopRotate(eclip);
+
+    /* Convert speed units from [AU/millennium] to [AU/day]. */
+    VecScale(&state.v, 1 / DAYS_PER_MILLENNIUM);
+
+    return state;
+}
+
+
+static double VsopHelioDistance(const vsop_model_t *model, astro_time_t time)
+{
+    int s, i;
+    double t = time.tt / DAYS_PER_MILLENNIUM;
+    double distance = 0.0;
+    double tpower = 1.0;
+    const vsop_formula_t *formula = &model->formula[2];     /* [2] is the distance part of the formula */
+
+    /*
+        The caller only wants to know the distance between the planet and the Sun.
+        So we only need to calculate the radial component of the spherical coordinates.
+    */
+
+    for (s=0; s < formula->nseries; ++s)
+    {
+        double sum = 0.0;
+        const vsop_series_t *series = &formula->series[s];
+        for (i=0; i < series->nterms; ++i)
+        {
+            const vsop_term_t *term = &series->term[i];
+            sum += term->amplitude * cos(term->phase + (t * term->frequency));
+        }
+        distance += tpower * sum;
+        tpower *= t;
+    }
+
+    return distance;
+}
+
+
+static void AdjustBarycenter(astro_vector_t *ssb, astro_time_t time, astro_body_t body, double planet_gm)
+{
+    astro_vector_t planet;
+    double shift;
+
+    shift = planet_gm / (planet_gm + SUN_GM);
+    planet = CalcVsop(&vsop[body], time);
+    ssb->x += shift * planet.x;
+    ssb->y += shift * planet.y;
+    ssb->z += shift * planet.z;
+}
+
+
+static astro_vector_t CalcSolarSystemBarycenter(astro_time_t time)
+{
+    astro_vector_t ssb;
+
+    ssb.status = ASTRO_SUCCESS;
+    ssb.t = time;
+    ssb.x = ssb.y = ssb.z = 0.0;
+
+    AdjustBarycenter(&ssb, time, BODY_JUPITER, JUPITER_GM);
+    AdjustBarycenter(&ssb, time, BODY_SATURN,  SATURN_GM);
+    AdjustBarycenter(&ssb, time, BODY_URANUS,  URANUS_GM);
+    AdjustBarycenter(&ssb, time, BODY_NEPTUNE, NEPTUNE_GM);
+
+    return ssb;
+}
+
+/*------------------ begin general gravity simulator ------------------*/
+
+static terse_vector_t UpdatePosition(double dt, terse_vector_t r, terse_vector_t v, terse_vector_t a)
+{
+    r.x += (v.x + a.x*dt/2) * dt;
+    r.y += (v.y + a.y*dt/2) * dt;
+    r.z += (v.z + a.z*dt/2) * dt;
+    return r;
+}
+
+
+static terse_vector_t UpdateVelocity(double dt, terse_vector_t v, terse_vector_t a)
+{
+    v.x += dt * a.x;
+    v.y += dt * a.y;
+    v.z += dt * a.z;
+    return v;
+}
+
+
+static body_state_t AdjustBarycenterPosVel(body_state_t *ssb, double tt, astro_body_t body, double planet_gm)
+{
+    body_state_t planet;
+    double shift;
+
+    /*
+        This function does 2 important things:
+        1. Adjusts 'ssb' by the effect of one major body on the Solar System Barycenter.
+        2, Returns the heliocentric position of that major body.
+    */
+
+    shift = planet_gm / (planet_gm + SUN_GM);
+    planet = CalcVsopPosVel(&vsop[body], tt);
+    VecIncr(&ssb->r, VecMul(shift, planet.r));
+    VecIncr(&ssb->v, VecMul(shift, planet.v));
+
+    return planet;
+}
+
+
+static void MajorBodyBary(major_bodies_t *bary, double tt)
+{
+    /* Initialize the Sun's position as a zero vector, then adjust it from pulls from the planets. */
+    bary->Sun.tt = tt;
+    bary->Sun.r = VecZero;
+    bary->Sun.v = VecZero;
+
+    /* Calculate heliocentric planet positions and SSB. */
+    bary->Jupiter = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_JUPITER, JUPITER_GM);
+    bary->Saturn  = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_SATURN,  SATURN_GM);
+    bary->Uranus  = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_URANUS,  URANUS_GM);
+    bary->Neptune = AdjustBarycenterPosVel(&bary->Sun, tt, BODY_NEPTUNE, NEPTUNE_GM);
+
+    /* Convert planet [pos, vel] from heliocentric to barycentric. */
+    VecDecr(&bary->Jupiter.r, bary->Sun.r);  VecDecr(&bary->Jupiter.v, bary->Sun.v);
+    VecDecr(&bary->Saturn.r,  bary->Sun.r);  VecDecr(&bary->Saturn.v,  bary->Sun.v);
+    VecDecr(&bary->Uranus.r,  bary->Sun.r);  VecDecr(&bary->Uranus.v,  bary->Sun.v);
+    VecDecr(&bary->Neptune.r, bary->Sun.r);  VecDecr(&bary->Neptune.v, bary->Sun.v);
+
+    /* Convert heliocentric SSB to barycentric Sun. */
+    VecScale(&bary->Sun.r, -1.0);
+    VecScale(&bary->Sun.v, -1.0);
+}
+
+
+static void AddAcceleration(terse_vector_t *acc, terse_vector_t small_pos, double gm, terse_vector_t major_pos)
+{
+    double dx, dy, dz, r2, pull;
+
+    dx = major_pos.x - small_pos.x;
+    dy = major_pos.y - small_pos.y;
+    dz = major_pos.z - small_pos.z;
+
+    r2 = dx*dx + dy*dy + dz*dz;
+    pull = gm / (r2 * sqrt(r2));
+
+    acc->x += dx * pull;
+    acc->y += dy * pull;
+    acc->z += dz * pull;
+}
+
+
+static terse_vector_t SmallBodyAcceleration(terse_vector_t small_pos, const major_bodies_t *bary)
+{
+    terse_vector_t acc = VecZero;
+
+    /* Use barycentric coordinates of the Sun and major planets to calculate gravitational accelerations. */
+    AddAcceleration(&acc, small_pos, SUN_GM,     bary->Sun.r);
+    AddAcceleration(&acc, small_pos, JUPITER_GM, bary->Jupiter.r);
+    AddAcceleration(&acc, small_pos, SATURN_GM,  bary->Saturn.r);
+    AddAcceleration(&acc, small_pos, URANUS_GM,  bary->Uranus.r);
+    AddAcceleration(&acc, small_pos, NEPTUNE_GM, bary->Neptune.r);
+
+    return acc;
+}
+
+
+body_grav_calc_t GravSim(           /* out: [pos, vel, acc] of the simulated body at time tt2 */
+    major_bodies_t *bary2,          /* temp: work area for major body barycentric state */
+    double tt2,                     /* in:  a target time to be calculated (either before or after tt1) */
+    const body_grav_calc_t *calc1)  /* in:  [pos, vel, acc] of the simulated body at time tt1 */
+{
+    body_grav_calc_t calc2;
+    terse_vector_t approx_pos;
+    terse_vector_t acc;
+    const double dt = tt2 - calc1->tt;
+
+    /* Calculate where the major bodies (Sun, Jupiter...Neptune) will be at the next time step. */
+    MajorBodyBary(bary2, tt2);
+
+    /* Estimate position of small body as if current acceleration applies across the whole time interval. */
+    /* approx_pos = pos1 + vel1*dt + (1/2)acc*dt^2 */
+    approx_pos = UpdatePosition(dt, calc1->r, calc1->v, calc1->a);
+
+    /* Calculate acceleration experienced by small body at approximate next location. */
+    acc = SmallBodyAcceleration(approx_pos, bary2);
+
+    /* Calculate the average acceleration of the endpoints. */
+    /* This becomes our estimate of the mean effective acceleration over the whole interval. */
+    acc = VecMean(acc, calc1->a);
+
+    /* Refine the estimates of [pos, vel, acc] at tt2 using the mean acceleration. */
+    calc2.r = UpdatePosition(dt, calc1->r, calc1->v, acc);
+    calc2.v = UpdateVelocity(dt, calc1->v, acc);
+    calc2.a = SmallBodyAcceleration(calc2.r, bary2);
+    calc2.tt = tt2;
+    return calc2;
+}
+
+
+static body_grav_calc_t GravFromState(major_bodies_t *bary, const body_state_t *state)
+{
+    body_grav_calc_t calc;
+
+    MajorBodyBary(bary, state->tt);
+
+    calc.tt = state->tt;
+    calc.r  = VecAdd(state->r, bary->Sun.r);      /* convert heliocentric to barycentric */
+    calc.v  = VecAdd(state->v, bary->Sun.v);      /* convert heliocentric to barycentric */
+    calc.a  = SmallBodyAcceleration(calc.r, bary);
+
+    return calc;
+}
+
+
+static void CalcGravitators(body_state_t *grav, double tt)
+{
+    int body;
+    body_state_t *sun = &grav[BODY_SUN];
+
+    /* Initialize the Sun's position/velocity as zero vectors, then adjust from pulls from the planets. */
+    sun->tt = tt;
+    sun->r  = VecZero;
+    sun->v  = VecZero;
+
+    /* Calculate the position of each planet, and adjust the SSB position accordingly. */
+    grav[BODY_MERCURY] = AdjustBarycenterPosVel(sun, tt, BODY_MERCURY, MERCURY_GM);
+    grav[BODY_VENUS  ] = AdjustBarycenterPosVel(sun, tt, BODY_VENUS,   VENUS_GM);
+    grav[BODY_EARTH  ] = AdjustBarycenterPosVel(sun, tt, BODY_EARTH,   EARTH_GM + MOON_GM);
+    grav[BODY_MARS   ] = AdjustBarycenterPosVel(sun, tt, BODY_MARS,    MARS_GM);
+    grav[BODY_JUPITER] = AdjustBarycenterPosVel(sun, tt, BODY_JUPITER, JUPITER_GM);
+    grav[BODY_SATURN ] = AdjustBarycenterPosVel(sun, tt, BODY_SATURN,  SATURN_GM);
+    grav[BODY_URANUS ] = AdjustBarycenterPosVel(sun, tt, BODY_URANUS,  URANUS_GM);
+    grav[BODY_NEPTUNE] = AdjustBarycenterPosVel(sun, tt, BODY_NEPTUNE, NEPTUNE_GM);
+
+    /* Convert planet state vectors from heliocentric to barycentric. */
+    for (body = BODY_MERCURY; body <= BODY_NEPTUNE; ++body)
+    {
+        VecDecr(&grav[body].r, sun->r);
+        VecDecr(&grav[body].v, sun->v);
+    }
+
+    /* Convert heliocentric SSB to barycentric Sun. */
+    VecScale(&sun->r, -1.0);
+    VecScale(&sun->v, -1.0);
+}
+
+
+static void CalcSolarSystem(astro_grav_sim_t *sim)
+{
+    CalcGravitators(sim->curr->gravitators, sim->curr->time.tt);
+}
+
+
+static void CalcBodyAccelerations(astro_grav_sim_t *sim)
+{
+    int i;
+    const body_state_t *grav = sim->curr->gravitators;
+
+    /* Calculate the gravitational acceleration experienced by the simulated bodies. */
+    for (i = 0; i < sim->numBodies; ++i)
+    {
+        body_grav_calc_t *calc = &sim->curr->bodies[i];
+
+        calc->a = VecZero;
+
+        AddAcceleration(&calc->a, calc->r, SUN_GM,              grav[BODY_SUN    ].r);
+        AddAcceleration(&calc->a, calc->r, MERCURY_GM,          grav[BODY_MERCURY].r);
+        AddAcceleration(&calc->a, calc->r, VENUS_GM,            grav[BODY_VENUS  ].r);
+        AddAcceleration(&calc->a, calc->r, EARTH_GM + MOON_GM,  grav[BODY_EARTH  ].r);
+        AddAcceleration(&calc->a, calc->r, MARS_GM,             grav[BODY_MARS   ].r);
+        AddAcceleration(&calc->a, calc->r, JUPITER_GM,          grav[BODY_JUPITER].r);
+        AddAcceleration(&calc->a, calc->r, SATURN_GM,           grav[BODY_SATURN ].r);
+        AddAcceleration(&calc->a, calc->r, URANUS_GM,           grav[BODY_URANUS ].r);
+        AddAcceleration(&calc->a, calc->r, NEPTUNE_GM,          grav[BODY_NEPTUNE].r);
+    }
+}
+
+
+static body_state_t *GravSimBodyStatePtr(astro_grav_sim_t *sim, astro_body_t body)
+{
+    /*
+        Return a pointer to the place where we cache the barycentric
+        state of the given body, or NULL if this body is not one
+        that we use for calculating gravitational interactions.
+    */
+
+    if ((body == BODY_SUN) || (body >= BODY_MERCURY && body <= BODY_NEPTUNE))
+        return &sim->curr->gravitators[body];
+
+    return NULL;
+}
+
+
+static astro_state_vector_t GravOriginState(const body_state_t *grav, astro_body_t originBody, astro_time_t time)
+{
+    if (originBody == BODY_SSB)
+    {
+        /* The barycentric state of the SSB is zero, by definition. */
+        astro_state_vector_t state;
+        state.status = ASTRO_SUCCESS;
+        state.t  = time;
+        state.x  = 0.0;
+        state.y  = 0.0;
+        state.z  = 0.0;
+        state.vx = 0.0;
+        state.vy = 0.0;
+        state.vz = 0.0;
+        return state;
+    }
+
+    /* We only support the VSOP bodies, for efficiency. */
+    if ((originBody == BODY_SUN) || (originBody >= BODY_MERCURY && originBody <= BODY_NEPTUNE))
+        return ExportState(grav[originBody], time);
+
+    return StateVecError(ASTRO_INVALID_BODY, time);
+}
+
+
+static astro_state_vector_t GravSimOriginState(astro_grav_sim_t *sim)
+{
+    return GravOriginState(sim->curr->gravitators, sim->originBody, sim->curr->time);
+}
+
+
+static void GravSimDuplicate(astro_grav_sim_t *sim)
+{
+    /* Copy the current state into the previous state, so that both become the same moment in time. */
+    sim->prev->time = sim->curr->time;
+    memcpy(sim->prev->gravitators, sim->curr->gravitators, sizeof(sim->prev->gravitators));
+    memcpy(sim->prev->bodies, sim->curr->bodies, ((size_t)sim->numBodies) * sizeof(sim->prev->bodies[0]));
+}
+
+
+/**
+ * @brief Allocate and initialize a gravity step simulator.
+ *
+ * Prepares to simulate a series of incremental time steps,
+ * simulating the movement of zero or more small bodies through the Solar System
+ * acting under gravitational attraction from the Sun and planets.
+ *
+ * After calling this function, you can call #Astronomy_GravSimUpdate
+ * as many times as desired to advance the simulation by small time steps.
+ *
+ * If this function succeeds (returns `ASTRO_SUCCESS`), `sim`
+ * will be set to a dynamically allocated object. The caller is
+ * then responsible for eventually calling #Astronomy_GravSimFree
+ * to release the memory.
+ *
+ * @param simOut
+ *      The address of a pointer to store the newly allocated simulation object.
+ *      The type #astro_grav_sim_t is an opaque type, so its internal structure is not documented.
+ *
+ * @param originBody
+ *      Specifies the origin of the reference frame.
+ *      All position vectors and velocity vectors will use `originBody`
+ *      as the origin of the coordinate system.
+ *      This origin applies to all the input vectors provided in the
+ *      `bodyStateArray` parameter of this function, along with all
+ *      output vectors returned by #Astronomy_GravSimUpdate.
+ *      Most callers will want to provide one of the following:
+ *      `BODY_SUN` for heliocentric coordinates,
+ *      `BODY_SSB` for solar system barycentric coordinates,
+ *      or `BODY_EARTH` for geocentric coordinates. Note that the
+ *      gravity simulator does not correct for light travel time;
+ *      all state vectors are tied to a Newtonian "instantaneous" time.
+ *
+ * @param time
+ *      The initial time at which to start the simulation.
+ *
+ * @param numBodies
+ *      The number of small bodies to be simulated. This may be any non-negative integer.
+ *
+ * @param bodyStateArray
+ *      An array of initial state vectors (positions and velocities) of the small bodies to be simulated.
+ *      The caller must know the positions and velocities of the small bodies at an initial moment in time.
+ *      Their positions and velocities are expressed with respect to `originBody`, using J2000 mean equator orientation (EQJ).
+ *      Positions are expressed in astronomical units (AU). Velocities are expressed in AU/day.
+ *      All the times embedded within the state vectors must be exactly equal to `time`,
+ *      or this function will fail with the error `ASTRO_INCONSISTENT_TIMES`.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` on success, with `*sim` set to a non-NULL value. Otherwise an error code with `*sim` set to NULL.
+ */
+astro_status_t Astronomy_GravSimInit(
+    astro_grav_sim_t **simOut,
+    astro_body_t originBody,
+    astro_time_t time,
+    int numBodies,
+    const astro_state_vector_t *bodyStateArray)
+{
+    astro_grav_sim_t *sim;
+    astro_status_t status;
+    body_grav_calc_t *array;
+    int i;
+
+    /* Validate parameters before attempting to allocate memory. */
+
+    if (simOut == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    *simOut = NULL;
+
+    if (numBodies < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (numBodies > 0 && bodyStateArray == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (originBody < BODY_MERCURY || originBody > BODY_SSB)
+        return ASTRO_INVALID_BODY;
+
+    /* Verify that all the state vectors are valid and have matching times. */
+    for (i = 0; i < numBodies; ++i)
+    {
+        if (bodyStateArray[i].status != ASTRO_SUCCESS)
+            return ASTRO_INVALID_PARAMETER;
+
+        if (bodyStateArray[i].t.tt != time.tt)
+            return ASTRO_INCONSISTENT_TIMES;
+    }
+
+    *simOut = sim = (astro_grav_sim_t *) calloc(1, sizeof(astro_grav_sim_t));
+    if (sim == NULL)
+        return ASTRO_OUT_OF_MEMORY;
+
+    sim->originBody = originBody;
+    sim->numBodies = numBodies;
+    sim->prev = &(sim->endpoint[0]);
+    sim->curr = &(sim->endpoint[1]);
+    sim->curr->time = time;
+
+    if (numBodies > 0)
+    {
+        sim->prev->bodies = (body_grav_calc_t *) calloc(numBodies, sizeof(body_grav_calc_t));
+        sim->curr->bodies = (body_grav_calc_t *) calloc(numBodies, sizeof(body_grav_calc_t));
+        if (sim->prev->bodies == NULL || sim->curr->bodies == NULL)
+        {
+            status = ASTRO_OUT_OF_MEMORY;
+            goto fail;
+        }
+    }
+
+    /* Remember the initial states of all the bodies as "current". */
+    /* Convert from the public type astro_state_t to our internal type body_grav_calc_t. */
+    array = sim->curr->bodies;
+    for (i = 0; i < numBodies; ++i)
+    {
+        array[i].tt  = bodyStateArray[i].t.tt;
+        array[i].r.x = bodyStateArray[i].x;
+        array[i].r.y = bodyStateArray[i].y;
+        array[i].r.z = bodyStateArray[i].z;
+        array[i].v.x = bodyStateArray[i].vx;
+        array[i].v.y = bodyStateArray[i].vy;
+        array[i].v.z = bodyStateArray[i].vz;
+    }
+
+    /* Calculate the state of the Sun and planets. */
+    CalcSolarSystem(sim);
+
+    /*
+        We need to do all the physics calculations in barycentric coordinates.
+        But the caller can provide the input vectors with respect to any body.
+        Correct the input body state vectors for the specified coordinate origin.
+    */
+    if (originBody != BODY_SSB)
+    {
+        /* Determine the barycentric state of the origin body. */
+        astro_state_vector_t originState = GravSimOriginState(sim);
+        if (originState.status != ASTRO_SUCCESS)
+        {
+            status = originState.status;
+            goto fail;
+        }
+
+        /* Add barycentric origin to origin-centric body to obtain barycentric body. */
+        for (i = 0; i < numBodies; ++i)
+        {
+            array[i].r.x += originState.x;
+            array[i].r.y += originState.y;
+            array[i].r.z += originState.z;
+            array[i].v.x += originState.vx;
+            array[i].v.y += originState.vy;
+            array[i].v.z += originState.vz;
+        }
+    }
+
+    /* Calculate the net acceleration experienced by the small bodies. */
+    CalcBodyAccelerations(sim);
+
+    /* To prepare for a possible swap operation, duplicate the current state into the previous state. */
+    GravSimDuplicate(sim);
+
+    return ASTRO_SUCCESS;
+
+fail:
+    Astronomy_GravSimFree(sim);
+    *simOut = NULL;
+    return status;
+}
+
+
+/**
+ * @brief Advances a gravity simulation by a small time step.
+ *
+ * @param sim
+ *      A simulation object that was created by a prior call to #Astronomy_GravSimInit.
+ *
+ * @param time
+ *      A time that is a small increment away from the current simulation time.
+ *      It is up to the developer to figure out an appropriate time increment.
+ *      Depending on the trajectories, a smaller or larger increment
+ *      may be needed for the desired accuracy. Some experimentation may be needed.
+ *      Generally, bodies that stay in the outer Solar System and move slowly can
+ *      use larger time steps.  Bodies that pass into the inner Solar System and
+ *      move faster will need a smaller time step to maintain accuracy.
+ *      The `time` value may be after or before the current simulation time
+ *      to move forward or backward in time.
+ *
+ * @param numBodies
+ *      The number of bodies whose state vectors are to be updated.
+ *      This is the number of elements in the `bodyStateArray`.
+ *      This parameter is passed as a sanity check, and must be equal
+ *      to the value passed to #Astronomy_GravSimInit when `sim` was created.
+ *
+ * @param bodyStateArray
+ *      An array big enough to hold `numBodies` state vectors, to receive
+ *      the updated positions and velocities of the simulated small bodies.
+ *      Alternatively, `bodyStateArray` may be NULL if the output of this
+ *      simulation step is not needed. This makes the call slightly faster.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if the calculation was successful.
+ *      Otherwise, an error code if something went wrong, in which case
+ *      the simulation should be considered "broken". This means there
+ *      is no reliable output in `bodyStateArray` and that no more calculations
+ *      can be performed with `sim`.
+ */
+astro_status_t Astronomy_GravSimUpdate(
+    astro_grav_sim_t *sim,
+    astro_time_t time,
+    int numBodies,
+    astro_state_vector_t *bodyStateArray)
+{
+    terse_vector_t acc;
+    double dt;      /* terrestrial time increment */
+    int i;
+
+    /*
+        The caller's understanding of the number of bodies must match the actual
+        array size in `sim`, or we risk corrupting/accessing invalid memory.
+    */
+    if (numBodies != sim->numBodies)
+        return ASTRO_INVALID_PARAMETER;
+
+    dt = time.tt - sim->curr->time.tt;
+
+    if (dt == 0.0)
+    {
+        /*
+            Special case: the time has not changed, so skip the usual physics calculations.
+            This allows a way for the caller to query the current state if desired.
+            It is also necessary to avoid dividing by `dt` if `dt` is zero.
+            To prepare for a possible swap operation, duplicate the current state into the previous state.
+        */
+        GravSimDuplicate(sim);
+    }
+    else
+    {
+        /* Swap the current state and the previous state. Then calculate the new current state. */
+        Astronomy_GravSimSwap(sim);
+
+        /* Update the current time. This is the only place we have a full (tt,ut) pair. */
+        /* All of the Newtonian dynamics are calculated using tt only. */
+        sim->curr->time = time;
+
+        /* Now that sim->time is set, it is safe to call `CalcSolarSystem`. */
+        CalcSolarSystem(sim);
+
+        for (i = 0; i < numBodies; ++i)
+        {
+            /*
+                Estimate the positions of the small bodies as if their
+                current accelerations apply across the whole time interval.
+                approx_pos = pos1 + vel1*dt + (1/2)acc*dt^2
+            */
+            const body_grav_calc_t *prev = &sim->prev->bodies[i];
+            sim->curr->bodies[i].r = UpdatePosition(dt, prev->r, prev->v, prev->a);
+        }
+
+        /*
+            Calculate the acceleration experienced by the small bodies
+            at their respective approximate next locations.
+        */
+        CalcBodyAccelerations(sim);
+
+        for (i = 0; i < numBodies; ++i)
+        {
+            const body_grav_calc_t *prev = &sim->prev->bodies[i];
+            body_grav_calc_t *curr = &sim->curr->bodies[i];
+
+            /*
+                Calculate the average of the acceleration vectors
+                experienced by the previous body positions and
+                their estimated next positions.
+                These become estimates of the mean effective accelerations over the whole interval.
+            */
+            acc = VecMean(prev->a, curr->a);
+
+            /*
+                Refine the estimates of position and velocity at the next time step,
+                using the mean acceleration as a better approximation of the
+                continuously changing acceleration acting on each body.
+            */
+            curr->tt = time.tt;
+            curr->r = UpdatePosition(dt, prev->r, prev->v, acc);
+            curr->v = UpdateVelocity(dt, prev->v, acc);
+        }
+
+        /*
+            Re-calculate accelerations experienced by each body.
+            These will be needed for the next simulation step (if any).
+            Also, they will be potentially useful if some day we add
+            a function to query the acceleration vectors for the bodies.
+        */
+        CalcBodyAccelerations(sim);
+    }
+
+    /*
+        Translate our internal calculations of body positions
+        and velocities into state vectors that the caller can understand.
+        But if the output buffer `bodyStateArray` is NULL, it means
+        the caller wanted us to update the simulation state without
+        returning any output.
+    */
+    if (bodyStateArray != NULL)
+    {
+        for (i = 0; i < numBodies; ++i)
+            bodyStateArray[i] = ExportGravCalc(sim->curr->bodies[i], time);
+
+        if (sim->originBody != BODY_SSB)
+        {
+            /* Determine the barycentric state of the origin body. */
+            astro_state_vector_t originState = GravSimOriginState(sim);
+            if (originState.status != ASTRO_SUCCESS)
+                return originState.status;
+
+            /* Subtract vectors to convert barycentric states to origin-centric states. */
+            for (i = 0; i < numBodies; ++i)
+            {
+                bodyStateArray[i].x  -= originState.x;
+                bodyStateArray[i].y  -= originState.y;
+                bodyStateArray[i].z  -= originState.z;
+                bodyStateArray[i].vx -= originState.vx;
+                bodyStateArray[i].vy -= originState.vy;
+                bodyStateArray[i].vz -= originState.vz;
+            }
+        }
+    }
+
+    return ASTRO_SUCCESS;
+}
+
+
+/**
+ * @brief Get the position and velocity of a Solar System body included in the simulation.
+ *
+ * In order to simulate the movement of small bodies through the Solar System,
+ * the simulator needs to calculate the state vectors for the Sun and planets.
+ *
+ * If an application wants to know the positions of one or more of the planets
+ * in addition to the small bodies, this function provides a way to obtain
+ * their state vectors. This is provided for the sake of efficiency, to avoid
+ * redundant calculations.
+ *
+ * @param sim
+ *      A gravity simulator object created by a successful call to #Astronomy_GravSimInit.
+ *
+ * @param body
+ *      The Sun, Mercury, Venus, Earth, Mars, Jupiter, Saturn, Uranus, or Neptune.
+ *
+ * @return
+ *      If the given body is part of the set of calculated bodies
+ *      (Sun and planets), returns the current time step's state
+ *      vector for that body, expressed in the coordinate system
+ *      that was specified by the `originBody` parameter to #Astronomy_GravSimInit.
+ *      Success is indicated by the returned structure's `status` field holding
+ *      `ASTRO_SUCCESS`. Any other `status` value indicates an error, meaning
+ *      the returned state vector is invalid.
+ */
+astro_state_vector_t Astronomy_GravSimBodyState(
+    astro_grav_sim_t *sim,
+    astro_body_t body)
+{
+    astro_state_vector_t state;
+    body_state_t *bptr;
+
+    bptr = GravSimBodyStatePtr(sim, body);
+    if (bptr == NULL)
+        return StateVecError(ASTRO_INVALID_BODY, sim->curr->time);
+
+    state = GravSimOriginState(sim);
+    if (state.status != ASTRO_SUCCESS)
+        return state;
+
+    /*
+        Subtract the origin's state from the body's barycentric
+        state to get the body in the desired reference frame.
+        state.t and state.status are already initialized correctly.
+    */
+
+    state.x  = bptr->r.x - state.x;
+    state.y  = bptr->r.y - state.y;
+    state.z  = bptr->r.z - state.z;
+    state.vx = bptr->v.x - state.vx;
+    state.vy = bptr->v.y - state.vy;
+    state.vz = bptr->v.z - state.vz;
+
+    return state;
+}
+
+
+/**
+ * @brief Exchange the current time step with the previous time step.
+ *
+ * Sometimes it is helpful to "explore" various times near a given
+ * simulation time step, while repeatedly returning to the original
+ * time step. For example, when backdating a position for light travel
+ * time, the caller may wish to repeatedly try different amounts of
+ * backdating. When the backdating solver has converged, the caller
+ * wants to leave the simulation in its original state.
+ *
+ * This function allows a single "undo" of a simulation, and does so
+ * very efficiently.
+ *
+ * Usually this function will be called immediately after a matching
+ * call to #Astronomy_GravSimUpdate. It has the effect of rolling
+ * back the most recent update. If called twice in a row, it reverts
+ * the swap and thus has no net effect.
+ *
+ * #Astronomy_GravSimInit initializes the current state and previous
+ * state to be identical. Both states represent the `time` parameter that was
+ * passed into the initializer. Therefore, `Astronomy_GravSimSwap` will
+ * have no effect from the caller's point of view when passed a simulator
+ * that has not yet been updated by a call to #Astronomy_GravSimUpdate.
+ *
+ * @param sim
+ *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ */
+void Astronomy_GravSimSwap(astro_grav_sim_t *sim)
+{
+    gravsim_endpoint_t *swap = sim->prev;
+    sim->prev = sim->curr;
+    sim->curr = swap;
+}
+
+
+/**
+ * @brief Returns the time of the current simulation step.
+ *
+ * @param sim
+ *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ */
+astro_time_t Astronomy_GravSimTime(const astro_grav_sim_t *sim)
+{
+    return sim->curr->time;
+}
+
+
+/**
+ * @brief Returns the number of small bodies represented in this simulation.
+ *
+ * When a simulation is created by a call to #Astronomy_GravSimInit,
+ * the caller specifies the number of small bodies.
+ * This function returns that same number, which may be convenient for a caller,
+ * so that it does not need to track the body count separately.
+ *
+ * @param sim
+ *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ */
+int Astronomy_GravSimNumBodies(const astro_grav_sim_t *sim)
+{
+    return sim->numBodies;
+}
+
+
+/**
+ * @brief Returns the body whose center is the coordinate origin that small bodies are referenced to.
+ *
+ * When a simulation is created by a call to #Astronomy_GravSimInit,
+ * the caller specifies an `originBody` to indicate the coordinate origin
+ * used to represent the small bodies being simulated.
+ * This function returns that same #astro_body_t value.
+ *
+ * @param sim
+ *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ */
+astro_body_t Astronomy_GravSimOrigin(const astro_grav_sim_t *sim)
+{
+    return sim->originBody;
+}
+
+
+/**
+ * @brief Releases memory allocated to a gravity simulator object.
+ *
+ * To avoid memory leaks, any successful call to #Astronomy_GravSimInit
+ * must be paired with a matching call to `Astronomy_GravSimFree`.
+ *
+ * @param sim
+ *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ */
+void Astronomy_GravSimFree(astro_grav_sim_t *sim)
+{
+    if (sim != NULL)
+    {
+        free(sim->endpoint[0].bodies);
+        free(sim->endpoint[1].bodies);
+        free(sim);
+    }
+}
+
+
+/*------------------ structure-of-arrays gravity simulator ------------------*/
+
+/** @cond DOXYGEN_SKIP */
+#define GRAV_BATCH_BLOCK  256      /* bodies per pass, small enough for the block's arrays to stay in L1 cache */
+/** @endcond */
+
+/* Adds one major body's pull to the accelerations of `count` small bodies. */
+static void GravBatchPull(
+    int count,
+    double gm,
+    terse_vector_t major_pos,
+    const double *rx, const double *ry, const double *rz,
+    double *ax, double *ay, double *az)
+{
+    double dx, dy, dz, r2, pull;
+    int i;
+
+    /* The same arithmetic as AddAcceleration, one component array at a time so the loop can be vectorized. */
+    for (i = 0; i < count; ++i)
+    {
+        dx = major_pos.x - rx[i];
+        dy = major_pos.y - ry[i];
+        dz = major_pos.z - rz[i];
+
+        r2 = dx*dx + dy*dy + dz*dz;
+        pull = gm / (r2 * sqrt(r2));
+
+        ax[i] += dx * pull;
+        ay[i] += dy * pull;
+        az[i] += dz * pull;
+    }
+}
+
+
+static void GravBatchAccelerations(grav_batch_endpoint_t *end, int first, int count)
+{
+    const body_state_t *grav = end->gravitators;
+    const double *rx = end->rx + first;
+    const double *ry = end->ry + first;
+    const double *rz = end->rz + first;
+    double *ax = end->ax + first;
+    double *ay = end->ay + first;
+    double *az = end->az + first;
+
+    memset(ax, 0, count * sizeof(double));
+    memset(ay, 0, count * sizeof(double));
+    memset(az, 0, count * sizeof(double));
+
+    /* Sum the pulls in the same order as CalcBodyAccelerations, so the results match Astronomy_GravSimUpdate exactly. */
+    GravBatchPull(count, SUN_GM,              grav[BODY_SUN    ].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, MERCURY_GM,          grav[BODY_MERCURY].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, VENUS_GM,            grav[BODY_VENUS  ].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, EARTH_GM + MOON_GM,  grav[BODY_EARTH  ].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, MARS_GM,             grav[BODY_MARS   ].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, JUPITER_GM,          grav[BODY_JUPITER].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, SATURN_GM,           grav[BODY_SATURN ].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, URANUS_GM,           grav[BODY_URANUS ].r, rx, ry, rz, ax, ay, az);
+    GravBatchPull(count, NEPTUNE_GM,          grav[BODY_NEPTUNE].r, rx, ry, rz, ax, ay, az);
+}
+
+
+static void GravBatchDuplicate(astro_grav_batch_t *batch)
+{
+    /* Copy the current state into the previous state, so that both become the same moment in time. */
+    batch->prev->time = batch->curr->time;
+    memcpy(batch->prev->gravitators, batch->curr->gravitators, sizeof(batch->prev->gravitators));
+    if (batch->numBodies > 0)
+        memcpy(batch->prev->rx, batch->curr->rx, 9 * (size_t)batch->numBodies * sizeof(double));
+}
+
+
+/* Allocates a simulation object with room for `numBodies` small bodies, with their states not yet set. */
+static astro_grav_batch_t *GravBatchAlloc(astro_body_t originBody, int numBodies)
+{
+    astro_grav_batch_t *batch;
+    grav_batch_endpoint_t *end;
+    double *block;
+    int k;
+
+    batch = (astro_grav_batch_t *) calloc(1, sizeof(astro_grav_batch_t));
+    if (batch == NULL)
+        return NULL;
+
+    batch->originBody = originBody;
+    batch->numBodies = numBodies;
+    batch->prev = &batch->endpoint[0];
+    batch->curr = &batch->endpoint[1];
+
+    if (numBodies > 0)
+    {
+        /* Each endpoint keeps its nine arrays in one allocation, in the order declared. */
+        for (k = 0; k < 2; ++k)
+        {
+            block = (double *) malloc(9 * (size_t)numBodies * sizeof(double));
+            if (block == NULL)
+            {
+                Astronomy_GravBatchFree(batch);
+                return NULL;
+            }
+            end = &batch->endpoint[k];
+            end->rx = block;
+            end->ry = block + 1*(size_t)numBodies;
+            end->rz = block + 2*(size_t)numBodies;
+            end->vx = block + 3*(size_t)numBodies;
+            end->vy = block + 4*(size_t)numBodies;
+            end->vz = block + 5*(size_t)numBodies;
+            end->ax = block + 6*(size_t)numBodies;
+            end->ay = block + 7*(size_t)numBodies;
+            end->az = block + 8*(size_t)numBodies;
+        }
+    }
+
+    return batch;
 }
 
 
 /**
- * @brief Allocate and initialize a gravity step simulator.
+ * @brief Allocate and initialize a structure-of-arrays gravity simulator.
  *
- * Prepares to simulate a series of incremental time steps,
- * simulating the movement of zero or more small bodies through the Solar System
- * acting under gravitational attraction from the Sun and planets.
+ * This is a variant of #Astronomy_GravSimInit for large numbers of small bodies.
+ * It integrates with exactly the same method and arithmetic, so its results are
+ * identical, but it keeps the positions, velocities and accelerations of the small
+ * bodies in separate arrays of `double` instead of an array of state vectors.
+ * The accelerations are then summed one major body at a time over blocks of
+ * small bodies, in loops that compilers can vectorize.
  *
- * After calling this function, you can call #Astronomy_GravSimUpdate
- * as many times as desired to advance the simulation by small time steps.
+ * A simulation step can also be split across threads:
+ * see #Astronomy_GravBatchPrepare and #Astronomy_GravBatchAdvance.
  *
- * If this function succeeds (returns `ASTRO_SUCCESS`), `sim`
- * will be set to a dynamically allocated object. The caller is
- * then responsible for eventually calling #Astronomy_GravSimFree
- * to release the memory.
+ * If this function succeeds, the caller must eventually call
+ * #Astronomy_GravBatchFree to release the memory.
  *
- * @param simOut
+ * @param batchOut
  *      The address of a pointer to store the newly allocated simulation object.
- *      The type #astro_grav_sim_t is an opaque type, so its internal structure is not documented.
  *
  * @param originBody
- *      Specifies the origin of the reference frame.
- *      All position vectors and velocity vectors will use `originBody`
- *      as the origin of the coordinate system.
- *      This origin applies to all the input vectors provided in the
- *      `bodyStateArray` parameter of this function, along with all
- *      output vectors returned by #Astronomy_GravSimUpdate.
- *      Most callers will want to provide one of the following:
- *      `BODY_SUN` for heliocentric coordinates,
- *      `BODY_SSB` for solar system barycentric coordinates,
- *      or `BODY_EARTH` for geocentric coordinates. Note that the
- *      gravity simulator does not correct for light travel time;
- *      all state vectors are tied to a Newtonian "instantaneous" time.
+ *      The origin of the input and output state vectors; see #Astronomy_GravSimInit.
  *
  * @param time
  *      The initial time at which to start the simulation.
@@ -4054,453 +6349,728 @@ static void GravSimDuplicate(astro_grav_sim_t *sim)
  * @param numBodies
  *      The number of small bodies to be simulated. This may be any non-negative integer.
  *
- * @param bodyStateArray
- *      An array of initial state vectors (positions and velocities) of the small bodies to be simulated.
- *      The caller must know the positions and velocities of the small bodies at an initial moment in time.
- *      Their positions and velocities are expressed with respect to `originBody`, using J2000 mean equator orientation (EQJ).
- *      Positions are expressed in astronomical units (AU). Velocities are expressed in AU/day.
- *      All the times embedded within the state vectors must be exactly equal to `time`,
- *      or this function will fail with the error `ASTRO_INCONSISTENT_TIMES`.
+ * @param x, y, z
+ *      Arrays of `numBodies` initial positions in AU, relative to `originBody`, in EQJ coordinates.
+ *
+ * @param vx, vy, vz
+ *      Arrays of `numBodies` initial velocities in AU/day.
  *
  * @return
- *      `ASTRO_SUCCESS` on success, with `*sim` set to a non-NULL value. Otherwise an error code with `*sim` set to NULL.
+ *      `ASTRO_SUCCESS` on success, with `*batchOut` set to a non-NULL value.
+ *      Otherwise an error code with `*batchOut` set to NULL.
  */
-astro_status_t Astronomy_GravSimInit(
-    astro_grav_sim_t **simOut,
+astro_status_t Astronomy_GravBatchInit(
+    astro_grav_batch_t **batchOut,
     astro_body_t originBody,
     astro_time_t time,
     int numBodies,
-    const astro_state_vector_t *bodyStateArray)
+    const double *x, const double *y, const double *z,
+    const double *vx, const double *vy, const double *vz)
 {
-    astro_grav_sim_t *sim;
+    astro_grav_batch_t *batch;
+    astro_state_vector_t originState;
+    grav_batch_endpoint_t *end;
     astro_status_t status;
-    body_grav_calc_t *array;
-    int i;
+    int i, first, count;
 
-    /* Validate parameters before attempting to allocate memory. */
-
-    if (simOut == NULL)
+    if (batchOut == NULL)
         return ASTRO_INVALID_PARAMETER;
 
-    *simOut = NULL;
+    *batchOut = NULL;
 
     if (numBodies < 0)
         return ASTRO_INVALID_PARAMETER;
 
-    if (numBodies > 0 && bodyStateArray == NULL)
+    if (numBodies > 0 && (x == NULL || y == NULL || z == NULL || vx == NULL || vy == NULL || vz == NULL))
         return ASTRO_INVALID_PARAMETER;
 
     if (originBody < BODY_MERCURY || originBody > BODY_SSB)
         return ASTRO_INVALID_BODY;
 
-    /* Verify that all the state vectors are valid and have matching times. */
-    for (i = 0; i < numBodies; ++i)
-    {
-        if (bodyStateArray[i].status != ASTRO_SUCCESS)
-            return ASTRO_INVALID_PARAMETER;
-
-        if (bodyStateArray[i].t.tt != time.tt)
-            return ASTRO_INCONSISTENT_TIMES;
-    }
-
-    *simOut = sim = (astro_grav_sim_t *) calloc(1, sizeof(astro_grav_sim_t));
-    if (sim == NULL)
+    batch = GravBatchAlloc(originBody, numBodies);
+    if (batch == NULL)
         return ASTRO_OUT_OF_MEMORY;
 
-    sim->originBody = originBody;
-    sim->numBodies = numBodies;
-    sim->prev = &(sim->endpoint[0]);
-    sim->curr = &(sim->endpoint[1]);
-    sim->curr->time = time;
+    batch->curr->time = time;
 
-    if (numBodies > 0)
-    {
-        sim->prev->bodies = (body_grav_calc_t *) calloc(numBodies, sizeof(body_grav_calc_t));
-        sim->curr->bodies = (body_grav_calc_t *) calloc(numBodies, sizeof(body_grav_calc_t));
-        if (sim->prev->bodies == NULL || sim->curr->bodies == NULL)
-        {
-            status = ASTRO_OUT_OF_MEMORY;
-            goto fail;
-        }
-    }
+    /* Calculate the state of the Sun and planets. */
+    end = batch->curr;
+    CalcGravitators(end->gravitators, time.tt);
 
-    /* Remember the initial states of all the bodies as "current". */
-    /* Convert from the public type astro_state_t to our internal type body_grav_calc_t. */
-    array = sim->curr->bodies;
-    for (i = 0; i < numBodies; ++i)
+    /* Correct the input body state vectors for the specified coordinate origin. */
+    originState = GravOriginState(end->gravitators, originBody, time);
+    if (originState.status != ASTRO_SUCCESS)
     {
-        array[i].tt  = bodyStateArray[i].t.tt;
-        array[i].r.x = bodyStateArray[i].x;
-        array[i].r.y = bodyStateArray[i].y;
-        array[i].r.z = bodyStateArray[i].z;
-        array[i].v.x = bodyStateArray[i].vx;
-        array[i].v.y = bodyStateArray[i].vy;
-        array[i].v.z = bodyStateArray[i].vz;
+        status = originState.status;
+        goto fail;
     }
 
-    /* Calculate the state of the Sun and planets. */
-    CalcSolarSystem(sim);
-
-    /*
-        We need to do all the physics calculations in barycentric coordinates.
-        But the caller can provide the input vectors with respect to any body.
-        Correct the input body state vectors for the specified coordinate origin.
-    */
-    if (originBody != BODY_SSB)
+    for (i = 0; i < numBodies; ++i)
     {
-        /* Determine the barycentric state of the origin body. */
-        astro_state_vector_t originState = GravSimOriginState(sim);
-        if (originState.status != ASTRO_SUCCESS)
-        {
-            status = originState.status;
-            goto fail;
-        }
-
-        /* Add barycentric origin to origin-centric body to obtain barycentric body. */
-        for (i = 0; i < numBodies; ++i)
+        end->rx[i] = x[i];
+        end->ry[i] = y[i];
+        end->rz[i] = z[i];
+        end->vx[i] = vx[i];
+        end->vy[i] = vy[i];
+        end->vz[i] = vz[i];
+        if (originBody != BODY_SSB)
         {
-            array[i].r.x += originState.x;
-            array[i].r.y += originState.y;
-            array[i].r.z += originState.z;
-            array[i].v.x += originState.vx;
-            array[i].v.y += originState.vy;
-            array[i].v.z += originState.vz;
+            end->rx[i] += originState.x;
+            end->ry[i] += originState.y;
+            end->rz[i] += originState.z;
+            end->vx[i] += originState.vx;
+            end->vy[i] += originState.vy;
+            end->vz[i] += originState.vz;
         }
     }
 
     /* Calculate the net acceleration experienced by the small bodies. */
-    CalcBodyAccelerations(sim);
+    for (first = 0; first < numBodies; first += GRAV_BATCH_BLOCK)
+    {
+        count = numBodies - first;
+        if (count > GRAV_BATCH_BLOCK)
+            count = GRAV_BATCH_BLOCK;
+        GravBatchAccelerations(end, first, count);
+    }
 
-    /* To prepare for a possible swap operation, duplicate the current state into the previous state. */
-    GravSimDuplicate(sim);
+    /* Duplicate the current state into the previous state, as Astronomy_GravSimInit does. */
+    GravBatchDuplicate(batch);
 
+    *batchOut = batch;
     return ASTRO_SUCCESS;
 
 fail:
-    Astronomy_GravSimFree(sim);
-    *simOut = NULL;
+    Astronomy_GravBatchFree(batch);
     return status;
 }
 
 
 /**
- * @brief Advances a gravity simulation by a small time step.
+ * @brief Starts a step of a structure-of-arrays gravity simulation.
  *
- * @param sim
- *      A simulation object that was created by a prior call to #Astronomy_GravSimInit.
+ * Moves the simulation to `time` and calculates the positions of the Sun and planets there,
+ * but does not yet move the small bodies. Each small body must then be moved exactly once
+ * by a call to #Astronomy_GravBatchAdvance before the step is complete.
+ * The calls may be made from different threads for disjoint ranges of bodies.
  *
- * @param time
- *      A time that is a small increment away from the current simulation time.
- *      It is up to the developer to figure out an appropriate time increment.
- *      Depending on the trajectories, a smaller or larger increment
- *      may be needed for the desired accuracy. Some experimentation may be needed.
- *      Generally, bodies that stay in the outer Solar System and move slowly can
- *      use larger time steps.  Bodies that pass into the inner Solar System and
- *      move faster will need a smaller time step to maintain accuracy.
- *      The `time` value may be after or before the current simulation time
- *      to move forward or backward in time.
+ * Most callers will want #Astronomy_GravBatchUpdate instead, which does both.
  *
- * @param numBodies
- *      The number of bodies whose state vectors are to be updated.
- *      This is the number of elements in the `bodyStateArray`.
- *      This parameter is passed as a sanity check, and must be equal
- *      to the value passed to #Astronomy_GravSimInit when `sim` was created.
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
  *
- * @param bodyStateArray
- *      An array big enough to hold `numBodies` state vectors, to receive
- *      the updated positions and velocities of the simulated small bodies.
- *      Alternatively, `bodyStateArray` may be NULL if the output of this
- *      simulation step is not needed. This makes the call slightly faster.
+ * @param time
+ *      A time that is a small increment away from the current simulation time;
+ *      see #Astronomy_GravSimUpdate.
  *
  * @return
- *      `ASTRO_SUCCESS` if the calculation was successful.
- *      Otherwise, an error code if something went wrong, in which case
- *      the simulation should be considered "broken". This means there
- *      is no reliable output in `bodyStateArray` and that no more calculations
- *      can be performed with `sim`.
+ *      `ASTRO_SUCCESS`, or `ASTRO_INVALID_PARAMETER` if `batch` is NULL.
  */
-astro_status_t Astronomy_GravSimUpdate(
-    astro_grav_sim_t *sim,
-    astro_time_t time,
-    int numBodies,
-    astro_state_vector_t *bodyStateArray)
+astro_status_t Astronomy_GravBatchPrepare(astro_grav_batch_t *batch, astro_time_t time)
 {
-    terse_vector_t acc;
-    double dt;      /* terrestrial time increment */
-    int i;
+    grav_batch_endpoint_t *swap;
 
-    /*
-        The caller's understanding of the number of bodies must match the actual
-        array size in `sim`, or we risk corrupting/accessing invalid memory.
-    */
-    if (numBodies != sim->numBodies)
+    if (batch == NULL)
         return ASTRO_INVALID_PARAMETER;
 
-    dt = time.tt - sim->curr->time.tt;
-
-    if (dt == 0.0)
+    if (time.tt == batch->curr->time.tt)
     {
-        /*
-            Special case: the time has not changed, so skip the usual physics calculations.
-            This allows a way for the caller to query the current state if desired.
-            It is also necessary to avoid dividing by `dt` if `dt` is zero.
-            To prepare for a possible swap operation, duplicate the current state into the previous state.
-        */
-        GravSimDuplicate(sim);
+        /* The time has not changed: keep the current state, and make the step a no-op. */
+        GravBatchDuplicate(batch);
+        return ASTRO_SUCCESS;
     }
-    else
+
+    swap = batch->prev;
+    batch->prev = batch->curr;
+    batch->curr = swap;
+
+    batch->curr->time = time;
+    CalcGravitators(batch->curr->gravitators, time.tt);
+    return ASTRO_SUCCESS;
+}
+
+
+/**
+ * @brief Moves some of the small bodies across a step started by #Astronomy_GravBatchPrepare.
+ *
+ * Calls for disjoint ranges of bodies do not share any writable memory,
+ * so they may run concurrently on different threads.
+ *
+ * The integrator predicts each position from the acceleration at the start of
+ * the step, then corrects it with the mean of the accelerations at both ends.
+ * The distance between the predicted and corrected positions estimates the
+ * local error of the step, which #Astronomy_GravBatchUpdateAdaptive uses to
+ * choose step sizes.
+ *
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
+ *
+ * @param first
+ *      The index of the first small body to move.
+ *
+ * @param count
+ *      The number of small bodies to move.
+ *
+ * @param maxError
+ *      If not NULL, receives the largest estimated position error of the step
+ *      among these bodies, in AU.
+ *
+ * @return
+ *      `ASTRO_SUCCESS`, or `ASTRO_INVALID_PARAMETER` if the range of bodies is not valid.
+ */
+astro_status_t Astronomy_GravBatchAdvance(astro_grav_batch_t *batch, int first, int count, double *maxError)
+{
+    const grav_batch_endpoint_t *prev;
+    grav_batch_endpoint_t *curr;
+    double dt, acc_x, acc_y, acc_z, rx, ry, rz, err2, max2;
+    int i, n, last;
+
+    if (batch == NULL || first < 0 || count < 0 || count > batch->numBodies - first)
+        return ASTRO_INVALID_PARAMETER;
+
+    max2 = 0.0;
+    prev = batch->prev;
+    curr = batch->curr;
+    dt = curr->time.tt - prev->time.tt;
+    if (dt == 0.0)
+        count = 0;
+
+    for (last = first + count; first < last; first += n)
     {
-        /* Swap the current state and the previous state. Then calculate the new current state. */
-        Astronomy_GravSimSwap(sim);
+        n = last - first;
+        if (n > GRAV_BATCH_BLOCK)
+            n = GRAV_BATCH_BLOCK;
 
-        /* Update the current time. This is the only place we have a full (tt,ut) pair. */
-        /* All of the Newtonian dynamics are calculated using tt only. */
-        sim->curr->time = time;
+        /* Estimate the positions as if the current accelerations apply across the whole interval. */
+        for (i = first; i < first + n; ++i)
+        {
+            curr->rx[i] = prev->rx[i] + (prev->vx[i] + prev->ax[i]*dt/2) * dt;
+            curr->ry[i] = prev->ry[i] + (prev->vy[i] + prev->ay[i]*dt/2) * dt;
+            curr->rz[i] = prev->rz[i] + (prev->vz[i] + prev->az[i]*dt/2) * dt;
+        }
 
-        /* Now that sim->time is set, it is safe to call `CalcSolarSystem`. */
-        CalcSolarSystem(sim);
+        GravBatchAccelerations(curr, first, n);
 
-        for (i = 0; i < numBodies; ++i)
+        /* Refine the positions and velocities using the mean acceleration over the interval. */
+        for (i = first; i < first + n; ++i)
         {
-            /*
-                Estimate the positions of the small bodies as if their
-                current accelerations apply across the whole time interval.
-                approx_pos = pos1 + vel1*dt + (1/2)acc*dt^2
-            */
-            const body_grav_calc_t *prev = &sim->prev->bodies[i];
-            sim->curr->bodies[i].r = UpdatePosition(dt, prev->r, prev->v, prev->a);
+            acc_x = (prev->ax[i] + curr->ax[i]) / 2;
+            acc_y = (prev->ay[i] + curr->ay[i]) / 2;
+            acc_z = (prev->az[i] + curr->az[i]) / 2;
+            rx = prev->rx[i] + (prev->vx[i] + acc_x*dt/2) * dt;
+            ry = prev->ry[i] + (prev->vy[i] + acc_y*dt/2) * dt;
+            rz = prev->rz[i] + (prev->vz[i] + acc_z*dt/2) * dt;
+            err2 = (rx - curr->rx[i])*(rx - curr->rx[i]) + (ry - curr->ry[i])*(ry - curr->ry[i]) + (rz - curr->rz[i])*(rz - curr->rz[i]);
+            if (!(err2 <= max2))
+                max2 = err2;    /* also lets a NAN through, so a broken step is never accepted */
+            curr->rx[i] = rx;
+            curr->ry[i] = ry;
+            curr->rz[i] = rz;
+            curr->vx[i] = prev->vx[i] + dt * acc_x;
+            curr->vy[i] = prev->vy[i] + dt * acc_y;
+            curr->vz[i] = prev->vz[i] + dt * acc_z;
         }
 
-        /*
-            Calculate the acceleration experienced by the small bodies
-            at their respective approximate next locations.
-        */
-        CalcBodyAccelerations(sim);
+        /* Re-calculate the accelerations for the next step. */
+        GravBatchAccelerations(curr, first, n);
+    }
+
+    if (maxError != NULL)
+        *maxError = sqrt(max2);
+
+    return ASTRO_SUCCESS;
+}
+
+
+/**
+ * @brief Advances a structure-of-arrays gravity simulation by a small time step.
+ *
+ * This is #Astronomy_GravBatchPrepare followed by #Astronomy_GravBatchAdvance for all
+ * the small bodies. Use #Astronomy_GravBatchState to read the updated states.
+ *
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
+ *
+ * @param time
+ *      A time that is a small increment away from the current simulation time;
+ *      see #Astronomy_GravSimUpdate.
+ *
+ * @return
+ *      `ASTRO_SUCCESS`, or an error code if `batch` is NULL.
+ */
+astro_status_t Astronomy_GravBatchUpdate(astro_grav_batch_t *batch, astro_time_t time)
+{
+    astro_status_t status;
+
+    status = Astronomy_GravBatchPrepare(batch, time);
+    if (status != ASTRO_SUCCESS)
+        return status;
+
+    return Astronomy_GravBatchAdvance(batch, 0, batch->numBodies, NULL);
+}
+
+
+/** @cond DOXYGEN_SKIP */
+#define GRAV_STEP_FIRST_DAYS    1.0     /* first adaptive step tried by a new simulation */
+#define GRAV_STEP_MIN_DAYS      1.0e-6  /* smallest adaptive step, about 0.1 seconds */
+#define GRAV_STEP_SAFETY        0.9     /* aim a little below the tolerance */
+#define GRAV_STEP_SHRINK_LIMIT  0.2     /* largest reduction of the step after a rejected step */
+#define GRAV_STEP_GROW_LIMIT    4.0     /* largest increase of the step after an accepted step */
+/** @endcond */
+
+/* The step to try next, given the error of a step of `stepDays`. The local error grows as the cube of the step. */
+static double GravStepScale(double stepDays, double error, double tolerance)
+{
+    double factor;
+
+    if (!(error > 0.0))
+        factor = (error == 0.0) ? GRAV_STEP_GROW_LIMIT : GRAV_STEP_SHRINK_LIMIT;
+    else
+        factor = GRAV_STEP_SAFETY * cbrt(tolerance / error);
+
+    if (factor < GRAV_STEP_SHRINK_LIMIT)
+        factor = GRAV_STEP_SHRINK_LIMIT;
+    else if (factor > GRAV_STEP_GROW_LIMIT)
+        factor = GRAV_STEP_GROW_LIMIT;
+
+    return stepDays * factor;
+}
 
-        for (i = 0; i < numBodies; ++i)
-        {
-            const body_grav_calc_t *prev = &sim->prev->bodies[i];
-            body_grav_calc_t *curr = &sim->curr->bodies[i];
 
-            /*
-                Calculate the average of the acceleration vectors
-                experienced by the previous body positions and
-                their estimated next positions.
-                These become estimates of the mean effective accelerations over the whole interval.
-            */
-            acc = VecMean(prev->a, curr->a);
+/**
+ * @brief Advances a structure-of-arrays gravity simulation to a time, choosing its own step sizes.
+ *
+ * Instead of taking one step to `time`, as #Astronomy_GravBatchUpdate does,
+ * this function takes as many steps as needed to keep the estimated local
+ * position error of every small body within `tolerance` on each step
+ * (see #Astronomy_GravBatchAdvance). A step whose error is too large is undone
+ * and retried with a smaller step. After each accepted step, the next step is
+ * scaled by the cube root of the ratio of the tolerance to the error, so quiet
+ * stretches of the orbits are crossed quickly while close approaches to the
+ * planets are resolved with short steps. The last step size is remembered,
+ * so a series of calls for closely spaced output times carries on where
+ * the previous call left off.
+ *
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
+ *
+ * @param time
+ *      The time to advance to, before or after the current simulation time.
+ *
+ * @param tolerance
+ *      The largest position error to allow per step, in AU.
+ *
+ * @param advance
+ *      A function that moves all the small bodies across a step started by
+ *      #Astronomy_GravBatchPrepare and reports their largest error, for example
+ *      by calling #Astronomy_GravBatchAdvance from several threads.
+ *      If NULL, the bodies are moved on the calling thread.
+ *
+ * @param context
+ *      Passed unchanged to `advance`.
+ *
+ * @param numSteps
+ *      If not NULL, receives the number of steps accepted.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if the simulation reached `time`.
+ *      `ASTRO_INVALID_PARAMETER` if `tolerance` is not positive.
+ *      `ASTRO_NO_CONVERGE` if the error could not be brought within `tolerance`
+ *      even with the smallest step; the simulation is then left at the last accepted step.
+ *      Any error returned by `advance` is passed on, and the simulation should no longer be used.
+ */
+astro_status_t Astronomy_GravBatchUpdateAdaptive(
+    astro_grav_batch_t *batch,
+    astro_time_t time,
+    double tolerance,
+    astro_grav_advance_func_t advance,
+    void *context,
+    int *numSteps)
+{
+    astro_status_t status;
+    grav_batch_endpoint_t *swap;
+    double remaining, step, error;
+    int final, accepted;
 
-            /*
-                Refine the estimates of position and velocity at the next time step,
-                using the mean acceleration as a better approximation of the
-                continuously changing acceleration acting on each body.
-            */
-            curr->tt = time.tt;
-            curr->r = UpdatePosition(dt, prev->r, prev->v, acc);
-            curr->v = UpdateVelocity(dt, prev->v, acc);
-        }
+    if (numSteps != NULL)
+        *numSteps = 0;
 
-        /*
-            Re-calculate accelerations experienced by each body.
-            These will be needed for the next simulation step (if any).
-            Also, they will be potentially useful if some day we add
-            a function to query the acceleration vectors for the bodies.
-        */
-        CalcBodyAccelerations(sim);
-    }
+    if (batch == NULL || !(tolerance > 0.0) || !isfinite(time.tt))
+        return ASTRO_INVALID_PARAMETER;
 
-    /*
-        Translate our internal calculations of body positions
-        and velocities into state vectors that the caller can understand.
-        But if the output buffer `bodyStateArray` is NULL, it means
-        the caller wanted us to update the simulation state without
-        returning any output.
-    */
-    if (bodyStateArray != NULL)
+    step = (batch->stepDays > 0.0) ? batch->stepDays : GRAV_STEP_FIRST_DAYS;
+    accepted = 0;
+    while ((remaining = time.tt - batch->curr->time.tt) != 0.0)
     {
-        for (i = 0; i < numBodies; ++i)
-            bodyStateArray[i] = ExportGravCalc(sim->curr->bodies[i], time);
+        final = (step >= fabs(remaining));
+        if (final)
+            status = Astronomy_GravBatchPrepare(batch, time);
+        else
+            status = Astronomy_GravBatchPrepare(batch, Astronomy_TerrestrialTime(batch->curr->time.tt + (remaining > 0.0 ? step : -step)));
+        if (status != ASTRO_SUCCESS)
+            return status;
 
-        if (sim->originBody != BODY_SSB)
+        if (advance != NULL)
+            status = advance(context, batch, &error);
+        else
+            status = Astronomy_GravBatchAdvance(batch, 0, batch->numBodies, &error);
+        if (status != ASTRO_SUCCESS)
+            return status;
+
+        if (error <= tolerance)
         {
-            /* Determine the barycentric state of the origin body. */
-            astro_state_vector_t originState = GravSimOriginState(sim);
-            if (originState.status != ASTRO_SUCCESS)
-                return originState.status;
+            ++accepted;
+            if (numSteps != NULL)
+                *numSteps = accepted;
 
-            /* Subtract vectors to convert barycentric states to origin-centric states. */
-            for (i = 0; i < numBodies; ++i)
+            /* A final step shortened to land on `time` says little about the next step, so only let it grow the step. */
+            if (final)
             {
-                bodyStateArray[i].x  -= originState.x;
-                bodyStateArray[i].y  -= originState.y;
-                bodyStateArray[i].z  -= originState.z;
-                bodyStateArray[i].vx -= originState.vx;
-                bodyStateArray[i].vy -= originState.vy;
-                bodyStateArray[i].vz -= originState.vz;
+                double next = GravStepScale(fabs(remaining), error, tolerance);
+                if (next > step)
+                    step = next;
+            }
+            else
+            {
+                step = GravStepScale(step, error, tolerance);
+            }
+        }
+        else
+        {
+            /* Undo the step: the previous endpoint still holds the state before it. */
+            swap = batch->prev;
+            batch->prev = batch->curr;
+            batch->curr = swap;
+
+            if (step <= GRAV_STEP_MIN_DAYS)
+            {
+                batch->stepDays = step;
+                return ASTRO_NO_CONVERGE;
             }
+
+            step = GravStepScale(final ? fabs(remaining) : step, error, tolerance);
+            if (step < GRAV_STEP_MIN_DAYS)
+                step = GRAV_STEP_MIN_DAYS;
         }
     }
 
+    batch->stepDays = step;
     return ASTRO_SUCCESS;
 }
 
 
 /**
- * @brief Get the position and velocity of a Solar System body included in the simulation.
+ * @brief Reads the current states of some of the small bodies in a structure-of-arrays simulation.
  *
- * In order to simulate the movement of small bodies through the Solar System,
- * the simulator needs to calculate the state vectors for the Sun and planets.
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
  *
- * If an application wants to know the positions of one or more of the planets
- * in addition to the small bodies, this function provides a way to obtain
- * their state vectors. This is provided for the sake of efficiency, to avoid
- * redundant calculations.
+ * @param first
+ *      The index of the first small body to read.
  *
- * @param sim
- *      A gravity simulator object created by a successful call to #Astronomy_GravSimInit.
+ * @param count
+ *      The number of small bodies to read.
  *
- * @param body
- *      The Sun, Mercury, Venus, Earth, Mars, Jupiter, Saturn, Uranus, or Neptune.
+ * @param x, y, z
+ *      Arrays of `count` elements to receive the positions in AU,
+ *      relative to the origin body passed to #Astronomy_GravBatchInit.
+ *
+ * @param vx, vy, vz
+ *      Arrays of `count` elements to receive the velocities in AU/day.
  *
  * @return
- *      If the given body is part of the set of calculated bodies
- *      (Sun and planets), returns the current time step's state
- *      vector for that body, expressed in the coordinate system
- *      that was specified by the `originBody` parameter to #Astronomy_GravSimInit.
- *      Success is indicated by the returned structure's `status` field holding
- *      `ASTRO_SUCCESS`. Any other `status` value indicates an error, meaning
- *      the returned state vector is invalid.
+ *      `ASTRO_SUCCESS`, or `ASTRO_INVALID_PARAMETER` if the range of bodies is not valid.
  */
-astro_state_vector_t Astronomy_GravSimBodyState(
-    astro_grav_sim_t *sim,
-    astro_body_t body)
-{
-    astro_state_vector_t state;
-    body_state_t *bptr;
-
-    bptr = GravSimBodyStatePtr(sim, body);
-    if (bptr == NULL)
-        return StateVecError(ASTRO_INVALID_BODY, sim->curr->time);
+astro_status_t Astronomy_GravBatchState(
+    const astro_grav_batch_t *batch,
+    int first,
+    int count,
+    double *x, double *y, double *z,
+    double *vx, double *vy, double *vz)
+{
+    const grav_batch_endpoint_t *curr;
+    astro_state_vector_t originState;
+    int i;
 
-    state = GravSimOriginState(sim);
-    if (state.status != ASTRO_SUCCESS)
-        return state;
+    if (batch == NULL || first < 0 || count < 0 || count > batch->numBodies - first)
+        return ASTRO_INVALID_PARAMETER;
 
-    /*
-        Subtract the origin's state from the body's barycentric
-        state to get the body in the desired reference frame.
-        state.t and state.status are already initialized correctly.
-    */
+    curr = batch->curr;
+    originState = GravOriginState(curr->gravitators, batch->originBody, curr->time);
+    if (originState.status != ASTRO_SUCCESS)
+        return originState.status;
 
-    state.x  = bptr->r.x - state.x;
-    state.y  = bptr->r.y - state.y;
-    state.z  = bptr->r.z - state.z;
-    state.vx = bptr->v.x - state.vx;
-    state.vy = bptr->v.y - state.vy;
-    state.vz = bptr->v.z - state.vz;
+    for (i = 0; i < count; ++i)
+    {
+        x[i]  = curr->rx[first + i];
+        y[i]  = curr->ry[first + i];
+        z[i]  = curr->rz[first + i];
+        vx[i] = curr->vx[first + i];
+        vy[i] = curr->vy[first + i];
+        vz[i] = curr->vz[first + i];
+        if (batch->originBody != BODY_SSB)
+        {
+            /* Subtract vectors to convert barycentric states to origin-centric states. */
+            x[i]  -= originState.x;
+            y[i]  -= originState.y;
+            z[i]  -= originState.z;
+            vx[i] -= originState.vx;
+            vy[i] -= originState.vy;
+            vz[i] -= originState.vz;
+        }
+    }
 
-    return state;
+    return ASTRO_SUCCESS;
 }
 
 
 /**
- * @brief Exchange the current time step with the previous time step.
- *
- * Sometimes it is helpful to "explore" various times near a given
- * simulation time step, while repeatedly returning to the original
- * time step. For example, when backdating a position for light travel
- * time, the caller may wish to repeatedly try different amounts of
- * backdating. When the backdating solver has converged, the caller
- * wants to leave the simulation in its original state.
- *
- * This function allows a single "undo" of a simulation, and does so
- * very efficiently.
- *
- * Usually this function will be called immediately after a matching
- * call to #Astronomy_GravSimUpdate. It has the effect of rolling
- * back the most recent update. If called twice in a row, it reverts
- * the swap and thus has no net effect.
- *
- * #Astronomy_GravSimInit initializes the current state and previous
- * state to be identical. Both states represent the `time` parameter that was
- * passed into the initializer. Therefore, `Astronomy_GravSimSwap` will
- * have no effect from the caller's point of view when passed a simulator
- * that has not yet been updated by a call to #Astronomy_GravSimUpdate.
+ * @brief Returns the time of the current step of a structure-of-arrays simulation.
  *
- * @param sim
- *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
  */
-void Astronomy_GravSimSwap(astro_grav_sim_t *sim)
+astro_time_t Astronomy_GravBatchTime(const astro_grav_batch_t *batch)
 {
-    gravsim_endpoint_t *swap = sim->prev;
-    sim->prev = sim->curr;
-    sim->curr = swap;
+    return batch->curr->time;
 }
 
 
 /**
- * @brief Returns the time of the current simulation step.
+ * @brief Returns the number of small bodies in a structure-of-arrays simulation.
  *
- * @param sim
- *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
  */
-astro_time_t Astronomy_GravSimTime(const astro_grav_sim_t *sim)
+int Astronomy_GravBatchNumBodies(const astro_grav_batch_t *batch)
 {
-    return sim->curr->time;
+    return batch->numBodies;
 }
 
 
 /**
- * @brief Returns the number of small bodies represented in this simulation.
+ * @brief Returns the coordinate origin of a structure-of-arrays simulation.
  *
- * When a simulation is created by a call to #Astronomy_GravSimInit,
- * the caller specifies the number of small bodies.
- * This function returns that same number, which may be convenient for a caller,
- * so that it does not need to track the body count separately.
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit.
+ */
+astro_body_t Astronomy_GravBatchOrigin(const astro_grav_batch_t *batch)
+{
+    return batch->originBody;
+}
+
+
+/**
+ * @brief Releases memory allocated to a structure-of-arrays gravity simulator.
  *
- * @param sim
- *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit, or NULL.
  */
-int Astronomy_GravSimNumBodies(const astro_grav_sim_t *sim)
+void Astronomy_GravBatchFree(astro_grav_batch_t *batch)
 {
-    return sim->numBodies;
+    if (batch != NULL)
+    {
+        free(batch->endpoint[0].rx);
+        free(batch->endpoint[1].rx);
+        free(batch);
+    }
+}
+
+
+/*
+    Layout of a snapshot file written by Astronomy_GravBatchSave.
+    All values use the byte order of the machine that wrote the file.
+    The header is followed by the NUM_GRAVITATORS body_state_t records of
+    the Sun and planets, and then by the nine arrays of `num_bodies` doubles
+    (rx, ry, rz, vx, vy, vz, ax, ay, az) of the current simulation step.
+*/
+#define GRAV_FILE_MAGIC         "ASTGRAV"       /* 7 characters plus the terminating NUL */
+#define GRAV_FILE_VERSION       1
+#define NUM_GRAVITATORS         (1 + BODY_SUN)
+
+typedef struct
+{
+    char        magic[8];       /* GRAV_FILE_MAGIC */
+    uint32_t    version;        /* GRAV_FILE_VERSION */
+    uint32_t    byte_order;     /* EPHEM_FILE_BYTE_ORDER as stored by the writer */
+    uint32_t    double_bytes;   /* sizeof(double) */
+    int32_t     origin;         /* astro_body_t value of the origin body */
+    int32_t     num_bodies;     /* number of small bodies */
+    uint32_t    num_grav;       /* NUM_GRAVITATORS */
+    double      tt;             /* time of the current step, TT */
+    double      ut;             /* time of the current step, UT */
+    double      step_days;      /* adaptive step size hint */
+    uint64_t    file_bytes;     /* total size of the file, to detect truncation */
+    uint64_t    reserved[2];
 }
+grav_file_header_t;
 
 
 /**
- * @brief Returns the body whose center is the coordinate origin that small bodies are referenced to.
+ * @brief Saves the state of a structure-of-arrays gravity simulation to a file.
  *
- * When a simulation is created by a call to #Astronomy_GravSimInit,
- * the caller specifies an `originBody` to indicate the coordinate origin
- * used to represent the small bodies being simulated.
- * This function returns that same #astro_body_t value.
+ * Writes a compact binary snapshot of the current simulation step: the time,
+ * the origin body, the states of the Sun and planets, and the positions,
+ * velocities and accelerations of all the small bodies, together with the
+ * step size chosen by #Astronomy_GravBatchUpdateAdaptive.
+ * #Astronomy_GravBatchLoad restores a simulation from the file that continues
+ * exactly as the saved one would have.
  *
- * @param sim
- *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ * The file uses the byte order of the machine that wrote it, and can only
+ * be loaded on machines with the same byte order.
+ *
+ * @param batch
+ *      A simulation object created by #Astronomy_GravBatchInit or #Astronomy_GravBatchLoad.
+ *
+ * @param filename
+ *      The name of the file to create or overwrite.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if the file was written, otherwise `ASTRO_INVALID_PARAMETER`.
  */
-astro_body_t Astronomy_GravSimOrigin(const astro_grav_sim_t *sim)
+astro_status_t Astronomy_GravBatchSave(const astro_grav_batch_t *batch, const char *filename)
 {
-    return sim->originBody;
+    const grav_batch_endpoint_t *end;
+    grav_file_header_t header;
+    size_t count;
+    FILE *outfile;
+    int ok;
+
+    if (batch == NULL || filename == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    end = batch->curr;
+    count = 9 * (size_t)batch->numBodies;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAV_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAV_FILE_VERSION;
+    header.byte_order = EPHEM_FILE_BYTE_ORDER;
+    header.double_bytes = sizeof(double);
+    header.origin = (int32_t) batch->originBody;
+    header.num_bodies = batch->numBodies;
+    header.num_grav = NUM_GRAVITATORS;
+    header.tt = end->time.tt;
+    header.ut = end->time.ut;
+    header.step_days = batch->stepDays;
+    header.file_bytes = sizeof(header) + sizeof(end->gravitators) + count * sizeof(double);
+
+    outfile = fopen(filename, "wb");
+    if (outfile == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    ok = (fwrite(&header, sizeof(header), 1, outfile) == 1);
+    ok = ok && (fwrite(end->gravitators, sizeof(end->gravitators), 1, outfile) == 1);
+    ok = ok && (count == 0 || fwrite(end->rx, sizeof(double), count, outfile) == count);
+
+    if (fclose(outfile) != 0)
+        ok = 0;
+
+    if (!ok)
+    {
+        remove(filename);
+        return ASTRO_INVALID_PARAMETER;
+    }
+
+    return ASTRO_SUCCESS;
 }
 
 
 /**
- * @brief Releases memory allocated to a gravity simulator object.
+ * @brief Restores a structure-of-arrays gravity simulation from a file.
  *
- * To avoid memory leaks, any successful call to #Astronomy_GravSimInit
- * must be paired with a matching call to `Astronomy_GravSimFree`.
+ * Reads a snapshot written by #Astronomy_GravBatchSave and creates a new
+ * simulation object at the saved step. Stepping the new object gives exactly
+ * the same results as stepping the one that was saved.
  *
- * @param sim
- *      A gravity simulator object that was created by a prior call to #Astronomy_GravSimInit.
+ * If this function succeeds, the caller must eventually call
+ * #Astronomy_GravBatchFree to release the memory.
+ *
+ * @param batchOut
+ *      The address of a pointer to store the newly allocated simulation object.
+ *
+ * @param filename
+ *      The name of the snapshot file.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` on success, with `*batchOut` set to a non-NULL value.
+ *      `ASTRO_INVALID_PARAMETER` if the file could not be read, is not a snapshot
+ *      written by a compatible machine, or is truncated.
+ *      `ASTRO_OUT_OF_MEMORY` if the simulation could not be allocated.
  */
-void Astronomy_GravSimFree(astro_grav_sim_t *sim)
+astro_status_t Astronomy_GravBatchLoad(astro_grav_batch_t **batchOut, const char *filename)
 {
-    if (sim != NULL)
+    astro_grav_batch_t *batch;
+    grav_batch_endpoint_t *end;
+    grav_file_header_t header;
+    astro_status_t status;
+    size_t count;
+    FILE *infile;
+
+    if (batchOut == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    *batchOut = NULL;
+
+    if (filename == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    infile = fopen(filename, "rb");
+    if (infile == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    batch = NULL;
+    status = ASTRO_INVALID_PARAMETER;
+    if (fread(&header, sizeof(header), 1, infile) != 1)
+        goto fail;
+
+    if (memcmp(header.magic, GRAV_FILE_MAGIC, sizeof(header.magic)) != 0)
+        goto fail;
+
+    if (header.version != GRAV_FILE_VERSION || header.byte_order != EPHEM_FILE_BYTE_ORDER || header.double_bytes != sizeof(double))
+        goto fail;
+
+    if (header.origin < BODY_MERCURY || header.origin > BODY_SSB || header.num_bodies < 0 || header.num_grav != NUM_GRAVITATORS)
+        goto fail;
+
+    count = 9 * (size_t)header.num_bodies;
+    if (header.file_bytes != sizeof(header) + NUM_GRAVITATORS * sizeof(body_state_t) + count * sizeof(double))
+        goto fail;
+
+    if (!isfinite(header.tt) || !isfinite(header.ut) || !(header.step_days >= 0.0))
+        goto fail;
+
+    batch = GravBatchAlloc((astro_body_t) header.origin, header.num_bodies);
+    if (batch == NULL)
     {
-        free(sim->endpoint[0].bodies);
-        free(sim->endpoint[1].bodies);
-        free(sim);
+        status = ASTRO_OUT_OF_MEMORY;
+        goto fail;
     }
+
+    batch->stepDays = header.step_days;
+    end = batch->curr;
+    end->time.tt = header.tt;
+    end->time.ut = header.ut;
+    end->time.psi = end->time.eps = end->time.st = NAN;
+
+    if (fread(end->gravitators, sizeof(end->gravitators), 1, infile) != 1)
+        goto fail;
+
+    if (count > 0 && fread(end->rx, sizeof(double), count, infile) != count)
+        goto fail;
+
+    /* Anything beyond the expected size means the file is not what the header says it is. */
+    if (fgetc(infile) != EOF)
+        goto fail;
+
+    fclose(infile);
+    GravBatchDuplicate(batch);
+    *batchOut = batch;
+    return ASTRO_SUCCESS;
+
+fail:
+    fclose(infile);
+    Astronomy_GravBatchFree(batch);
+    return status;
 }
 
 
@@ -4561,9 +7131,12 @@ static const body_state_t PlutoStateTable[] =
 ,   {   730000.0, {  4.243252837090, -30.118201690825, -10.707441231349}, { 3.1725847067411e-03,  1.6098461202270e-04, -9.0672150593868e-04} }
 };
 
-/* FIXFIXFIX - Using a global is not thread-safe. Either add thread-locks or change API to accept a cache pointer. */
-static body_segment_t *pluto_cache[PLUTO_NUM_STATES-1];
-
+/*
+    Pluto segments are computed on first use and published atomically.
+    If two threads race to fill the same slot, the loser frees its copy
+    and uses the winner's.
+*/
+static void *pluto_cache[PLUTO_NUM_STATES-1];
 
 static int ClampIndex(double frac, int nsteps)
 {
@@ -4576,64 +7149,180 @@ static int ClampIndex(double frac, int nsteps)
 }
 
 
-static astro_status_t GetSegment(int *seg_index, body_segment_t *cache[], double tt)
+static void FillSegment(body_segment_t *seg, int seg_index)
 {
     int i;
     body_segment_t reverse;
-    body_segment_t *seg;
     major_bodies_t bary;
     double step_tt, ramp;
 
-    if (tt < PlutoStateTable[0].tt || tt > PlutoStateTable[PLUTO_NUM_STATES-1].tt)
+    /* Pick the pair of bracketing body states to fill the segment. */
+
+    /* Each endpoint is exact. */
+    seg->step[0] = GravFromState(&bary, &PlutoStateTable[seg_index]);
+    seg->step[PLUTO_NSTEPS-1] = GravFromState(&bary, &PlutoStateTable[seg_index + 1]);
+
+    /* Simulate forwards from the lower time bound. */
+    step_tt = seg->step[0].tt;
+    for (i=1; i < PLUTO_NSTEPS-1; ++i)
+        seg->step[i] = GravSim(&bary, step_tt += PLUTO_DT, &seg->step[i-1]);
+
+    /* Simulate backwards from the upper time bound. */
+    step_tt = seg->step[PLUTO_NSTEPS-1].tt;
+    reverse.step[PLUTO_NSTEPS-1] = seg->step[PLUTO_NSTEPS-1];
+    for (i=PLUTO_NSTEPS-2; i > 0; --i)
+        reverse.step[i] = GravSim(&bary, step_tt -= PLUTO_DT, &reverse.step[i+1]);
+
+    /* Fade-mix the two series so that there are no discontinuities. */
+    for (i=PLUTO_NSTEPS-2; i > 0; --i)
     {
-        /* We don't bother calculating a segment. Let the caller crawl backward/forward to this time. */
-        *seg_index = -1;
-        return ASTRO_SUCCESS;
+        ramp = (double)i / (PLUTO_NSTEPS-1);
+        seg->step[i].r = VecRamp(seg->step[i].r, reverse.step[i].r, ramp);
+        seg->step[i].v = VecRamp(seg->step[i].v, reverse.step[i].v, ramp);
+        seg->step[i].a = VecRamp(seg->step[i].a, reverse.step[i].a, ramp);
     }
+}
 
-    /* See if we have a segment that straddles the requested time. */
-    /* If so, return it. Otherwise, calculate it and return it. */
 
-    *seg_index = ClampIndex((tt - PlutoStateTable[0].tt) / PLUTO_TIME_STEP, PLUTO_NUM_STATES-1);
-    if (cache[*seg_index] == NULL)
+static astro_status_t LoadSegment(const body_segment_t **seg_out, void *cache[], int seg_index)
+{
+    body_segment_t *seg;
+
+    seg = (body_segment_t *) AtomicLoadPtr(&cache[seg_index]);
+    if (seg == NULL)
     {
-        /* Allocate memory for the segment (about 11K each). */
-        seg = cache[*seg_index] = (body_segment_t *) calloc(1, sizeof(body_segment_t));
+        /* Allocate memory for the segment (about 11K each) and calculate it before publishing. */
+        seg = (body_segment_t *) calloc(1, sizeof(body_segment_t));
         if (seg == NULL)
             return ASTRO_OUT_OF_MEMORY;
 
-        /* Calculate the segment. */
-        /* Pick the pair of bracketing body states to fill the segment. */
+        FillSegment(seg, seg_index);
+
+        if (!AtomicPublishPtr(&cache[seg_index], seg))
+        {
+            /* Another thread published this segment first. Use theirs. */
+            free(seg);
+            seg = (body_segment_t *) AtomicLoadPtr(&cache[seg_index]);
+        }
+    }
+
+    *seg_out = seg;
+    return ASTRO_SUCCESS;
+}
 
-        /* Each endpoint is exact. */
-        seg->step[0] = GravFromState(&bary, &PlutoStateTable[*seg_index]);
-        seg->step[PLUTO_NSTEPS-1] = GravFromState(&bary, &PlutoStateTable[*seg_index + 1]);
 
-        /* Simulate forwards from the lower time bound. */
-        step_tt = seg->step[0].tt;
-        for (i=1; i < PLUTO_NSTEPS-1; ++i)
-            seg->step[i] = GravSim(&bary, step_tt += PLUTO_DT, &seg->step[i-1]);
+static astro_status_t GetSegment(const body_segment_t **seg_out, void *cache[], double tt)
+{
+    if (tt < PlutoStateTable[0].tt || tt > PlutoStateTable[PLUTO_NUM_STATES-1].tt)
+    {
+        /* We don't bother calculating a segment. Let the caller crawl backward/forward to this time. */
+        *seg_out = NULL;
+        return ASTRO_SUCCESS;
+    }
+
+    /* Find the segment that straddles the requested time, calculating it if needed. */
+    return LoadSegment(seg_out, cache, ClampIndex((tt - PlutoStateTable[0].tt) / PLUTO_TIME_STEP, PLUTO_NUM_STATES-1));
+}
 
-        /* Simulate backwards from the upper time bound. */
-        step_tt = seg->step[PLUTO_NSTEPS-1].tt;
-        reverse.step[PLUTO_NSTEPS-1] = seg->step[PLUTO_NSTEPS-1];
-        for (i=PLUTO_NSTEPS-2; i > 0; --i)
-            reverse.step[i] = GravSim(&bary, step_tt -= PLUTO_DT, &reverse.step[i+1]);
 
-        /* Fade-mix the two series so that there are no discontinuities. */
-        for (i=PLUTO_NSTEPS-2; i > 0; --i)
-        {
-            ramp = (double)i / (PLUTO_NSTEPS-1);
-            seg->step[i].r = VecRamp(seg->step[i].r, reverse.step[i].r, ramp);
-            seg->step[i].v = VecRamp(seg->step[i].v, reverse.step[i].v, ramp);
-            seg->step[i].a = VecRamp(seg->step[i].a, reverse.step[i].a, ramp);
-        }
+/**
+ * @brief Precalculates the cached segments of Pluto's orbit over a range of times.
+ *
+ * Pluto's position is found by numerically integrating its orbit in segments
+ * of about 80 years each. Each segment is calculated the first time it is needed
+ * and then cached, which makes the first Pluto calculation in a new segment much
+ * slower than the rest. Calling this function ahead of time removes that latency.
+ *
+ * The cache is safe to share between threads: concurrent callers may fill
+ * and read segments at the same time. Segments exist only for the years
+ * 0000..4000; times outside that range are calculated without the cache.
+ *
+ * @param startTime
+ *      The beginning of the time range to precalculate.
+ *
+ * @param stopTime
+ *      The end of the time range to precalculate. Pass the same value as `startTime`
+ *      to warm a single segment.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every segment overlapping the range is now cached,
+ *      `ASTRO_INVALID_PARAMETER` if the range is not finite,
+ *      or `ASTRO_OUT_OF_MEMORY` if a segment could not be allocated.
+ */
+astro_status_t Astronomy_PlutoCacheWarm(astro_time_t startTime, astro_time_t stopTime)
+{
+    int first, last, seg_index;
+    const body_segment_t *seg;
+    astro_status_t status;
+    double tt1 = startTime.tt;
+    double tt2 = stopTime.tt;
+
+    if (!isfinite(tt1) || !isfinite(tt2))
+        return ASTRO_INVALID_PARAMETER;
+
+    if (tt2 < tt1)
+    {
+        double swap = tt1;
+        tt1 = tt2;
+        tt2 = swap;
+    }
+
+    if (tt2 < PlutoStateTable[0].tt || tt1 > PlutoStateTable[PLUTO_NUM_STATES-1].tt)
+        return ASTRO_SUCCESS;
+
+    first = ClampIndex((tt1 - PlutoStateTable[0].tt) / PLUTO_TIME_STEP, PLUTO_NUM_STATES-1);
+    last  = ClampIndex((tt2 - PlutoStateTable[0].tt) / PLUTO_TIME_STEP, PLUTO_NUM_STATES-1);
+    for (seg_index = first; seg_index <= last; ++seg_index)
+    {
+        status = LoadSegment(&seg, pluto_cache, seg_index);
+        if (status != ASTRO_SUCCESS)
+            return status;
     }
 
     return ASTRO_SUCCESS;
 }
 
 
+/**
+ * @brief Returns the number of Pluto orbit segments currently cached.
+ *
+ * See #Astronomy_PlutoCacheWarm for a description of the cache.
+ * The memory used by the cache is this count multiplied by #Astronomy_PlutoCacheSegmentBytes.
+ * The cache can be released by calling #Astronomy_PlutoCacheFree.
+ */
+int Astronomy_PlutoCacheCount(void)
+{
+    int i, count = 0;
+    for (i=0; i < PLUTO_NUM_STATES-1; ++i)
+        if (AtomicLoadPtr(&pluto_cache[i]) != NULL)
+            ++count;
+    return count;
+}
+
+
+/**
+ * @brief Returns the number of bytes of memory used by one cached Pluto orbit segment.
+ */
+size_t Astronomy_PlutoCacheSegmentBytes(void)
+{
+    return sizeof(body_segment_t);
+}
+
+
+/**
+ * @brief Frees every cached Pluto orbit segment.
+ *
+ * Unlike filling the cache, purging it is not thread-safe: do not call this
+ * function while another thread may be calculating Pluto's position.
+ */
+void Astronomy_PlutoCacheFree(void)
+{
+    int i;
+    for (i=0; i < PLUTO_NUM_STATES-1; ++i)
+        free(AtomicExchangePtr(&pluto_cache[i], NULL));
+}
+
+
 static body_grav_calc_t CalcPlutoOneWay(major_bodies_t *bary, const body_state_t *init_state, double target_tt, double dt)
 {
     body_grav_calc_t calc;
@@ -4653,7 +7342,7 @@ static astro_status_t CalcPluto(body_state_t *bstate, astro_time_t time, int hel
     terse_vector_t acc, ra, rb, va, vb;
     major_bodies_t bary;
     const body_segment_t *seg;
-    int seg_index, left;
+    int left;
     const body_grav_calc_t *s1;
     const body_grav_calc_t *s2;
     body_grav_calc_t calc;
@@ -4663,11 +7352,11 @@ static astro_status_t CalcPluto(body_state_t *bstate, astro_time_t time, int hel
     memset(bstate, 0, sizeof(body_state_t));
     bstate->tt = time.tt;
 
-    status = GetSegment(&seg_index, pluto_cache, time.tt);
+    status = GetSegment(&seg, pluto_cache, time.tt);
     if (status != ASTRO_SUCCESS)
         return status;
 
-    if (seg_index < 0)
+    if (seg == NULL)
     {
         /* The target time is outside the year range 0000..4000. */
         /* Calculate it by crawling backward from 0000 or forward from 4000. */
@@ -4682,7 +7371,6 @@ static astro_status_t CalcPluto(body_state_t *bstate, astro_time_t time, int hel
     }
     else
     {
-        seg = pluto_cache[seg_index];
         left = ClampIndex((time.tt - seg->step[0].tt) / PLUTO_DT, PLUTO_NSTEPS-1);
         s1 = &seg->step[left];
         s2 = &seg->step[left+1];
@@ -5008,6 +7696,191 @@ static astro_state_vector_t CalcJupiterMoon(astro_time_t time, int mindex)
 }
 
 
+/*
+    Adds one of a moon's trigonometric series to the elements of a batch of times:
+    the amplitude times the cosine of each term's argument to `cossum`,
+    and times the sine to `sinsum`. Either sum may be NULL.
+    The terms are added in the same order as CalcJupiterMoon adds them.
+*/
+static void JupiterMoonSeriesBatch(const vsop_series_t *series, const double t[VSOP_BATCH], double tmax, double cossum[VSOP_BATCH], double sinsum[VSOP_BATCH])
+{
+    double angle[VSOP_BATCH];
+    double cosine[VSOP_BATCH];
+    double sine[VSOP_BATCH];
+    int j, k;
+
+    for (k = 0; k < series->nterms; ++k)
+    {
+        const vsop_term_t *term = &series->term[k];
+        for (j=0; j < VSOP_BATCH; ++j)
+            angle[j] = term->phase + (t[j] * term->frequency);
+
+        VsopSinCosBatch(angle, (sinsum != NULL) ? sine : NULL, (cossum != NULL) ? cosine : NULL);
+        if (!(fabs(term->phase) + tmax*fabs(term->frequency) < VSOP_FAST_COS_LIMIT))
+        {
+            for (j=0; j < VSOP_BATCH; ++j)
+            {
+                if (!(fabs(angle[j]) < VSOP_FAST_COS_LIMIT))
+                {
+                    cosine[j] = cos(angle[j]);
+                    sine[j] = sin(angle[j]);
+                }
+            }
+        }
+
+        if (cossum != NULL)
+            for (j=0; j < VSOP_BATCH; ++j)
+                cossum[j] += term->amplitude * cosine[j];
+
+        if (sinsum != NULL)
+            for (j=0; j < VSOP_BATCH; ++j)
+                sinsum[j] += term->amplitude * sine[j];
+    }
+}
+
+
+/*
+    Converts the orbital elements of one moon at VSOP_BATCH times into
+    Jupiter-equatorial (JUP) positions and velocities, with the same
+    arithmetic as JupiterMoon_elem2pv. Kepler's equation is iterated for the
+    whole batch until every time has converged; a time stops changing as soon
+    as it has converged, exactly as it would on its own.
+*/
+static void JupiterMoonElem2pvBatch(double mu, double elem[6][VSOP_BATCH], double pv[6][VSOP_BATCH])
+{
+    double EE[VSOP_BATCH], DE[VSOP_BATCH], CE[VSOP_BATCH], SE[VSOP_BATCH];
+    int active[VSOP_BATCH];
+    double AN, DLE, RSAM1, ASR, PHI, PSI, X1, Y1, VX1, VY1, F2, P2, Q2, PQ;
+    int j, nactive;
+
+    VsopSinCosBatch(elem[1], SE, CE);
+    for (j=0; j < VSOP_BATCH; ++j)
+    {
+        EE[j] = elem[1][j] + elem[2][j]*SE[j] - elem[3][j]*CE[j];
+        active[j] = 1;
+    }
+
+    do
+    {
+        VsopSinCosBatch(EE, SE, CE);
+        nactive = 0;
+        for (j=0; j < VSOP_BATCH; ++j)
+        {
+            DE[j] = (elem[1][j] - EE[j] + elem[2][j]*SE[j] - elem[3][j]*CE[j]) / (1.0 - elem[2][j]*CE[j] - elem[3][j]*SE[j]);
+            if (active[j])
+            {
+                EE[j] += DE[j];
+                active[j] = (fabs(DE[j]) >= 1.0e-12);
+                nactive += active[j];
+            }
+        }
+    }
+    while (nactive > 0);
+
+    VsopSinCosBatch(EE, SE, CE);
+    for (j=0; j < VSOP_BATCH; ++j)
+    {
+        const double A = elem[0][j];
+        const double K = elem[2][j];
+        const double H = elem[3][j];
+        const double Q = elem[4][j];
+        const double P = elem[5][j];
+
+        AN = sqrt(mu / (A*A*A));
+        DLE = H*CE[j] - K*SE[j];
+        RSAM1 = -K*CE[j] - H*SE[j];
+        ASR = 1.0/(1.0 + RSAM1);
+        PHI = sqrt(1.0 - K*K - H*H);
+        PSI = 1.0/(1.0 + PHI);
+        X1 = A*(CE[j] - K - PSI*H*DLE);
+        Y1 = A*(SE[j] - H + PSI*K*DLE);
+        VX1 = AN*ASR*A*(-SE[j] - PSI*H*RSAM1);
+        VY1 = AN*ASR*A*(+CE[j] + PSI*K*RSAM1);
+        F2 = 2.0*sqrt(1.0 - Q*Q - P*P);
+        P2 = 1.0 - 2.0*P*P;
+        Q2 = 1.0 - 2.0*Q*Q;
+        PQ = 2.0*P*Q;
+
+        pv[0][j] = X1*P2 + Y1*PQ;
+        pv[1][j] = X1*PQ + Y1*Q2;
+        pv[2][j] = (Q*Y1 - X1*P)*F2;
+        pv[3][j] = VX1*P2 + VY1*PQ;
+        pv[4][j] = VX1*PQ + VY1*Q2;
+        pv[5][j] = (Q*VY1 - VX1*P)*F2;
+    }
+}
+
+
+/*
+    Calculates the states of all four moons for VSOP_BATCH times at once.
+    The orbital element series of each moon are summed for the whole batch,
+    term by term, with the vectorisable sine and cosine of VsopSinCosBatch,
+    and the elements are converted to state vectors for the whole batch too.
+*/
+static void JupiterMoonsBatch(const astro_time_t time[VSOP_BATCH], astro_jupiter_moons_t moons[VSOP_BATCH])
+{
+    double t[VSOP_BATCH];
+    double elem[6][VSOP_BATCH];
+    double pv[6][VSOP_BATCH];
+    double tmax = 0.0;
+    astro_state_vector_t state;
+    int j, mindex;
+
+    for (j=0; j < VSOP_BATCH; ++j)
+    {
+        t[j] = time[j].tt + 18262.5;        /* t = time since 1950-01-01T00:00:00Z */
+        if (fabs(t[j]) > tmax)
+            tmax = fabs(t[j]);
+    }
+
+    for (mindex = 0; mindex < 4; ++mindex)
+    {
+        const jupiter_moon_t *m = &JupiterMoonModel[mindex];
+
+        for (j=0; j < VSOP_BATCH; ++j)
+        {
+            elem[0][j] = elem[2][j] = elem[3][j] = elem[4][j] = elem[5][j] = 0.0;
+            elem[1][j] = m->al[0] + (t[j] * m->al[1]);
+        }
+
+        JupiterMoonSeriesBatch(&m->a,    t, tmax, elem[0], NULL);
+        JupiterMoonSeriesBatch(&m->l,    t, tmax, NULL, elem[1]);
+        JupiterMoonSeriesBatch(&m->z,    t, tmax, elem[2], elem[3]);
+        JupiterMoonSeriesBatch(&m->zeta, t, tmax, elem[4], elem[5]);
+
+        for (j=0; j < VSOP_BATCH; ++j)
+        {
+            elem[1][j] = fmod(elem[1][j], PI2);
+            if (elem[1][j] < 0.0)
+                elem[1][j] += PI2;
+        }
+
+        JupiterMoonElem2pvBatch(m->mu, elem, pv);
+
+        for (j=0; j < VSOP_BATCH; ++j)
+        {
+            /* Re-orient the state from Jupiter-equatorial (JUP) to Earth-equatorial in J2000 (EQJ), as CalcJupiterMoon does. */
+            state.x  = pv[0][j];
+            state.y  = pv[1][j];
+            state.z  = pv[2][j];
+            state.vx = pv[3][j];
+            state.vy = pv[4][j];
+            state.vz = pv[5][j];
+            state.t = time[j];
+            state.status = ASTRO_SUCCESS;
+            state = Astronomy_RotateState(Rotation_JUP_EQJ, state);
+            switch (mindex)
+            {
+            case 0:  moons[j].io       = state;  break;
+            case 1:  moons[j].europa   = state;  break;
+            case 2:  moons[j].ganymede = state;  break;
+            default: moons[j].callisto = state;  break;
+            }
+        }
+    }
+}
+
+
 /**
  * @brief Calculates jovicentric positions and velocities of Jupiter's largest 4 moons.
  *
@@ -5044,6 +7917,47 @@ astro_jupiter_moons_t Astronomy_JupiterMoons(astro_time_t time)
     return jm;
 }
 
+
+/**
+ * @brief Calculates jovicentric positions and velocities of Jupiter's largest 4 moons at many times.
+ *
+ * Fills `moons[i]` with the result of `Astronomy_JupiterMoons(time[i])`
+ * for each `i` in `0 .. count-1`. The orbital element series of all four
+ * moons are summed for several times at once with a vectorisable sine and
+ * cosine, which is considerably faster than calling #Astronomy_JupiterMoons
+ * in a loop. The results agree with #Astronomy_JupiterMoons to within about
+ * 1.0e-15 AU.
+ *
+ * @param count   The number of times in `time` and results in `moons`.
+ * @param time    An array of `count` times at which to calculate the moons' states.
+ * @param moons   An array of `count` results.
+ * @return `ASTRO_SUCCESS`, or `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing.
+ */
+astro_status_t Astronomy_JupiterMoonsBatch(int count, const astro_time_t *time, astro_jupiter_moons_t *moons)
+{
+    astro_time_t batch_time[VSOP_BATCH];
+    astro_jupiter_moons_t batch_moons[VSOP_BATCH];
+    int first, n, j;
+
+    if (count < 0 || (count > 0 && (time == NULL || moons == NULL)))
+        return ASTRO_INVALID_PARAMETER;
+
+    for (first = 0; first < count; first += VSOP_BATCH)
+    {
+        n = (count - first < VSOP_BATCH) ? (count - first) : VSOP_BATCH;
+
+        /* Pad a partial batch by repeating its last time. */
+        for (j=0; j < VSOP_BATCH; ++j)
+            batch_time[j] = time[first + ((j < n) ? j : (n - 1))];
+
+        JupiterMoonsBatch(batch_time, batch_moons);
+        for (j=0; j < n; ++j)
+            moons[first + j] = batch_moons[j];
+    }
+
+    return ASTRO_SUCCESS;
+}
+
 /*---------------------- end Jupiter moons ----------------------*/
 
 
@@ -5145,6 +8059,61 @@ astro_vector_t Astronomy_HelioVector(astro_body_t body, astro_time_t time)
     }
 }
 
+/**
+ * @brief Calculates heliocentric Cartesian coordinates of a body at many times.
+ *
+ * This function is equivalent to calling #Astronomy_HelioVector once for each
+ * element of `time`, but is faster for the planets Mercury through Neptune:
+ * their VSOP87 series are evaluated for several times in each pass over the
+ * model's terms, using a cosine routine that compilers can vectorize.
+ * The Moon and the Earth/Moon barycenter use #Astronomy_GeoMoonBatch.
+ * The results agree with #Astronomy_HelioVector to within about 1.0e-13 AU.
+ * Times covered by #Astronomy_EphemerisCompile use the compiled ephemeris as usual.
+ *
+ * @param body      The body whose position is to be calculated; see #Astronomy_HelioVector.
+ * @param count     The number of times in `time`, and of vectors in `vector`.
+ * @param time      An array of `count` times at which to calculate the position.
+ * @param vector    An array of `count` vectors that receives the positions.
+ *                  Check the `status` field of each one before trusting it.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `vector` was filled in,
+ *      or `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing.
+ */
+astro_status_t Astronomy_HelioVectorBatch(astro_body_t body, int count, const astro_time_t *time, astro_vector_t *vector)
+{
+    astro_vector_t earth[MOON_VECTOR_BATCH];
+    double divisor;
+    int first, n, i;
+
+    if (count < 0 || (count > 0 && (time == NULL || vector == NULL)))
+        return ASTRO_INVALID_PARAMETER;
+
+    if (body >= BODY_MERCURY && body <= BODY_NEPTUNE)
+        CalcVsopBatch(&vsop[body], count, time, vector);
+    else if (body == BODY_MOON || body == BODY_EMB)
+    {
+        divisor = (body == BODY_MOON) ? 1.0 : (1.0 + EARTH_MOON_MASS_RATIO);
+        for (first=0; first < count; first += MOON_VECTOR_BATCH)
+        {
+            n = (count - first < MOON_VECTOR_BATCH) ? (count - first) : MOON_VECTOR_BATCH;
+            Astronomy_GeoMoonBatch(n, time + first, vector + first);
+            CalcVsopBatch(&vsop[BODY_EARTH], n, time + first, earth);
+            for (i=0; i < n; ++i)
+            {
+                vector[first+i].x = earth[i].x + (vector[first+i].x / divisor);
+                vector[first+i].y = earth[i].y + (vector[first+i].y / divisor);
+                vector[first+i].z = earth[i].z + (vector[first+i].z / divisor);
+            }
+        }
+    }
+    else
+        for (i=0; i < count; ++i)
+            vector[i] = Astronomy_HelioVector(body, time[i]);
+
+    return ASTRO_SUCCESS;
+}
+
 /**
  * @brief Calculates the distance from a body to the Sun at a given time.
  *
@@ -5524,6 +8493,132 @@ astro_vector_t Astronomy_GeoVector(astro_body_t body, astro_time_t time, astro_a
 }
 
 
+/** @cond DOXYGEN_SKIP */
+#define GEO_BATCH   64      /* number of rows solved together by Astronomy_GeoVectorBatch */
+/** @endcond */
+
+/**
+ * @brief Calculates geocentric Cartesian coordinates of a body at many times.
+ *
+ * This function is equivalent to calling #Astronomy_GeoVector once for each
+ * element of `time`. The light travel time corrections for all the times are
+ * solved together, so that each iteration calculates the body's and the Earth's
+ * heliocentric positions with #Astronomy_HelioVectorBatch.
+ * The results agree with #Astronomy_GeoVector to within about 1.0e-13 AU.
+ *
+ * @param body          The body whose position is to be calculated; see #Astronomy_GeoVector.
+ * @param count         The number of times in `time`, and of vectors in `vector`.
+ * @param time          An array of `count` times at which to calculate the position.
+ * @param aberration    `ABERRATION` to correct for aberration, or `NO_ABERRATION` to leave uncorrected.
+ * @param vector        An array of `count` vectors that receives the positions.
+ *                      Check the `status` field of each one before trusting it.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `vector` was filled in,
+ *      or `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing.
+ */
+astro_status_t Astronomy_GeoVectorBatch(
+    astro_body_t body,
+    int count,
+    const astro_time_t *time,
+    astro_aberration_t aberration,
+    astro_vector_t *vector)
+{
+    astro_time_t ltime[GEO_BATCH];
+    astro_time_t solve_time[GEO_BATCH];
+    astro_vector_t earth[GEO_BATCH];
+    astro_vector_t observer[GEO_BATCH];
+    astro_vector_t target[GEO_BATCH];
+    int active[GEO_BATCH];
+    int first, n, i, k, m, nactive, iter;
+    double distance;
+    astro_time_t ltime2;
+
+    if (count < 0 || (count > 0 && (time == NULL || vector == NULL)))
+        return ASTRO_INVALID_PARAMETER;
+
+    if (body == BODY_MOON)
+    {
+        /* The moon is so close, aberration and light travel time don't matter. */
+        return Astronomy_GeoMoonBatch(count, time, vector);
+    }
+
+    if (body == BODY_EARTH || UserDefinedStar(body) || (aberration != ABERRATION && aberration != NO_ABERRATION))
+    {
+        /* These cases need no light travel time solver, or only report errors. */
+        for (i=0; i < count; ++i)
+            vector[i] = Astronomy_GeoVector(body, time[i], aberration);
+        return ASTRO_SUCCESS;
+    }
+
+    for (first=0; first < count; first += GEO_BATCH)
+    {
+        n = (count - first < GEO_BATCH) ? (count - first) : GEO_BATCH;
+
+        /* Without aberration, the Earth's position is needed only at the observation times. */
+        if (aberration == NO_ABERRATION)
+            Astronomy_HelioVectorBatch(BODY_EARTH, n, time + first, earth);
+
+        for (k=0; k < n; ++k)
+        {
+            ltime[k] = time[first + k];
+            active[k] = k;
+            vector[first + k] = VecError(ASTRO_NO_CONVERGE, time[first + k]);
+        }
+        nactive = n;
+
+        /* Solve the light travel time for every row at once, as Astronomy_CorrectLightTravel does for one. */
+        for (iter = 0; iter < 10 && nactive > 0; ++iter)
+        {
+            for (m=0; m < nactive; ++m)
+                solve_time[m] = ltime[active[m]];
+
+            Astronomy_HelioVectorBatch(body, nactive, solve_time, target);
+            if (aberration == ABERRATION)
+                Astronomy_HelioVectorBatch(BODY_EARTH, nactive, solve_time, observer);
+            else
+                for (m=0; m < nactive; ++m)
+                    observer[m] = earth[active[m]];
+
+            k = 0;
+            for (m=0; m < nactive; ++m)
+            {
+                i = active[m];
+                if (observer[m].status != ASTRO_SUCCESS || target[m].status != ASTRO_SUCCESS)
+                {
+                    vector[first + i] = VecError((observer[m].status != ASTRO_SUCCESS) ? observer[m].status : target[m].status, time[first + i]);
+                    continue;
+                }
+
+                target[m].x -= observer[m].x;
+                target[m].y -= observer[m].y;
+                target[m].z -= observer[m].z;
+                distance = Astronomy_VectorLength(target[m]);
+                if (distance > C_AUDAY)
+                {
+                    vector[first + i] = VecError(ASTRO_INVALID_PARAMETER, time[first + i]);
+                    continue;
+                }
+
+                ltime2 = Astronomy_AddDays(time[first + i], -distance/C_AUDAY);
+                if (fabs(ltime2.tt - ltime[i].tt) < 1.0e-9)
+                {
+                    vector[first + i] = target[m];
+                    vector[first + i].t = time[first + i];      /* the observation time, as in Astronomy_GeoVector */
+                    continue;
+                }
+
+                ltime[i] = ltime2;
+                active[k++] = i;
+            }
+            nactive = k;
+        }
+    }
+
+    return ASTRO_SUCCESS;
+}
+
+
 /**
  * @brief  Calculates barycentric position and velocity vectors for the given body.
  *
@@ -6115,9 +9210,103 @@ astro_equatorial_t Astronomy_Equator(
         equ = vector2radec(j2000, *time);
         return equ;
 
-    default:
-        return EquError(ASTRO_INVALID_PARAMETER);
+    default:
+        return EquError(ASTRO_INVALID_PARAMETER);
+    }
+}
+
+
+/** @cond DOXYGEN_SKIP */
+typedef struct
+{
+    double  tt;
+    double  ut;
+    int     row;
+}
+batch_time_key_t;
+/** @endcond */
+
+static int CompareBatchTimeKey(const void *a, const void *b)
+{
+    const batch_time_key_t *ka = (const batch_time_key_t *)a;
+    const batch_time_key_t *kb = (const batch_time_key_t *)b;
+
+    if (ka->tt < kb->tt) return -1;
+    if (ka->tt > kb->tt) return +1;
+    if (ka->ut < kb->ut) return -1;
+    if (ka->ut > kb->ut) return +1;
+    return (ka->row < kb->row) ? -1 : (ka->row > kb->row);
+}
+
+/**
+ * @brief Calculates equatorial coordinates of many bodies, times and observers.
+ *
+ * Fills `equ[i]` with the same result as
+ * `Astronomy_Equator(body[i], &time[i], observer[i], equdate, aberration)`
+ * for each `i` in `0 .. count-1`.
+ *
+ * The rows are visited in order of time, and all rows that share a time
+ * share one copy of it. The nutation angles, sidereal time, and precession and
+ * nutation rotations are then calculated once per distinct time instead of
+ * once per row, however the times are ordered in `time`.
+ *
+ * @param count         The number of rows.
+ * @param body          An array of `count` bodies to observe; none may be `BODY_EARTH`.
+ * @param time          An array of `count` observation times.
+ * @param observer      An array of `count` observer locations.
+ * @param equdate       Selects the equator of date or the J2000 equator; see #Astronomy_Equator.
+ * @param aberration    Selects whether or not to correct for aberration.
+ * @param equ           An array of `count` results. Check the `status` field of each one.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `equ` was filled in,
+ *      `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing,
+ *      or `ASTRO_OUT_OF_MEMORY` if the rows could not be sorted.
+ */
+astro_status_t Astronomy_EquatorBatch(
+    int count,
+    const astro_body_t *body,
+    const astro_time_t *time,
+    const astro_observer_t *observer,
+    astro_equator_date_t equdate,
+    astro_aberration_t aberration,
+    astro_equatorial_t *equ)
+{
+    batch_time_key_t *key;
+    astro_time_t shared;
+    int i, row;
+
+    if (count < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (count == 0)
+        return ASTRO_SUCCESS;
+
+    if (body == NULL || time == NULL || observer == NULL || equ == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    key = (batch_time_key_t *) malloc(count * sizeof(batch_time_key_t));
+    if (key == NULL)
+        return ASTRO_OUT_OF_MEMORY;
+
+    for (i=0; i < count; ++i)
+    {
+        key[i].tt = time[i].tt;
+        key[i].ut = time[i].ut;
+        key[i].row = i;
     }
+    qsort(key, count, sizeof(batch_time_key_t), CompareBatchTimeKey);
+
+    for (i=0; i < count; ++i)
+    {
+        row = key[i].row;
+        if (i == 0 || key[i].tt != key[i-1].tt || key[i].ut != key[i-1].ut)
+            shared = time[row];
+        equ[row] = Astronomy_Equator(body[row], &shared, observer[row], equdate, aberration);
+    }
+
+    free(key);
+    return ASTRO_SUCCESS;
 }
 
 /**
@@ -6751,6 +9940,67 @@ static astro_func_result_t sun_offset(void *context, astro_time_t time)
     return result;
 }
 
+/** @cond DOXYGEN_SKIP */
+#define SUN_OFFSET_BATCH  64
+/** @endcond */
+
+/*
+    The batch form of sun_offset for Astronomy_SearchBatch: `context` is an array
+    of target longitudes indexed by bracket. The Earth's position is evaluated for
+    all the times together; the rest follows Astronomy_SunPosition.
+*/
+static void sun_offset_batch(
+    void *context,
+    int count,
+    const int *bracket,
+    const astro_time_t *time,
+    astro_func_result_t *result)
+{
+    const double *targetLon = (const double *) context;
+    astro_time_t adjusted_time[SUN_OFFSET_BATCH];
+    astro_vector_t earth2000[SUN_OFFSET_BATCH];
+    double sun2000[3];
+    double stemp[3];
+    double sun_ofdate[3];
+    double true_obliq;
+    astro_ecliptic_t ecl;
+    int start, n, k;
+
+    for (start=0; start < count; start += n)
+    {
+        n = count - start;
+        if (n > SUN_OFFSET_BATCH)
+            n = SUN_OFFSET_BATCH;
+
+        /* Correct for light travel time from the Sun, as in Astronomy_SunPosition. */
+        for (k=0; k < n; ++k)
+            adjusted_time[k] = Astronomy_AddDays(time[start+k], -1.0 / C_AUDAY);
+
+        CalcVsopBatch(&vsop[BODY_EARTH], n, adjusted_time, earth2000);
+
+        for (k=0; k < n; ++k)
+        {
+            sun2000[0] = -earth2000[k].x;
+            sun2000[1] = -earth2000[k].y;
+            sun2000[2] = -earth2000[k].z;
+
+            precession(sun2000, adjusted_time[k], FROM_2000, stemp);
+            nutation(stemp, &adjusted_time[k], FROM_2000, sun_ofdate);
+
+            true_obliq = DEG2RAD * e_tilt(&adjusted_time[k]).tobl;
+            ecl = RotateEquatorialToEcliptic(sun_ofdate, true_obliq, time[start+k]);
+            if (ecl.status != ASTRO_SUCCESS)
+            {
+                result[start+k] = FuncError(ecl.status);
+                continue;
+            }
+
+            result[start+k].value = LongitudeOffset(ecl.elon - targetLon[bracket[start+k]]);
+            result[start+k].status = ASTRO_SUCCESS;
+        }
+    }
+}
+
 /**
  * @brief
  *      Searches for the time when the Sun reaches an apparent ecliptic longitude as seen from the Earth.
@@ -6798,14 +10048,323 @@ astro_search_result_t Astronomy_SearchSunLongitude(
 }
 
 /** @cond DOXYGEN_SKIP */
-#define CALLFUNC(f,t)  \
-    do { \
-        funcres = func(context, (t)); \
-        if (funcres.status != ASTRO_SUCCESS) return SearchError(funcres.status); \
-        (f) = funcres.value; \
-    } while(0)
+#define SEARCH_ITER_LIMIT  20
+
+typedef enum
+{
+    SEARCH_START,       /* waiting for f(t1) and f(t2) */
+    SEARCH_MID,         /* waiting for f(tmid) */
+    SEARCH_QUAD,        /* waiting for f(tq), the root of the interpolating parabola */
+    SEARCH_NARROW,      /* waiting for f(tleft) and f(tright) around tq */
+    SEARCH_DONE
+}
+search_phase_t;
+
+/*
+    The state of one bracket in a search. Astronomy_Search's loop is split
+    at every call to the search function, so that many brackets can wait
+    for their function values together and take exactly the steps that
+    the single-bracket loop would.
+*/
+typedef struct
+{
+    search_phase_t phase;
+    astro_time_t t1, t2, tmid, tq;
+    double f1, f2, fmid, fq, dt, q_df_dt;
+    int iter;
+    int calc_fmid;
+    int nreq;                   /* number of times in `req` waiting for values */
+    astro_time_t req[2];
+    double value[2];
+    astro_search_result_t result;
+}
+search_state_t;
+/** @endcond */
+
+static void SearchLoop(search_state_t *s, double dt_days);
+
+static void SearchRequest(search_state_t *s, search_phase_t phase, astro_time_t t)
+{
+    s->phase = phase;
+    s->req[0] = t;
+    s->nreq = 1;
+}
+
+static void SearchFinish(search_state_t *s, astro_status_t status, astro_time_t time)
+{
+    if (status == ASTRO_SUCCESS)
+    {
+        s->result.time = time;
+        s->result.status = ASTRO_SUCCESS;
+    }
+    else
+        s->result = SearchError(status);
+    s->phase = SEARCH_DONE;
+    s->nreq = 0;
+}
+
+/* Divides the region in two parts and picks whichever one appears to contain a root. */
+static void SearchBisect(search_state_t *s, double dt_days)
+{
+    if (s->f1 < 0.0 && s->fmid >= 0.0)
+    {
+        s->t2 = s->tmid;
+        s->f2 = s->fmid;
+        SearchLoop(s, dt_days);
+        return;
+    }
+
+    if (s->fmid < 0.0 && s->f2 >= 0.0)
+    {
+        s->t1 = s->tmid;
+        s->f1 = s->fmid;
+        SearchLoop(s, dt_days);
+        return;
+    }
+
+    /* Either there is no ascending zero-crossing in this range */
+    /* or the search window is too wide (more than one zero-crossing). */
+    SearchFinish(s, ASTRO_SEARCH_FAILURE, s->tmid);
+}
+
+/* With f(tmid) known, tries to find a parabola that passes through (t1,f1), (tmid,fmid), (t2,f2). */
+static void SearchInterpolate(search_state_t *s, double dt_days)
+{
+    double q_ut;
+
+    if (QuadInterp(s->tmid.ut, s->t2.ut - s->tmid.ut, s->f1, s->fmid, s->f2, &q_ut, &s->q_df_dt))
+    {
+        s->tq = Astronomy_TimeFromDays(q_ut);
+        SearchRequest(s, SEARCH_QUAD, s->tq);
+        return;
+    }
+
+    SearchBisect(s, dt_days);
+}
+
+/* With f(tq) known, either accepts tq or tries a tighter boundary with tq at the center. */
+static void SearchQuadResult(search_state_t *s, double dt_days)
+{
+    double dt_guess;
+    astro_time_t tleft, tright;
+
+    if (s->q_df_dt != 0.0)
+    {
+        dt_guess = fabs(s->fq / s->q_df_dt);
+        if (dt_guess < dt_days)
+        {
+            /* The estimated time error is small enough that we can quit now. */
+            SearchFinish(s, ASTRO_SUCCESS, s->tq);
+            return;
+        }
+
+        dt_guess *= 1.2;
+        if (dt_guess < s->dt/10.0)
+        {
+            tleft = Astronomy_AddDays(s->tq, -dt_guess);
+            tright = Astronomy_AddDays(s->tq, +dt_guess);
+            if ((tleft.ut - s->t1.ut)*(tleft.ut - s->t2.ut) < 0)
+            {
+                if ((tright.ut - s->t1.ut)*(tright.ut - s->t2.ut) < 0)
+                {
+                    s->phase = SEARCH_NARROW;
+                    s->req[0] = tleft;
+                    s->req[1] = tright;
+                    s->nreq = 2;
+                    return;
+                }
+            }
+        }
+    }
+
+    SearchBisect(s, dt_days);
+}
+
+/* The top of the search loop: stops if the window is small enough, otherwise needs f(tmid). */
+static void SearchLoop(search_state_t *s, double dt_days)
+{
+    if (++s->iter > SEARCH_ITER_LIMIT)
+    {
+        SearchFinish(s, ASTRO_NO_CONVERGE, s->tmid);
+        return;
+    }
+
+    s->dt = (s->t2.tt - s->t1.tt) / 2.0;
+    s->tmid = Astronomy_AddDays(s->t1, s->dt);
+    if (fabs(s->dt) < dt_days)
+    {
+        /* We are close enough to the event to stop the search. */
+        SearchFinish(s, ASTRO_SUCCESS, s->tmid);
+        return;
+    }
+
+    if (s->calc_fmid)
+    {
+        SearchRequest(s, SEARCH_MID, s->tmid);
+        return;
+    }
+
+    s->calc_fmid = 1;       /* we already have the correct value of fmid from the previous loop */
+    SearchInterpolate(s, dt_days);
+}
+
+static void SearchBegin(search_state_t *s, astro_time_t t1, astro_time_t t2)
+{
+    s->t1 = t1;
+    s->t2 = t2;
+    s->iter = 0;
+    s->calc_fmid = 1;
+    s->phase = SEARCH_START;
+    s->req[0] = t1;
+    s->req[1] = t2;
+    s->nreq = 2;
+}
+
+/* Consumes the values of the requested times and runs until the next request or the end. */
+static void SearchAdvance(search_state_t *s, double dt_days)
+{
+    switch (s->phase)
+    {
+    case SEARCH_START:
+        s->f1 = s->value[0];
+        s->f2 = s->value[1];
+        SearchLoop(s, dt_days);
+        break;
+
+    case SEARCH_MID:
+        s->fmid = s->value[0];
+        SearchInterpolate(s, dt_days);
+        break;
+
+    case SEARCH_QUAD:
+        s->fq = s->value[0];
+        SearchQuadResult(s, dt_days);
+        break;
+
+    case SEARCH_NARROW:
+        if (s->value[0] < 0.0 && s->value[1] >= 0.0)
+        {
+            s->f1 = s->value[0];
+            s->f2 = s->value[1];
+            s->t1 = s->req[0];
+            s->t2 = s->req[1];
+            s->fmid = s->fq;
+            s->calc_fmid = 0;   /* save a little work -- no need to re-calculate fmid next time around the loop */
+            SearchLoop(s, dt_days);
+        }
+        else
+            SearchBisect(s, dt_days);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*
+    Runs `count` searches in lock-step. Each round collects the times every
+    unfinished bracket is waiting for and passes them all to `func` at once.
+    The caller supplies the work arrays: `state` holds `count` entries and
+    `bracket`, `time` and `funcres` hold `2*count` entries each.
+*/
+static void SearchBatchDriver(
+    astro_search_batch_func_t func,
+    void *context,
+    int count,
+    const astro_time_t *t1,
+    const astro_time_t *t2,
+    double dt_tolerance_seconds,
+    astro_search_result_t *result,
+    search_state_t *state,
+    int *bracket,
+    astro_time_t *time,
+    astro_func_result_t *funcres)
+{
+    double dt_days = fabs(dt_tolerance_seconds / SECONDS_PER_DAY);
+    search_state_t *s;
+    int i, k, n;
+
+    for (i=0; i < count; ++i)
+        SearchBegin(&state[i], t1[i], t2[i]);
+
+    for(;;)
+    {
+        n = 0;
+        for (i=0; i < count; ++i)
+        {
+            for (k=0; k < state[i].nreq; ++k)
+            {
+                bracket[n] = i;
+                time[n] = state[i].req[k];
+                ++n;
+            }
+        }
+
+        if (n == 0)
+            break;
+
+        func(context, n, bracket, time, funcres);
+
+        n = 0;
+        for (i=0; i < count; ++i)
+        {
+            s = &state[i];
+            if (s->nreq == 0)
+                continue;
+
+            for (k=0; k < s->nreq; ++k)
+            {
+                if (funcres[n+k].status != ASTRO_SUCCESS)
+                    break;
+                s->value[k] = funcres[n+k].value;
+            }
+            n += s->nreq;
+
+            if (k < s->nreq)
+                SearchFinish(s, funcres[n - s->nreq + k].status, s->t1);
+            else
+                SearchAdvance(s, dt_days);
+        }
+    }
+
+    for (i=0; i < count; ++i)
+        result[i] = state[i].result;
+}
+
+/** @cond DOXYGEN_SKIP */
+typedef struct
+{
+    astro_search_func_t func;
+    void *context;
+}
+search_adapter_t;
 /** @endcond */
 
+/* Lets Astronomy_Search run a scalar function through the batch driver. */
+static void SearchAdapter(
+    void *context,
+    int count,
+    const int *bracket,
+    const astro_time_t *time,
+    astro_func_result_t *result)
+{
+    const search_adapter_t *adapter = (const search_adapter_t *) context;
+    int k, j;
+
+    (void)bracket;
+    for (k=0; k < count; ++k)
+    {
+        result[k] = adapter->func(adapter->context, time[k]);
+        if (result[k].status != ASTRO_SUCCESS)
+        {
+            /* Stop at the first failure, as the search would. */
+            for (j=k+1; j < count; ++j)
+                result[j] = result[k];
+            return;
+        }
+    }
+}
+
 /**
  * @brief Searches for a time at which a function's value increases through zero.
  *
@@ -6891,108 +10450,99 @@ astro_search_result_t Astronomy_Search(
     astro_time_t t2,
     double dt_tolerance_seconds)
 {
+    search_adapter_t adapter;
+    search_state_t state;
+    int bracket[2];
+    astro_time_t time[2];
+    astro_func_result_t funcres[2];
     astro_search_result_t result;
-    astro_time_t tmid;
-    astro_time_t tq;
-    astro_func_result_t funcres;
-    double f1, f2, fmid=0.0, fq, dt_days, dt, dt_guess;
-    double q_ut, q_df_dt;
-    const int iter_limit = 20;
-    int iter = 0;
-    int calc_fmid = 1;
-
-    dt_days = fabs(dt_tolerance_seconds / SECONDS_PER_DAY);
-    CALLFUNC(f1, t1);
-    CALLFUNC(f2, t2);
-
-    for(;;)
-    {
-        if (++iter > iter_limit)
-            return SearchError(ASTRO_NO_CONVERGE);
-
-        dt = (t2.tt - t1.tt) / 2.0;
-        tmid = Astronomy_AddDays(t1, dt);
-        if (fabs(dt) < dt_days)
-        {
-            /* We are close enough to the event to stop the search. */
-            result.time = tmid;
-            result.status = ASTRO_SUCCESS;
-            return result;
-        }
 
-        if (calc_fmid)
-            CALLFUNC(fmid, tmid);
-        else
-            calc_fmid = 1;      /* we already have the correct value of fmid from the previous loop */
+    adapter.func = func;
+    adapter.context = context;
+    SearchBatchDriver(SearchAdapter, &adapter, 1, &t1, &t2, dt_tolerance_seconds, &result, &state, bracket, time, funcres);
+    return result;
+}
 
-        /* Quadratic interpolation: */
-        /* Try to find a parabola that passes through the 3 points we have sampled: */
-        /* (t1,f1), (tmid,fmid), (t2,f2) */
+/**
+ * @brief Searches for ascending roots of a function in many time windows at once.
+ *
+ * Runs the same search as #Astronomy_Search independently in each window
+ * `t1[i]`..`t2[i]` for `i` in `0 .. count-1`, storing the outcome in `result[i]`.
+ * Every result is identical to the one `Astronomy_Search` returns for that window.
+ *
+ * Instead of being called once per time, `func` is called once per round of
+ * the search with every time that the unfinished windows are waiting for,
+ * so it can evaluate them together with batch functions such as
+ * #Astronomy_GeoVectorBatch. `func` receives, for each `k` in `0 .. n-1`,
+ * the index `bracket[k]` of the window that needs the value at `time[k]`,
+ * and must store that value in `result[k]`. A failed value ends only the
+ * search of its own window, whose result then holds the same status.
+ *
+ * @param func
+ *      The batch function for which to find the times of ascending roots.
+ *
+ * @param context
+ *      Any ancillary data needed by `func`, passed to every call.
+ *
+ * @param count
+ *      The number of time windows.
+ *
+ * @param t1
+ *      An array of `count` lower time bounds.
+ *
+ * @param t2
+ *      An array of `count` upper time bounds.
+ *
+ * @param dt_tolerance_seconds
+ *      The time accuracy of every search; see #Astronomy_Search.
+ *
+ * @param result
+ *      An array of `count` results. Check the `status` field of each one.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `result` was filled in,
+ *      `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing,
+ *      or `ASTRO_OUT_OF_MEMORY` if the search state could not be allocated.
+ */
+astro_status_t Astronomy_SearchBatch(
+    astro_search_batch_func_t func,
+    void *context,
+    int count,
+    const astro_time_t *t1,
+    const astro_time_t *t2,
+    double dt_tolerance_seconds,
+    astro_search_result_t *result)
+{
+    search_state_t *state;
+    int *bracket;
+    astro_time_t *time;
+    astro_func_result_t *funcres;
+    astro_status_t status = ASTRO_SUCCESS;
+
+    if (count < 0)
+        return ASTRO_INVALID_PARAMETER;
 
-        if (QuadInterp(tmid.ut, t2.ut - tmid.ut, f1, fmid, f2, &q_ut, &q_df_dt))
-        {
-            tq = Astronomy_TimeFromDays(q_ut);
-            CALLFUNC(fq, tq);
-            if (q_df_dt != 0.0)
-            {
-                dt_guess = fabs(fq / q_df_dt);
-                if (dt_guess < dt_days)
-                {
-                    /* The estimated time error is small enough that we can quit now. */
-                    result.time = tq;
-                    result.status = ASTRO_SUCCESS;
-                    return result;
-                }
+    if (count == 0)
+        return ASTRO_SUCCESS;
 
-                /* Try guessing a tighter boundary with the interpolated root at the center. */
-                dt_guess *= 1.2;
-                if (dt_guess < dt/10.0)
-                {
-                    astro_time_t tleft = Astronomy_AddDays(tq, -dt_guess);
-                    astro_time_t tright = Astronomy_AddDays(tq, +dt_guess);
-                    if ((tleft.ut - t1.ut)*(tleft.ut - t2.ut) < 0)
-                    {
-                        if ((tright.ut - t1.ut)*(tright.ut - t2.ut) < 0)
-                        {
-                            double fleft, fright;
-                            CALLFUNC(fleft, tleft);
-                            CALLFUNC(fright, tright);
-                            if (fleft<0.0 && fright>=0.0)
-                            {
-                                f1 = fleft;
-                                f2 = fright;
-                                t1 = tleft;
-                                t2 = tright;
-                                fmid = fq;
-                                calc_fmid = 0;  /* save a little work -- no need to re-calculate fmid next time around the loop */
-                                continue;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    if (func == NULL || t1 == NULL || t2 == NULL || result == NULL)
+        return ASTRO_INVALID_PARAMETER;
 
-        /* After quadratic interpolation attempt. */
-        /* Now just divide the region in two parts and pick whichever one appears to contain a root. */
-        if (f1 < 0.0 && fmid >= 0.0)
-        {
-            t2 = tmid;
-            f2 = fmid;
-            continue;
-        }
+    state = (search_state_t *) malloc((size_t)count * sizeof(search_state_t));
+    bracket = (int *) malloc(2 * (size_t)count * sizeof(int));
+    time = (astro_time_t *) malloc(2 * (size_t)count * sizeof(astro_time_t));
+    funcres = (astro_func_result_t *) malloc(2 * (size_t)count * sizeof(astro_func_result_t));
 
-        if (fmid < 0.0 && f2 >= 0.0)
-        {
-            t1 = tmid;
-            f1 = fmid;
-            continue;
-        }
+    if (state == NULL || bracket == NULL || time == NULL || funcres == NULL)
+        status = ASTRO_OUT_OF_MEMORY;
+    else
+        SearchBatchDriver(func, context, count, t1, t2, dt_tolerance_seconds, result, state, bracket, time, funcres);
 
-        /* Either there is no ascending zero-crossing in this range */
-        /* or the search window is too wide (more than one zero-crossing). */
-        return SearchError(ASTRO_SEARCH_FAILURE);
-    }
+    free(state);
+    free(bracket);
+    free(time);
+    free(funcres);
+    return status;
 }
 
 static int QuadInterp(
@@ -7110,16 +10660,140 @@ astro_seasons_t Astronomy_Seasons(int year)
     status = FindSeasonChange(  0, year,  3, 10, &seasons.mar_equinox);
     if (status != ASTRO_SUCCESS) seasons.status = status;
 
-    status = FindSeasonChange( 90, year,  6, 10, &seasons.jun_solstice);
-    if (status != ASTRO_SUCCESS) seasons.status = status;
+    status = FindSeasonChange( 90, year,  6, 10, &seasons.jun_solstice);
+    if (status != ASTRO_SUCCESS) seasons.status = status;
+
+    status = FindSeasonChange(180, year,  9, 10, &seasons.sep_equinox);
+    if (status != ASTRO_SUCCESS) seasons.status = status;
+
+    status = FindSeasonChange(270, year, 12, 10, &seasons.dec_solstice);
+    if (status != ASTRO_SUCCESS) seasons.status = status;
+
+    return seasons;
+}
+
+/** @cond DOXYGEN_SKIP */
+#define SEASONS_BATCH       16      /* number of years searched together */
+#define SEASONS_SEED_YEARS  64      /* furthest year seeded from a previous result */
+#define SEASONS_SEED_DAYS   2.0     /* half-width of a seeded search window */
+/** @endcond */
+
+static astro_time_t *SeasonTime(astro_seasons_t *seasons, int k)
+{
+    switch (k)
+    {
+    case 0:  return &seasons->mar_equinox;
+    case 1:  return &seasons->jun_solstice;
+    case 2:  return &seasons->sep_equinox;
+    default: return &seasons->dec_solstice;
+    }
+}
+
+/**
+ * @brief Finds the equinoxes and solstices for many calendar years.
+ *
+ * Fills `seasons[i]` with the equinoxes and solstices of `year[i]`
+ * for each `i` in `0 .. count-1`, like calling #Astronomy_Seasons for each year.
+ *
+ * The years are searched in blocks, and all the searches in a block run together
+ * through #Astronomy_SearchBatch, evaluating the Earth's position for every
+ * pending time at once. Once a year has been found, the searches for the years
+ * after it in the array are seeded from its results, advanced by whole tropical
+ * years, so they search a 4-day window instead of 20 days. Listing the years in
+ * order therefore gives the most benefit. Because the windows differ, the times
+ * may differ from those of #Astronomy_Seasons by up to the search tolerance of
+ * 0.01 seconds.
+ *
+ * @param count     The number of years.
+ * @param year      An array of `count` calendar years; see #Astronomy_Seasons.
+ * @param seasons   An array of `count` results. Check the `status` field of each one.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `seasons` was filled in,
+ *      `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing.
+ */
+astro_status_t Astronomy_SeasonsBatch(int count, const int *year, astro_seasons_t *seasons)
+{
+    static const double targetLon[4] = { 0.0, 90.0, 180.0, 270.0 };
+    static const int month[4] = { 3, 6, 9, 12 };
+    double target[4 * SEASONS_BATCH];
+    astro_time_t t1[4 * SEASONS_BATCH];
+    astro_time_t t2[4 * SEASONS_BATCH];
+    astro_search_result_t found[4 * SEASONS_BATCH];
+    astro_seasons_t seed;
+    astro_time_t *time;
+    astro_status_t status;
+    int seed_year = 0;
+    int have_seed = 0;
+    int start, n, i, k, m, seeded;
+    double center;
+
+    if (count < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (count > 0 && (year == NULL || seasons == NULL))
+        return ASTRO_INVALID_PARAMETER;
+
+    for (start=0; start < count; start += n)
+    {
+        n = count - start;
+        if (n > SEASONS_BATCH)
+            n = SEASONS_BATCH;
+
+        m = 0;
+        for (i=0; i < n; ++i)
+        {
+            seeded = have_seed && abs(year[start+i] - seed_year) <= SEASONS_SEED_YEARS;
+            for (k=0; k < 4; ++k)
+            {
+                target[m] = targetLon[k];
+                if (seeded)
+                {
+                    center = SeasonTime(&seed, k)->tt + (year[start+i] - seed_year)*DAYS_PER_TROPICAL_YEAR;
+                    t1[m] = Astronomy_TerrestrialTime(center - SEASONS_SEED_DAYS);
+                    t2[m] = Astronomy_TerrestrialTime(center + SEASONS_SEED_DAYS);
+                }
+                else
+                {
+                    /* The same window as FindSeasonChange. */
+                    t1[m] = Astronomy_MakeTime(year[start+i], month[k], 10, 0, 0, 0.0);
+                    t2[m] = Astronomy_AddDays(t1[m], 20.0);
+                }
+                ++m;
+            }
+        }
+
+        status = Astronomy_SearchBatch(sun_offset_batch, target, m, t1, t2, 0.01, found);
+        if (status != ASTRO_SUCCESS)
+            return status;
 
-    status = FindSeasonChange(180, year,  9, 10, &seasons.sep_equinox);
-    if (status != ASTRO_SUCCESS) seasons.status = status;
+        for (i=0; i < n; ++i)
+        {
+            seasons[start+i].status = ASTRO_SUCCESS;
+            for (k=0; k < 4; ++k)
+            {
+                time = SeasonTime(&seasons[start+i], k);
+                *time = found[4*i + k].time;
+                status = found[4*i + k].status;
+                if (status != ASTRO_SUCCESS)
+                {
+                    /* A seeded window can only miss if the seed was far off; retry the usual way. */
+                    status = FindSeasonChange(targetLon[k], year[start+i], month[k], 10, time);
+                    if (status != ASTRO_SUCCESS)
+                        seasons[start+i].status = status;
+                }
+            }
 
-    status = FindSeasonChange(270, year, 12, 10, &seasons.dec_solstice);
-    if (status != ASTRO_SUCCESS) seasons.status = status;
+            if (seasons[start+i].status == ASTRO_SUCCESS)
+            {
+                seed = seasons[start+i];
+                seed_year = year[start+i];
+                have_seed = 1;
+            }
+        }
+    }
 
-    return seasons;
+    return ASTRO_SUCCESS;
 }
 
 /**
@@ -7509,6 +11183,52 @@ static astro_func_result_t moon_offset(void *context, astro_time_t time)
     return result;
 }
 
+/*
+    To avoid discontinuities in the moon_offset function causing problems,
+    we need to approximate when that function will next return 0.
+    We probe it with the start time and take advantage of the fact
+    that every lunar phase repeats roughly every 29.5 days.
+    There is a surprising uncertainty in the quarter timing,
+    due to the eccentricity of the moon's orbit.
+    I have seen more than 0.9 days away from the simple prediction.
+    To be safe, we take the predicted time of the event and search
+    +/-1.5 days around it (a 3-day wide window).
+    Return ASTRO_NO_MOON_QUARTER if the final result goes beyond limitDays after startTime.
+*/
+static astro_status_t MoonPhaseWindow(double ya, double limitDays, double *dt1_out, double *dt2_out)
+{
+    const double uncertainty = 1.5;
+    double est_dt, dt1, dt2;
+
+    if (limitDays < 0.0)
+    {
+        /* Search backward in time. */
+        if (ya < 0.0) ya += 360.0;
+        est_dt = -(MEAN_SYNODIC_MONTH * ya) / 360.0;
+        dt1 = est_dt - uncertainty;
+        dt2 = est_dt + uncertainty;
+        if (dt2 < limitDays)
+            return ASTRO_NO_MOON_QUARTER;   /* not possible for moon phase to occur within specified window (too short) */
+        if (dt1 < limitDays)
+            dt1 = limitDays;
+    }
+    else
+    {
+        /* Search forward in time. */
+        if (ya > 0.0) ya -= 360.0;
+        est_dt = -(MEAN_SYNODIC_MONTH * ya) / 360.0;
+        dt1 = est_dt - uncertainty;
+        dt2 = est_dt + uncertainty;
+        if (dt1 > limitDays)
+            return ASTRO_NO_MOON_QUARTER;   /* not possible for moon phase to occur within specified window (too short) */
+        if (dt2 > limitDays)
+            dt2 = limitDays;
+    }
+    *dt1_out = dt1;
+    *dt2_out = dt2;
+    return ASTRO_SUCCESS;
+}
+
 /**
  * @brief
  *      Searches for the time that the Moon reaches a specified phase.
@@ -7549,55 +11269,191 @@ static astro_func_result_t moon_offset(void *context, astro_time_t time)
  */
 astro_search_result_t Astronomy_SearchMoonPhase(double targetLon, astro_time_t startTime, double limitDays)
 {
-    /*
-        To avoid discontinuities in the moon_offset function causing problems,
-        we need to approximate when that function will next return 0.
-        We probe it with the start time and take advantage of the fact
-        that every lunar phase repeats roughly every 29.5 days.
-        There is a surprising uncertainty in the quarter timing,
-        due to the eccentricity of the moon's orbit.
-        I have seen more than 0.9 days away from the simple prediction.
-        To be safe, we take the predicted time of the event and search
-        +/-1.5 days around it (a 3-day wide window).
-        Return ASTRO_NO_MOON_QUARTER if the final result goes beyond limitDays after startTime.
-    */
-    const double uncertainty = 1.5;
     astro_func_result_t funcres;
-    double ya, est_dt, dt1, dt2;
+    astro_status_t status;
+    double dt1, dt2;
     astro_time_t t1, t2;
 
     funcres = moon_offset(&targetLon, startTime);
     if (funcres.status != ASTRO_SUCCESS)
         return SearchError(funcres.status);
 
-    ya = funcres.value;
-    if (limitDays < 0.0)
+    status = MoonPhaseWindow(funcres.value, limitDays, &dt1, &dt2);
+    if (status != ASTRO_SUCCESS)
+        return SearchError(status);
+
+    t1 = Astronomy_AddDays(startTime, dt1);
+    t2 = Astronomy_AddDays(startTime, dt2);
+    return Astronomy_Search(moon_offset, &targetLon, t1, t2, 0.1);
+}
+
+/** @cond DOXYGEN_SKIP */
+#define MOON_PHASE_BATCH  64
+/** @endcond */
+
+/*
+    The batch form of moon_offset for Astronomy_SearchBatch: `context` is an array
+    of target longitudes indexed by bracket. The Moon and Sun are evaluated with the
+    batch kernels, giving the same values as Astronomy_MoonPhase.
+*/
+static void moon_offset_batch(
+    void *context,
+    int count,
+    const int *bracket,
+    const astro_time_t *time,
+    astro_func_result_t *result)
+{
+    const double *targetLon = (const double *) context;
+    astro_vector_t moon[MOON_PHASE_BATCH];
+    astro_vector_t sun[MOON_PHASE_BATCH];
+    astro_ecliptic_t eclip1, eclip2;
+    astro_status_t status;
+    int start, n, k;
+
+    for (start=0; start < count; start += n)
     {
-        /* Search backward in time. */
-        if (ya < 0.0) ya += 360.0;
-        est_dt = -(MEAN_SYNODIC_MONTH * ya) / 360.0;
-        dt1 = est_dt - uncertainty;
-        dt2 = est_dt + uncertainty;
-        if (dt2 < limitDays)
-            return SearchError(ASTRO_NO_MOON_QUARTER);    /* not possible for moon phase to occur within specified window (too short) */
-        if (dt1 < limitDays)
-            dt1 = limitDays;
+        n = count - start;
+        if (n > MOON_PHASE_BATCH)
+            n = MOON_PHASE_BATCH;
+
+        status = Astronomy_GeoVectorBatch(BODY_MOON, n, &time[start], NO_ABERRATION, moon);
+        if (status == ASTRO_SUCCESS)
+            status = Astronomy_GeoVectorBatch(BODY_SUN, n, &time[start], NO_ABERRATION, sun);
+
+        for (k=0; k < n; ++k)
+        {
+            if (status != ASTRO_SUCCESS)
+            {
+                result[start+k] = FuncError(status);
+                continue;
+            }
+
+            eclip1 = Astronomy_Ecliptic(moon[k]);
+            if (eclip1.status != ASTRO_SUCCESS)
+            {
+                result[start+k] = FuncError(eclip1.status);
+                continue;
+            }
+
+            eclip2 = Astronomy_Ecliptic(sun[k]);
+            if (eclip2.status != ASTRO_SUCCESS)
+            {
+                result[start+k] = FuncError(eclip2.status);
+                continue;
+            }
+
+            result[start+k].value = LongitudeOffset(NormalizeLongitude(eclip1.elon - eclip2.elon) - targetLon[bracket[start+k]]);
+            result[start+k].status = ASTRO_SUCCESS;
+        }
     }
-    else
+}
+
+/**
+ * @brief Searches for the times that the Moon reaches many phases.
+ *
+ * Fills `result[i]` with the same result as
+ * `Astronomy_SearchMoonPhase(targetLon[i], startTime[i], limitDays[i])`
+ * for each `i` in `0 .. count-1`.
+ *
+ * All the searches run together through #Astronomy_SearchBatch, so each round
+ * evaluates the Moon and Sun for every pending time with
+ * #Astronomy_GeoVectorBatch instead of one time at a time.
+ *
+ * @param count         The number of searches.
+ * @param targetLon     An array of `count` phase angles in degrees; see #Astronomy_SearchMoonPhase.
+ * @param startTime     An array of `count` start times.
+ * @param limitDays     An array of `count` search limits in days, negative to search backward.
+ * @param result        An array of `count` results. Check the `status` field of each one.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `result` was filled in,
+ *      `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing,
+ *      or `ASTRO_OUT_OF_MEMORY` if the work arrays could not be allocated.
+ */
+astro_status_t Astronomy_SearchMoonPhaseBatch(
+    int count,
+    const double *targetLon,
+    const astro_time_t *startTime,
+    const double *limitDays,
+    astro_search_result_t *result)
+{
+    int *row = NULL;
+    double *target = NULL;
+    astro_time_t *t1 = NULL;
+    astro_time_t *t2 = NULL;
+    astro_func_result_t *probe = NULL;
+    astro_search_result_t *found = NULL;
+    astro_status_t status;
+    double dt1, dt2;
+    int i, m;
+
+    if (count < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (count == 0)
+        return ASTRO_SUCCESS;
+
+    if (targetLon == NULL || startTime == NULL || limitDays == NULL || result == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    row = (int *) calloc((size_t)count, sizeof(int));
+    target = (double *) calloc((size_t)count, sizeof(double));
+    t1 = (astro_time_t *) calloc((size_t)count, sizeof(astro_time_t));
+    t2 = (astro_time_t *) calloc((size_t)count, sizeof(astro_time_t));
+    probe = (astro_func_result_t *) calloc((size_t)count, sizeof(astro_func_result_t));
+    found = (astro_search_result_t *) calloc((size_t)count, sizeof(astro_search_result_t));
+    if (row == NULL || target == NULL || t1 == NULL || t2 == NULL || probe == NULL || found == NULL)
     {
-        /* Search forward in time. */
-        if (ya > 0.0) ya -= 360.0;
-        est_dt = -(MEAN_SYNODIC_MONTH * ya) / 360.0;
-        dt1 = est_dt - uncertainty;
-        dt2 = est_dt + uncertainty;
-        if (dt1 > limitDays)
-            return SearchError(ASTRO_NO_MOON_QUARTER);    /* not possible for moon phase to occur within specified window (too short) */
-        if (dt2 > limitDays)
-            dt2 = limitDays;
+        status = ASTRO_OUT_OF_MEMORY;
+        goto done;
     }
-    t1 = Astronomy_AddDays(startTime, dt1);
-    t2 = Astronomy_AddDays(startTime, dt2);
-    return Astronomy_Search(moon_offset, &targetLon, t1, t2, 0.1);
+
+    /* Probe the phase at every start time to place each search window. */
+    for (i=0; i < count; ++i)
+    {
+        row[i] = i;
+        target[i] = targetLon[i];
+    }
+    moon_offset_batch(target, count, row, startTime, probe);
+
+    m = 0;
+    for (i=0; i < count; ++i)
+    {
+        if (probe[i].status != ASTRO_SUCCESS)
+        {
+            result[i] = SearchError(probe[i].status);
+            continue;
+        }
+
+        status = MoonPhaseWindow(probe[i].value, limitDays[i], &dt1, &dt2);
+        if (status != ASTRO_SUCCESS)
+        {
+            result[i] = SearchError(status);
+            continue;
+        }
+
+        row[m] = i;
+        target[m] = targetLon[i];
+        t1[m] = Astronomy_AddDays(startTime[i], dt1);
+        t2[m] = Astronomy_AddDays(startTime[i], dt2);
+        ++m;
+    }
+
+    status = Astronomy_SearchBatch(moon_offset_batch, target, m, t1, t2, 0.1, found);
+    if (status == ASTRO_SUCCESS)
+    {
+        for (i=0; i < m; ++i)
+            result[row[i]] = found[i];
+    }
+
+done:
+    free(row);
+    free(target);
+    free(t1);
+    free(t2);
+    free(probe);
+    free(found);
+    return status;
 }
 
 /**
@@ -7997,6 +11853,34 @@ astro_func_result_t Astronomy_HourAngle(astro_body_t body, astro_time_t *time, a
 
 /** @cond DOXYGEN_SKIP */
 
+/*
+    When many observers search for the same body's rise or set over the same
+    time span, their searches sample the body at many identical times:
+    the coarse RISE_SET_DT steps and the FindAscent bisection midpoints all
+    depend only on the start time. A body sample cache remembers, for recently
+    sampled times, everything about the altitude calculation that does not
+    depend on the observer: the body's geocentric position, the precession and
+    nutation rotations, and the time with its sidereal time and nutation angles
+    filled in. Each observer then only needs its own position and a few rotations.
+    Entries are indexed by a hash of the terrestrial time and replaced on collision.
+*/
+#define BODY_SAMPLE_CACHE_SIZE  256
+
+typedef struct
+{
+    astro_time_t        time;       /* time.tt is the key; NAN marks an empty entry */
+    astro_vector_t      gc;         /* geocentric J2000 position of the body */
+    astro_rotation_t    prec;       /* precession_rot(time, FROM_2000) */
+    astro_rotation_t    nut;        /* nutation_rot(&time, FROM_2000) */
+}
+body_sample_t;
+
+typedef struct
+{
+    body_sample_t   sample[BODY_SAMPLE_CACHE_SIZE];
+}
+body_sample_cache_t;
+
 typedef struct
 {
     astro_body_t        body;
@@ -8004,6 +11888,7 @@ typedef struct
     astro_observer_t    observer;
     double              body_radius_au;
     double              target_altitude;
+    body_sample_cache_t *cache;             // optional: shares body positions between searches
 }
 context_altitude_t;
 
@@ -8024,17 +11909,89 @@ int _FindAscentMaxRecursionDepth;
 
 /** @endcond */
 
+static void BodySampleCacheInit(body_sample_cache_t *cache)
+{
+    int i;
+    for (i=0; i < BODY_SAMPLE_CACHE_SIZE; ++i)
+        cache->sample[i].time.tt = NAN;     /* never equal to any time */
+}
+
+/* Finds or calculates the observer-independent part of altitude_diff at the given time. */
+static const body_sample_t *BodySample(body_sample_cache_t *cache, astro_body_t body, astro_time_t time)
+{
+    uint64_t bits;
+    body_sample_t *sample;
+
+    memcpy(&bits, &time.tt, sizeof(bits));
+    bits ^= bits >> 29;
+    bits *= UINT64_C(0x9e3779b97f4a7c15);
+    sample = &cache->sample[bits >> 56];
+
+    if (sample->time.tt != time.tt)
+    {
+        /* Fill in the same cached values that geo_pos stores in the time before Astronomy_Equator uses it. */
+        Astronomy_SiderealTime(&time);
+        sample->prec = precession_rot(time, FROM_2000);
+        sample->nut = nutation_rot(&time, FROM_2000);
+        sample->gc = Astronomy_GeoVector(body, time, ABERRATION);
+        sample->time = time;
+    }
+
+    return sample;
+}
+
+/* Calculates the topocentric equatorial coordinates of date, like Astronomy_Equator, from a cached sample. */
+static astro_equatorial_t BodySampleEquator(const body_sample_t *sample, astro_observer_t observer)
+{
+    astro_rotation_t inverse;
+    double pos1[3], pos2[3];
+    double gc_observer[3];
+    double j2000[3];
+    double temp[3];
+    double datevect[3];
+
+    if (sample->gc.status != ASTRO_SUCCESS)
+        return EquError(sample->gc.status);
+
+    /* Calculate the geocentric location of the observer, as geo_pos does. */
+    terra(observer, sample->time.st, pos1, NULL);
+    inverse = Astronomy_InverseRotation(sample->nut);
+    rotate(pos1, inverse.rot, pos2);
+    inverse = Astronomy_InverseRotation(sample->prec);
+    rotate(pos2, inverse.rot, gc_observer);
+
+    /* Convert geocentric coordinates to topocentric coordinates. */
+    j2000[0] = sample->gc.x - gc_observer[0];
+    j2000[1] = sample->gc.y - gc_observer[1];
+    j2000[2] = sample->gc.z - gc_observer[2];
+
+    /* Convert to the true equator of date. */
+    rotate(j2000, sample->prec.rot, temp);
+    rotate(temp, sample->nut.rot, datevect);
+    return vector2radec(datevect, sample->time);
+}
+
 static astro_func_result_t altitude_diff(void *context, astro_time_t time)
 {
     astro_func_result_t result;
     astro_equatorial_t ofdate;
     astro_horizon_t hor;
+    const body_sample_t *sample;
     double altitude;
     const context_altitude_t *p = (const context_altitude_t *)context;
 
     ++_AltitudeDiffCallCount;   /* for internal performance testing */
 
-    ofdate = Astronomy_Equator(p->body, &time, p->observer, EQUATOR_OF_DATE, ABERRATION);
+    if (p->cache != NULL)
+    {
+        sample = BodySample(p->cache, p->body, time);
+        time = sample->time;
+        ofdate = BodySampleEquator(sample, p->observer);
+    }
+    else
+    {
+        ofdate = Astronomy_Equator(p->body, &time, p->observer, EQUATOR_OF_DATE, ABERRATION);
+    }
     if (ofdate.status != ASTRO_SUCCESS)
         return FuncError(ofdate.status);
 
@@ -8254,7 +12211,8 @@ static astro_search_result_t InternalSearchAltitude(
     astro_time_t startTime,
     double limitDays,
     double bodyRadiusAu,
-    double targetAltitude)
+    double targetAltitude,
+    body_sample_cache_t *cache)
 {
     astro_search_result_t search_result;
     astro_func_result_t func_result;
@@ -8276,6 +12234,7 @@ static astro_search_result_t InternalSearchAltitude(
     context.observer = observer;
     context.body_radius_au = bodyRadiusAu;
     context.target_altitude = targetAltitude;
+    context.cache = cache;
 
     /* We allow searching forward or backward in time. */
     /* But we want to keep t1 < t2, so we need a few if/else statements. */
@@ -8463,6 +12422,41 @@ static double HorizonDipAngle(
 
 
 
+/* Calculates the body's radius and the altitude its top edge must cross to rise or set. */
+static astro_status_t RiseSetAltitude(
+    astro_body_t body,
+    astro_observer_t observer,
+    double metersAboveGround,
+    double *body_radius_au,
+    double *altitude)
+{
+    double dip;
+    astro_atmosphere_t atmos;
+
+    if (!isfinite(metersAboveGround) || (metersAboveGround < 0.0))
+        return ASTRO_INVALID_PARAMETER;
+
+    switch (body)
+    {
+    case BODY_SUN:  *body_radius_au = SUN_RADIUS_AU;                 break;
+    case BODY_MOON: *body_radius_au = MOON_EQUATORIAL_RADIUS_AU;     break;
+    default:        *body_radius_au = 0.0;                           break;
+    }
+
+    /* Calculate atmospheric density at ground level. */
+    atmos = Astronomy_Atmosphere(observer.height - metersAboveGround);
+    if (atmos.status != ASTRO_SUCCESS)
+        return atmos.status;
+
+    /* Calculate the apparent angular dip of the horizon. */
+    dip = HorizonDipAngle(observer, metersAboveGround);
+
+    /* Correct refraction for objects near the horizon, using atmospheric density at the ground. */
+    *altitude = dip - (REFRACTION_NEAR_HORIZON * atmos.density);
+    return ASTRO_SUCCESS;
+}
+
+
 /**
  * @brief Searches for the next time a celestial body rises or sets as seen by an observer on the Earth.
  *
@@ -8533,33 +12527,104 @@ astro_search_result_t Astronomy_SearchRiseSetEx(
     double limitDays,
     double metersAboveGround)
 {
-    double altitude, dip;
-    double body_radius_au;
-    astro_atmosphere_t atmos;
+    astro_status_t status;
+    double altitude, body_radius_au;
 
-    if (!isfinite(metersAboveGround) || (metersAboveGround < 0.0))
-        return SearchError(ASTRO_INVALID_PARAMETER);
+    status = RiseSetAltitude(body, observer, metersAboveGround, &body_radius_au, &altitude);
+    if (status != ASTRO_SUCCESS)
+        return SearchError(status);
 
-    switch (body)
-    {
-    case BODY_SUN:  body_radius_au = SUN_RADIUS_AU;                 break;
-    case BODY_MOON: body_radius_au = MOON_EQUATORIAL_RADIUS_AU;     break;
-    default:        body_radius_au = 0.0;                           break;
-    }
+    /* Search for the top of the body crossing the corrected altitude angle. */
+    return InternalSearchAltitude(body, observer, direction, startTime, limitDays, body_radius_au, altitude, NULL);
+}
 
-    /* Calculate atmospheric density at ground level. */
-    atmos = Astronomy_Atmosphere(observer.height - metersAboveGround);
-    if (atmos.status != ASTRO_SUCCESS)
-        return SearchError(atmos.status);
 
-    /* Calculate the apparent angular dip of the horizon. */
-    dip = HorizonDipAngle(observer, metersAboveGround);
+/**
+ * @brief Finds rise or set times of a body for many observers and start times.
+ *
+ * Fills `result[i*observerCount + k]` with the same result as
+ * `Astronomy_SearchRiseSetEx(body, observer[k], direction, startTime[i], limitDays, metersAboveGround)`
+ * for every start time `i` and observer `k`. For example, passing the midnight
+ * of each day of a year as `startTime` and 1 as `limitDays` produces a year-long
+ * table of rise or set times for every observer.
+ *
+ * This is faster than calling #Astronomy_SearchRiseSetEx in a loop because the
+ * searches for different observers from the same start time evaluate the body
+ * at many of the same instants. The body's geocentric position, precession,
+ * nutation and sidereal time at those instants are calculated once and shared
+ * by all the observers, so each extra observer costs only its own rotations.
+ *
+ * @param body
+ *      The Sun, Moon, any planet other than the Earth,
+ *      or a user-defined star that was created by a call to #Astronomy_DefineStar.
+ * @param direction
+ *      Either `DIRECTION_RISE` to find rise times or `DIRECTION_SET` to find set times.
+ * @param startCount
+ *      The number of times in `startTime`.
+ * @param startTime
+ *      The times at which to start searching.
+ * @param observerCount
+ *      The number of observers in `observer`.
+ * @param observer
+ *      The locations where observation takes place.
+ * @param limitDays
+ *      Limits how many days after (or before, if negative) each start time to search;
+ *      see #Astronomy_SearchRiseSetEx.
+ * @param metersAboveGround
+ *      How far above the ground the observers are; see #Astronomy_SearchRiseSetEx.
+ * @param result
+ *      An array of `startCount * observerCount` search results.
+ *      As with #Astronomy_SearchRiseSetEx, a `status` of `ASTRO_SEARCH_FAILURE`
+ *      means the event does not occur within `limitDays`.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `result` was filled in,
+ *      `ASTRO_INVALID_PARAMETER` if a count is negative or an array is missing,
+ *      or `ASTRO_OUT_OF_MEMORY` if the shared sample buffer could not be allocated.
+ */
+astro_status_t Astronomy_SearchRiseSetGrid(
+    astro_body_t body,
+    astro_direction_t direction,
+    int startCount,
+    const astro_time_t *startTime,
+    int observerCount,
+    const astro_observer_t *observer,
+    double limitDays,
+    double metersAboveGround,
+    astro_search_result_t *result)
+{
+    body_sample_cache_t *cache;
+    astro_search_result_t *row;
+    astro_status_t status;
+    double altitude, body_radius_au;
+    int i, k;
 
-    /* Correct refraction for objects near the horizon, using atmospheric density at the ground. */
-    altitude = dip - (REFRACTION_NEAR_HORIZON * atmos.density);
+    if (startCount < 0 || observerCount < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (startCount > 0 && observerCount > 0 && (startTime == NULL || observer == NULL || result == NULL))
+        return ASTRO_INVALID_PARAMETER;
+
+    cache = (body_sample_cache_t *) malloc(sizeof(body_sample_cache_t));
+    if (cache == NULL)
+        return ASTRO_OUT_OF_MEMORY;
+
+    BodySampleCacheInit(cache);
+    for (i=0; i < startCount; ++i)
+    {
+        row = result + (size_t)i*observerCount;
+        for (k=0; k < observerCount; ++k)
+        {
+            status = RiseSetAltitude(body, observer[k], metersAboveGround, &body_radius_au, &altitude);
+            if (status != ASTRO_SUCCESS)
+                row[k] = SearchError(status);
+            else
+                row[k] = InternalSearchAltitude(body, observer[k], direction, startTime[i], limitDays, body_radius_au, altitude, cache);
+        }
+    }
 
-    /* Search for the top of the body crossing the corrected altitude angle. */
-    return InternalSearchAltitude(body, observer, direction, startTime, limitDays, body_radius_au, altitude);
+    free(cache);
+    return ASTRO_SUCCESS;
 }
 
 
@@ -8641,7 +12706,7 @@ astro_search_result_t Astronomy_SearchAltitude(
     double limitDays,
     double altitude)
 {
-    return InternalSearchAltitude(body, observer, direction, startTime, limitDays, 0.0, altitude);
+    return InternalSearchAltitude(body, observer, direction, startTime, limitDays, 0.0, altitude, NULL);
 }
 
 
@@ -11212,6 +15277,266 @@ static const constel_boundary_t ConstelBounds[] = {
 
 #define NUM_CONSTEL_BOUNDARIES  357
 
+/** @cond DOXYGEN_SKIP */
+#define CONSTEL_RA_LIMIT  8640.0    /* 24 hours of RA in the compact units of ConstelBounds */
+
+/*
+    A spatial index over ConstelBounds. The distinct `dec_lo` values split the
+    sky into declination bands. Within a band the same boundaries qualify for
+    every point, so the first matching boundary depends only on RA; each band
+    stores that answer as a sorted list of RA segments. A lookup is then two
+    binary searches, and gives exactly the result of the linear scan.
+*/
+typedef struct
+{
+    double  rot[3][3];                          /* J2000 to B1875 precession matrix */
+    int     nbands;
+    double  band_dec[NUM_CONSTEL_BOUNDARIES];   /* lowest declination of each band, descending */
+    int     band_first[NUM_CONSTEL_BOUNDARIES + 1];    /* first segment of each band */
+    double *seg_ra;                             /* RA where each segment begins */
+    int    *seg_index;                          /* constellation covering each segment */
+}
+constel_index_t;
+/** @endcond */
+
+/* The index is built on first use and published atomically, like the Delta T table. */
+static void *constel_index;
+
+static int CompareDoubles(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da < db) ? -1 : (da > db);
+}
+
+/*
+    Splits [0, 24h) of RA into segments covered by a single constellation
+    for points at declination `dec_lo` (which must be one of the table's `dec_lo` values).
+    Returns the number of segments. With NULL arrays the segments are only counted.
+*/
+static int ConstelBandSegments(double dec_lo, double *seg_ra, int *seg_index)
+{
+    double edge[2*NUM_CONSTEL_BOUNDARIES + 2];
+    int nedge, nseg, last, c, i, k;
+
+    nedge = 0;
+    edge[nedge++] = 0.0;
+    edge[nedge++] = CONSTEL_RA_LIMIT;
+    for (i=0; i < NUM_CONSTEL_BOUNDARIES; ++i)
+    {
+        if (ConstelBounds[i].dec_lo <= dec_lo)
+        {
+            edge[nedge++] = ConstelBounds[i].ra_lo;
+            edge[nedge++] = ConstelBounds[i].ra_hi;
+        }
+    }
+    qsort(edge, nedge, sizeof(double), CompareDoubles);
+
+    nseg = 0;
+    last = -2;
+    for (k=0; k+1 < nedge; ++k)
+    {
+        if (edge[k] == edge[k+1] || edge[k] < 0.0 || edge[k] >= CONSTEL_RA_LIMIT)
+            continue;
+
+        /* Every edge is a breakpoint, so one boundary covers all of [edge[k], edge[k+1]) or none of it. */
+        c = -1;
+        for (i=0; i < NUM_CONSTEL_BOUNDARIES; ++i)
+        {
+            const constel_boundary_t *b = &ConstelBounds[i];
+            if ((b->dec_lo <= dec_lo) && (b->ra_lo <= edge[k]) && (b->ra_hi >= edge[k+1]))
+            {
+                c = b->index;
+                break;
+            }
+        }
+
+        if (c != last)
+        {
+            if (seg_ra != NULL)
+            {
+                seg_ra[nseg] = edge[k];
+                seg_index[nseg] = c;
+            }
+            ++nseg;
+            last = c;
+        }
+    }
+    return nseg;
+}
+
+static void ConstelIndexFree(constel_index_t *index)
+{
+    if (index != NULL)
+    {
+        free(index->seg_ra);
+        free(index->seg_index);
+        free(index);
+    }
+}
+
+static astro_status_t ConstelIndex(const constel_index_t **result)
+{
+    constel_index_t *index;
+    astro_rotation_t rot;
+    astro_time_t time;
+    int i, k, nseg;
+
+    index = (constel_index_t *) AtomicLoadPtr(&constel_index);
+    if (index != NULL)
+    {
+        *result = index;
+        return ASTRO_SUCCESS;
+    }
+
+    /*
+        Need to calculate the B1875 epoch. Based on this:
+        https://en.wikipedia.org/wiki/Epoch_(astronomy)#Besselian_years
+        B = 1900 + (JD - 2415020.31352) / 365.242198781
+        I'm interested in using TT instead of JD, giving:
+        B = 1900 + ((TT+2451545) - 2415020.31352) / 365.242198781
+        B = 1900 + (TT + 36524.68648) / 365.242198781
+        TT = 365.242198781*(B - 1900) - 36524.68648 = -45655.741449525
+        But Astronomy_TimeFromDays() wants UT, not TT.
+        Near that date, I get a historical correction of ut-tt = 3.2 seconds.
+        That gives UT = -45655.74141261017 for the B1875 epoch,
+        or 1874-12-31T18:12:21.950Z.
+    */
+    time = Astronomy_TimeFromDays(-45655.74141261017);
+    rot = Astronomy_Rotation_EQJ_EQD(&time);
+    if (rot.status != ASTRO_SUCCESS)
+        return rot.status;
+
+    index = (constel_index_t *) calloc(1, sizeof(constel_index_t));
+    if (index == NULL)
+        return ASTRO_OUT_OF_MEMORY;
+    memcpy(index->rot, rot.rot, sizeof(index->rot));
+
+    /* ConstelBounds is sorted by descending `dec_lo`, so the bands come out in order. */
+    nseg = 0;
+    for (i=0; i < NUM_CONSTEL_BOUNDARIES; ++i)
+    {
+        if (index->nbands == 0 || ConstelBounds[i].dec_lo != index->band_dec[index->nbands - 1])
+        {
+            index->band_dec[index->nbands] = ConstelBounds[i].dec_lo;
+            index->band_first[index->nbands] = nseg;
+            nseg += ConstelBandSegments(ConstelBounds[i].dec_lo, NULL, NULL);
+            ++index->nbands;
+        }
+    }
+    index->band_first[index->nbands] = nseg;
+
+    index->seg_ra = (double *) malloc(nseg * sizeof(double));
+    index->seg_index = (int *) malloc(nseg * sizeof(int));
+    if (index->seg_ra == NULL || index->seg_index == NULL)
+    {
+        ConstelIndexFree(index);
+        return ASTRO_OUT_OF_MEMORY;
+    }
+
+    for (k=0; k < index->nbands; ++k)
+    {
+        ConstelBandSegments(
+            index->band_dec[k],
+            index->seg_ra + index->band_first[k],
+            index->seg_index + index->band_first[k]);
+    }
+
+    if (!AtomicPublishPtr(&constel_index, index))
+    {
+        ConstelIndexFree(index);
+        index = (constel_index_t *) AtomicLoadPtr(&constel_index);
+    }
+    *result = index;
+    return ASTRO_SUCCESS;
+}
+
+/*
+    Precesses J2000 equatorial coordinates to B1875. This is the arithmetic of
+    Astronomy_VectorFromSphere, Astronomy_RotateVector and Astronomy_EquatorFromVector
+    applied to raw doubles, so the results are identical.
+*/
+static astro_status_t ConstelB1875(const constel_index_t *index, double ra, double dec, double *ra_1875, double *dec_1875)
+{
+    double radlat, radlon, rcoslat, x, y, z, bx, by, bz, xyproj, lon;
+
+    radlat = dec * DEG2RAD;
+    radlon = (ra * 15.0) * DEG2RAD;
+    rcoslat = cos(radlat);
+    x = rcoslat * cos(radlon);
+    y = rcoslat * sin(radlon);
+    z = sin(radlat);
+
+    bx = index->rot[0][0]*x + index->rot[1][0]*y + index->rot[2][0]*z;
+    by = index->rot[0][1]*x + index->rot[1][1]*y + index->rot[2][1]*z;
+    bz = index->rot[0][2]*x + index->rot[1][2]*y + index->rot[2][2]*z;
+
+    xyproj = bx*bx + by*by;
+    if (xyproj == 0.0)
+    {
+        if (bz == 0.0)
+            return ASTRO_INVALID_PARAMETER;
+        *ra_1875 = 0.0;
+        *dec_1875 = (bz < 0.0) ? -90.0 : +90.0;
+    }
+    else
+    {
+        lon = RAD2DEG * atan2(by, bx);
+        if (lon < 0.0)
+            lon += 360.0;
+        *ra_1875 = lon / 15.0;
+        *dec_1875 = RAD2DEG * atan2(bz, sqrt(xyproj));
+    }
+    return ASTRO_SUCCESS;
+}
+
+/* Returns the constellation containing B1875 coordinates, or -1 if none does. */
+static int ConstelLookup(const constel_index_t *index, double ra_1875, double dec_1875)
+{
+    double x_ra, x_dec;
+    int lo, hi, mid;
+
+    /* Convert DEC from degrees, and RA from hours, to compact angle units used in the ConstelBounds table. */
+    x_ra = (24.0 * 15.0) * ra_1875;
+    x_dec = 24.0 * dec_1875;
+
+    if (!(x_ra >= 0.0 && x_ra < CONSTEL_RA_LIMIT) || !(x_dec >= index->band_dec[index->nbands - 1]))
+        return -1;
+
+    /* Find the first band whose lower declination is at or below the point. */
+    lo = 0;
+    hi = index->nbands - 1;
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        if (index->band_dec[mid] <= x_dec)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    /* Find the last segment of that band that begins at or before the point. */
+    hi = index->band_first[lo + 1] - 1;
+    lo = index->band_first[lo];
+    while (lo < hi)
+    {
+        mid = (lo + hi + 1) / 2;
+        if (index->seg_ra[mid] <= x_ra)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return index->seg_index[lo];
+}
+
+/* Allow right ascension to "wrap around". Clamp to [0, 24) sidereal hours. */
+static double ConstelWrapRA(double ra)
+{
+    ra = fmod(ra, 24.0);
+    if (ra < 0.0)
+        ra += 24.0;
+    return ra;
+}
 
 
 /**
@@ -11234,92 +15559,156 @@ static const constel_boundary_t ConstelBounds[] = {
  */
 astro_constellation_t Astronomy_Constellation(double ra, double dec)
 {
-    static astro_time_t epoch2000;
-    static astro_rotation_t rot = { ASTRO_NOT_INITIALIZED };
+    const constel_index_t *index;
     astro_constellation_t constel;
-    astro_spherical_t s2000;
-    astro_equatorial_t b1875;
-    astro_vector_t vec2000, vec1875;
-    double x_ra, x_dec;
-    int i, c;
+    astro_status_t status;
+    double ra_1875, dec_1875;
+    int c;
 
     if (dec < -90.0 || dec > +90.0)
         return ConstelErr(ASTRO_INVALID_PARAMETER);
 
-    /* Allow right ascension to "wrap around". Clamp to [0, 24) sidereal hours. */
-    ra = fmod(ra, 24.0);
-    if (ra < 0.0)
-        ra += 24.0;
-
-    /* Lazy-initialize the rotation matrix for converting J2000 to B1875. */
-    if (rot.status != ASTRO_SUCCESS)
-    {
-        /*
-            Need to calculate the B1875 epoch. Based on this:
-            https://en.wikipedia.org/wiki/Epoch_(astronomy)#Besselian_years
-            B = 1900 + (JD - 2415020.31352) / 365.242198781
-            I'm interested in using TT instead of JD, giving:
-            B = 1900 + ((TT+2451545) - 2415020.31352) / 365.242198781
-            B = 1900 + (TT + 36524.68648) / 365.242198781
-            TT = 365.242198781*(B - 1900) - 36524.68648 = -45655.741449525
-            But Astronomy_TimeFromDays() wants UT, not TT.
-            Near that date, I get a historical correction of ut-tt = 3.2 seconds.
-            That gives UT = -45655.74141261017 for the B1875 epoch,
-            or 1874-12-31T18:12:21.950Z.
-        */
-        astro_time_t time = Astronomy_TimeFromDays(-45655.74141261017);
-        rot = Astronomy_Rotation_EQJ_EQD(&time);
-        if (rot.status != ASTRO_SUCCESS)
-            return ConstelErr(rot.status);
-
-        epoch2000 = Astronomy_TimeFromDays(0.0);
-    }
+    status = ConstelIndex(&index);
+    if (status != ASTRO_SUCCESS)
+        return ConstelErr(status);
 
     /* Convert coordinates from J2000 to year 1875. */
-    s2000.status = ASTRO_SUCCESS;
-    s2000.lon = ra * 15.0;
-    s2000.lat = dec;
-    s2000.dist = 1.0;
-    vec2000 = Astronomy_VectorFromSphere(s2000, epoch2000);
-    if (vec2000.status != ASTRO_SUCCESS)
-        return ConstelErr(vec2000.status);
-
-    vec1875 = Astronomy_RotateVector(rot, vec2000);
-    if (vec1875.status != ASTRO_SUCCESS)
-        return ConstelErr(vec1875.status);
-
-    b1875 = Astronomy_EquatorFromVector(vec1875);
-    if (b1875.status != ASTRO_SUCCESS)
-        return ConstelErr(b1875.status);
-
-    /* Convert DEC from degrees, and RA from hours, to compact angle units used in the ContelBounds table. */
-    x_ra = (24.0 * 15.0) * b1875.ra;
-    x_dec = 24.0 * b1875.dec;
+    status = ConstelB1875(index, ConstelWrapRA(ra), dec, &ra_1875, &dec_1875);
+    if (status != ASTRO_SUCCESS)
+        return ConstelErr(status);
 
     /* Search for the constellation using the B1875 coordinates. */
-    c = -1;     /* constellation not (yet) found */
-    for (i=0; i < NUM_CONSTEL_BOUNDARIES; ++i)
-    {
-        const constel_boundary_t *b = &ConstelBounds[i];
-        if ((b->dec_lo <= x_dec) && (b->ra_hi > x_ra) && (b->ra_lo <= x_ra))
-        {
-            c = b->index;
-            break;
-        }
-    }
-
+    c = ConstelLookup(index, ra_1875, dec_1875);
     if (c < 0 || c >= NUM_CONSTELLATIONS)
         return ConstelErr(ASTRO_INTERNAL_ERROR);    /* should have been able to find the constellation */
 
     constel.status = ASTRO_SUCCESS;
     constel.symbol = ConstelInfo[c].symbol;
     constel.name = ConstelInfo[c].name;
-    constel.ra_1875 = b1875.ra;
-    constel.dec_1875 = b1875.dec;
+    constel.ra_1875 = ra_1875;
+    constel.dec_1875 = dec_1875;
     return constel;
 }
 
 
+/**
+ * @brief
+ *      Determines the constellations that contain many points in the sky.
+ *
+ * This is #Astronomy_Constellation applied to arrays of J2000 coordinates.
+ * Instead of names, the constellations are reported as indexes into the
+ * table of 88 constellations; see #Astronomy_ConstellationSymbol and
+ * #Astronomy_ConstellationName. The precession matrix and the boundary index
+ * are shared by all the points, so each point costs one rotation and two
+ * binary searches.
+ *
+ * @param count
+ *      The number of points.
+ *
+ * @param ra
+ *      An array of `count` J2000 right ascensions in sidereal hours.
+ *
+ * @param dec
+ *      An array of `count` J2000 declinations in degrees.
+ *
+ * @param index
+ *      An array of `count` integers that receives the index of each point's
+ *      constellation, in the range 0 to 87. It receives -1 where the
+ *      declination is outside [-90, +90] or a coordinate is not a number.
+ *
+ * @param ra_1875
+ *      An array of `count` B1875 right ascensions in sidereal hours, or NULL.
+ *      Receives `NAN` wherever `index` receives -1.
+ *
+ * @param dec_1875
+ *      An array of `count` B1875 declinations in degrees, or NULL.
+ *      Receives `NAN` wherever `index` receives -1.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` once every point has been looked up,
+ *      `ASTRO_INVALID_PARAMETER` if `count` is negative,
+ *      or `ASTRO_OUT_OF_MEMORY` if the index could not be built.
+ */
+astro_status_t Astronomy_ConstellationBatch(
+    int count,
+    const double *ra,
+    const double *dec,
+    int *index,
+    double *ra_1875,
+    double *dec_1875)
+{
+    const constel_index_t *table;
+    astro_status_t status;
+    double b_ra, b_dec;
+    int i, c;
+
+    if (count < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (count == 0)
+        return ASTRO_SUCCESS;
+
+    status = ConstelIndex(&table);
+    if (status != ASTRO_SUCCESS)
+        return status;
+
+    for (i=0; i < count; ++i)
+    {
+        c = -1;
+        b_ra = b_dec = NAN;
+        if (dec[i] >= -90.0 && dec[i] <= +90.0)
+        {
+            if (ConstelB1875(table, ConstelWrapRA(ra[i]), dec[i], &b_ra, &b_dec) == ASTRO_SUCCESS)
+                c = ConstelLookup(table, b_ra, b_dec);
+            if (c < 0)
+                b_ra = b_dec = NAN;
+        }
+
+        index[i] = c;
+        if (ra_1875 != NULL)
+            ra_1875[i] = b_ra;
+        if (dec_1875 != NULL)
+            dec_1875[i] = b_dec;
+    }
+    return ASTRO_SUCCESS;
+}
+
+
+/**
+ * @brief Returns the 3-character symbol of a constellation, like "Ori".
+ *
+ * @param index
+ *      A constellation index from 0 to 87, as reported by #Astronomy_ConstellationBatch.
+ *      The constellations are numbered in alphabetical order of their symbols.
+ *
+ * @return
+ *      The symbol, or an empty string if `index` is out of range.
+ */
+const char *Astronomy_ConstellationSymbol(int index)
+{
+    if (index < 0 || index >= NUM_CONSTELLATIONS)
+        return "";
+    return ConstelInfo[index].symbol;
+}
+
+
+/**
+ * @brief Returns the full name of a constellation, like "Orion".
+ *
+ * @param index
+ *      A constellation index from 0 to 87, as reported by #Astronomy_ConstellationBatch.
+ *
+ * @return
+ *      The name, or an empty string if `index` is out of range.
+ */
+const char *Astronomy_ConstellationName(int index)
+{
+    if (index < 0 || index >= NUM_CONSTELLATIONS)
+        return "";
+    return ConstelInfo[index].name;
+}
+
+
 static astro_lunar_eclipse_t LunarEclipseError(astro_status_t status)
 {
     astro_lunar_eclipse_t eclipse;
@@ -11691,6 +16080,70 @@ static double ShadowSemiDurationMinutes(astro_time_t center_time, double radius_
 }
 
 
+/*
+    Determines whether there is a lunar eclipse at the full moon at `fullmoon`.
+    Returns `kind` = ECLIPSE_NONE with `status` = ASTRO_SUCCESS if there is none.
+*/
+static astro_lunar_eclipse_t LunarEclipseAtFullMoon(astro_time_t fullmoon)
+{
+    const double PruneLatitude = 1.8;   /* full Moon's ecliptic latitude above which eclipse is impossible */
+    astro_lunar_eclipse_t eclipse;
+    shadow_t shadow;
+    double eclip_lat, eclip_lon, distance;
+
+    eclipse = LunarEclipseError(ASTRO_SUCCESS);
+
+    /* Pruning: if the full Moon's ecliptic latitude is too large, a lunar eclipse is not possible. */
+    CalcMoon(fullmoon.tt / 36525.0, &eclip_lon, &eclip_lat, &distance);
+    if (RAD2DEG * fabs(eclip_lat) < PruneLatitude)
+    {
+        /* Search near the full moon for the time when the center of the Moon */
+        /* is closest to the line passing through the centers of the Sun and Earth. */
+        shadow = PeakEarthShadow(fullmoon);
+        if (shadow.status != ASTRO_SUCCESS)
+            return LunarEclipseError(shadow.status);
+
+        if (shadow.r < shadow.p + MOON_MEAN_RADIUS_KM)
+        {
+            /* This is at least a penumbral eclipse. We will return a result. */
+            eclipse.status = ASTRO_SUCCESS;
+            eclipse.kind = ECLIPSE_PENUMBRAL;
+            eclipse.obscuration = 0.0;
+            eclipse.peak = shadow.time;
+            eclipse.sd_total = 0.0;
+            eclipse.sd_partial = 0.0;
+            eclipse.sd_penum = ShadowSemiDurationMinutes(shadow.time, shadow.p + MOON_MEAN_RADIUS_KM, 200.0);
+            if (eclipse.sd_penum <= 0.0)
+                return LunarEclipseError(ASTRO_SEARCH_FAILURE);
+
+            if (shadow.r < shadow.k + MOON_MEAN_RADIUS_KM)
+            {
+                /* This is at least a partial eclipse. */
+                eclipse.kind = ECLIPSE_PARTIAL;
+                eclipse.sd_partial = ShadowSemiDurationMinutes(shadow.time, shadow.k + MOON_MEAN_RADIUS_KM, eclipse.sd_penum);
+                if (eclipse.sd_partial <= 0.0)
+                    return LunarEclipseError(ASTRO_SEARCH_FAILURE);
+
+                if (shadow.r + MOON_MEAN_RADIUS_KM < shadow.k)
+                {
+                    /* This is a total eclipse. */
+                    eclipse.kind = ECLIPSE_TOTAL;
+                    eclipse.obscuration = 1.0;
+                    eclipse.sd_total = ShadowSemiDurationMinutes(shadow.time, shadow.k - MOON_MEAN_RADIUS_KM, eclipse.sd_partial);
+                    if (eclipse.sd_total <= 0.0)
+                        return LunarEclipseError(ASTRO_SEARCH_FAILURE);
+                }
+                else
+                {
+                    /* For lunar eclipses, we calculate the fraction of the Moon's disc covered by the Earth's umbra. */
+                    eclipse.obscuration = Obscuration(MOON_MEAN_RADIUS_KM, shadow.k, shadow.r);
+                }
+            }
+        }
+    }
+    return eclipse;
+}
+
 /**
  * @brief Searches for a lunar eclipse.
  *
@@ -11711,13 +16164,10 @@ static double ShadowSemiDurationMinutes(astro_time_t center_time, double radius_
  */
 astro_lunar_eclipse_t Astronomy_SearchLunarEclipse(astro_time_t startTime)
 {
-    const double PruneLatitude = 1.8;   /* full Moon's ecliptic latitude above which eclipse is impossible */
     astro_time_t fmtime;
     astro_lunar_eclipse_t eclipse;
     astro_search_result_t fullmoon;
-    shadow_t shadow;
     int fmcount;
-    double eclip_lat, eclip_lon, distance;
 
     /* Iterate through consecutive full moons until we find any kind of lunar eclipse. */
     fmtime = startTime;
@@ -11728,55 +16178,9 @@ astro_lunar_eclipse_t Astronomy_SearchLunarEclipse(astro_time_t startTime)
         if (fullmoon.status != ASTRO_SUCCESS)
             return LunarEclipseError(fullmoon.status);
 
-        /* Pruning: if the full Moon's ecliptic latitude is too large, a lunar eclipse is not possible. */
-        CalcMoon(fullmoon.time.tt / 36525.0, &eclip_lon, &eclip_lat, &distance);
-        if (RAD2DEG * fabs(eclip_lat) < PruneLatitude)
-        {
-            /* Search near the full moon for the time when the center of the Moon */
-            /* is closest to the line passing through the centers of the Sun and Earth. */
-            shadow = PeakEarthShadow(fullmoon.time);
-            if (shadow.status != ASTRO_SUCCESS)
-                return LunarEclipseError(shadow.status);
-
-            if (shadow.r < shadow.p + MOON_MEAN_RADIUS_KM)
-            {
-                /* This is at least a penumbral eclipse. We will return a result. */
-                eclipse.status = ASTRO_SUCCESS;
-                eclipse.kind = ECLIPSE_PENUMBRAL;
-                eclipse.obscuration = 0.0;
-                eclipse.peak = shadow.time;
-                eclipse.sd_total = 0.0;
-                eclipse.sd_partial = 0.0;
-                eclipse.sd_penum = ShadowSemiDurationMinutes(shadow.time, shadow.p + MOON_MEAN_RADIUS_KM, 200.0);
-                if (eclipse.sd_penum <= 0.0)
-                    return LunarEclipseError(ASTRO_SEARCH_FAILURE);
-
-                if (shadow.r < shadow.k + MOON_MEAN_RADIUS_KM)
-                {
-                    /* This is at least a partial eclipse. */
-                    eclipse.kind = ECLIPSE_PARTIAL;
-                    eclipse.sd_partial = ShadowSemiDurationMinutes(shadow.time, shadow.k + MOON_MEAN_RADIUS_KM, eclipse.sd_penum);
-                    if (eclipse.sd_partial <= 0.0)
-                        return LunarEclipseError(ASTRO_SEARCH_FAILURE);
-
-                    if (shadow.r + MOON_MEAN_RADIUS_KM < shadow.k)
-                    {
-                        /* This is a total eclipse. */
-                        eclipse.kind = ECLIPSE_TOTAL;
-                        eclipse.obscuration = 1.0;
-                        eclipse.sd_total = ShadowSemiDurationMinutes(shadow.time, shadow.k - MOON_MEAN_RADIUS_KM, eclipse.sd_partial);
-                        if (eclipse.sd_total <= 0.0)
-                            return LunarEclipseError(ASTRO_SEARCH_FAILURE);
-                    }
-                    else
-                    {
-                        /* For lunar eclipses, we calculate the fraction of the Moon's disc covered by the Earth's umbra. */
-                        eclipse.obscuration = Obscuration(MOON_MEAN_RADIUS_KM, shadow.k, shadow.r);
-                    }
-                }
-                return eclipse;
-            }
-        }
+        eclipse = LunarEclipseAtFullMoon(fullmoon.time);
+        if (eclipse.status != ASTRO_SUCCESS || eclipse.kind != ECLIPSE_NONE)
+            return eclipse;
 
         /* We didn't find an eclipse on this full moon, so search for the next one. */
         fmtime = Astronomy_AddDays(fullmoon.time, 10.0);
@@ -11994,11 +16398,42 @@ static astro_global_solar_eclipse_t GeoidIntersect(shadow_t shadow)
         /* Anyone who wants obscuration should use Astronomy_SearchLocalSolarEclipse for a specific location on the Earth. */
         eclipse.obscuration = NAN;
     }
-
-    return eclipse;
+
+    return eclipse;
+}
+
+
+/*
+    Determines whether there is a solar eclipse visible anywhere on the Earth
+    at the new moon at `newmoon`.
+    Returns `kind` = ECLIPSE_NONE with `status` = ASTRO_SUCCESS if there is none.
+*/
+static astro_global_solar_eclipse_t GlobalSolarEclipseAtNewMoon(astro_time_t newmoon)
+{
+    const double PruneLatitude = 1.8;   /* Moon's ecliptic latitude beyond which eclipse is impossible */
+    shadow_t shadow;
+    double eclip_lat, eclip_lon, distance;
+
+    /* Pruning: if the new moon's ecliptic latitude is too large, a solar eclipse is not possible. */
+    CalcMoon(newmoon.tt / 36525.0, &eclip_lon, &eclip_lat, &distance);
+    if (RAD2DEG * fabs(eclip_lat) < PruneLatitude)
+    {
+        /* Search near the new moon for the time when the center of the Earth */
+        /* is closest to the line passing through the centers of the Sun and Moon. */
+        shadow = PeakMoonShadow(newmoon);
+        if (shadow.status != ASTRO_SUCCESS)
+            return GlobalSolarEclipseError(shadow.status);
+
+        if (shadow.r < shadow.p + EARTH_MEAN_RADIUS_KM)
+        {
+            /* This is at least a partial solar eclipse visible somewhere on Earth. */
+            /* Try to find an intersection between the shadow axis and the Earth's oblate geoid. */
+            return GeoidIntersect(shadow);
+        }
+    }
+    return GlobalSolarEclipseError(ASTRO_SUCCESS);
 }
 
-
 /**
  * @brief Searches for a solar eclipse visible anywhere on the Earth's surface.
  *
@@ -12019,12 +16454,10 @@ static astro_global_solar_eclipse_t GeoidIntersect(shadow_t shadow)
  */
 astro_global_solar_eclipse_t Astronomy_SearchGlobalSolarEclipse(astro_time_t startTime)
 {
-    const double PruneLatitude = 1.8;   /* Moon's ecliptic latitude beyond which eclipse is impossible */
     astro_time_t nmtime;
     astro_search_result_t newmoon;
-    shadow_t shadow;
+    astro_global_solar_eclipse_t eclipse;
     int nmcount;
-    double eclip_lat, eclip_lon, distance;
 
     /* Iterate through consecutive new moons until we find a solar eclipse visible somewhere on Earth. */
     nmtime = startTime;
@@ -12035,23 +16468,9 @@ astro_global_solar_eclipse_t Astronomy_SearchGlobalSolarEclipse(astro_time_t sta
         if (newmoon.status != ASTRO_SUCCESS)
             return GlobalSolarEclipseError(newmoon.status);
 
-        /* Pruning: if the new moon's ecliptic latitude is too large, a solar eclipse is not possible. */
-        CalcMoon(newmoon.time.tt / 36525.0, &eclip_lon, &eclip_lat, &distance);
-        if (RAD2DEG * fabs(eclip_lat) < PruneLatitude)
-        {
-            /* Search near the new moon for the time when the center of the Earth */
-            /* is closest to the line passing through the centers of the Sun and Moon. */
-            shadow = PeakMoonShadow(newmoon.time);
-            if (shadow.status != ASTRO_SUCCESS)
-                return GlobalSolarEclipseError(shadow.status);
-
-            if (shadow.r < shadow.p + EARTH_MEAN_RADIUS_KM)
-            {
-                /* This is at least a partial solar eclipse visible somewhere on Earth. */
-                /* Try to find an intersection between the shadow axis and the Earth's oblate geoid. */
-                return GeoidIntersect(shadow);
-            }
-        }
+        eclipse = GlobalSolarEclipseAtNewMoon(newmoon.time);
+        if (eclipse.status != ASTRO_SUCCESS || eclipse.kind != ECLIPSE_NONE)
+            return eclipse;
 
         /* We didn't find an eclipse on this new moon, so search for the next one. */
         nmtime = Astronomy_AddDays(newmoon.time, 10.0);
@@ -12114,7 +16533,102 @@ static astro_local_solar_eclipse_t LocalSolarEclipseError(astro_status_t status)
 }
 
 
-static shadow_t LocalMoonShadow(astro_time_t time, astro_observer_t observer)
+/** @cond DOXYGEN_SKIP */
+#define SHADOW_TABLE_SIZE   129             /* number of samples in a shadow table */
+#define SHADOW_TABLE_STEP   (10.0 / 1440.0) /* days between samples: 10 minutes */
+
+typedef struct
+{
+    double  tt0;                            /* terrestrial time of the first sample */
+    double  sun[SHADOW_TABLE_SIZE][3];      /* geocentric Sun with aberration correction */
+    double  moon[SHADOW_TABLE_SIZE][3];     /* geocentric Moon */
+}
+shadow_table_t;     /* Sun and Moon positions around an eclipse, shared by many observers. */
+/** @endcond */
+
+/*
+    Samples the Sun and Moon every SHADOW_TABLE_STEP days, centered on `center`.
+    The table spans +/- 0.44 days, which covers the peak and contact searches
+    of LocalEclipse for any observer when `center` is within 0.04 days of the
+    eclipse's global peak.
+*/
+static astro_status_t ShadowTableInit(shadow_table_t *table, astro_time_t center)
+{
+    astro_time_t time[SHADOW_TABLE_SIZE];
+    astro_vector_t sun[SHADOW_TABLE_SIZE];
+    astro_vector_t moon[SHADOW_TABLE_SIZE];
+    astro_status_t status;
+    int i;
+
+    table->tt0 = center.tt - ((SHADOW_TABLE_SIZE - 1) / 2) * SHADOW_TABLE_STEP;
+    for (i=0; i < SHADOW_TABLE_SIZE; ++i)
+        time[i] = Astronomy_TerrestrialTime(table->tt0 + i*SHADOW_TABLE_STEP);
+
+    status = Astronomy_GeoVectorBatch(BODY_SUN, SHADOW_TABLE_SIZE, time, ABERRATION, sun);
+    if (status != ASTRO_SUCCESS)
+        return status;
+
+    status = Astronomy_GeoMoonBatch(SHADOW_TABLE_SIZE, time, moon);
+    if (status != ASTRO_SUCCESS)
+        return status;
+
+    for (i=0; i < SHADOW_TABLE_SIZE; ++i)
+    {
+        if (sun[i].status != ASTRO_SUCCESS)
+            return sun[i].status;
+        table->sun[i][0] = sun[i].x;
+        table->sun[i][1] = sun[i].y;
+        table->sun[i][2] = sun[i].z;
+        table->moon[i][0] = moon[i].x;
+        table->moon[i][1] = moon[i].y;
+        table->moon[i][2] = moon[i].z;
+    }
+    return ASTRO_SUCCESS;
+}
+
+/*
+    Interpolates the Sun and Moon from a shadow table with a 4-point Lagrange cubic.
+    Over 10-minute steps this is accurate to well under a meter.
+    Returns 0 if `time` is outside the table.
+*/
+static int ShadowTableLookup(const shadow_table_t *table, astro_time_t time, astro_vector_t *s, astro_vector_t *m)
+{
+    double x, u, w[4];
+    int i, j, k;
+
+    x = (time.tt - table->tt0) / SHADOW_TABLE_STEP;
+    i = (int)floor(x);
+    if (i < 1 || i > SHADOW_TABLE_SIZE - 3)
+        return 0;
+
+    u = x - i;
+    w[0] = -u*(u - 1.0)*(u - 2.0) / 6.0;
+    w[1] = (u + 1.0)*(u - 1.0)*(u - 2.0) / 2.0;
+    w[2] = -(u + 1.0)*u*(u - 2.0) / 2.0;
+    w[3] = (u + 1.0)*u*(u - 1.0) / 6.0;
+
+    s->status = m->status = ASTRO_SUCCESS;
+    s->t = m->t = time;
+    s->x = s->y = s->z = 0.0;
+    m->x = m->y = m->z = 0.0;
+    for (j=0; j < 4; ++j)
+    {
+        k = i - 1 + j;
+        s->x += w[j] * table->sun[k][0];
+        s->y += w[j] * table->sun[k][1];
+        s->z += w[j] * table->sun[k][2];
+        m->x += w[j] * table->moon[k][0];
+        m->y += w[j] * table->moon[k][1];
+        m->z += w[j] * table->moon[k][2];
+    }
+    return 1;
+}
+
+/*
+    Calculates the Moon's shadow relative to an observer. If `table` is not NULL
+    and covers `time`, the Sun and Moon are interpolated from it.
+*/
+static shadow_t LocalMoonShadow(const shadow_table_t *table, astro_time_t time, astro_observer_t observer)
 {
     astro_vector_t s, o, m;
     double pos[3];
@@ -12124,12 +16638,15 @@ static shadow_t LocalMoonShadow(astro_time_t time, astro_observer_t observer)
     /* That way they can be recycled instead of recalculated. */
     geo_pos(&time, observer, pos);
 
-    /* Calculate geocentric Sun with aberration correction. */
-    s = Astronomy_GeoVector(BODY_SUN, time, ABERRATION);
-    if (s.status != ASTRO_SUCCESS)
-        return ShadowError(s.status);
+    if (table == NULL || !ShadowTableLookup(table, time, &s, &m))
+    {
+        /* Calculate geocentric Sun with aberration correction. */
+        s = Astronomy_GeoVector(BODY_SUN, time, ABERRATION);
+        if (s.status != ASTRO_SUCCESS)
+            return ShadowError(s.status);
 
-    m = Astronomy_GeoMoon(time);    /* geocentric Moon */
+        m = Astronomy_GeoMoon(time);    /* geocentric Moon */
+    }
 
     /* Calculate lunacentric location of an observer on the Earth's surface. */
     o.status = m.status;
@@ -12147,22 +16664,31 @@ static shadow_t LocalMoonShadow(astro_time_t time, astro_observer_t observer)
 }
 
 
+/** @cond DOXYGEN_SKIP */
+typedef struct
+{
+    const shadow_table_t   *table;
+    astro_observer_t        observer;
+}
+local_shadow_context_t;
+/** @endcond */
+
 static astro_func_result_t local_shadow_distance_slope(void *context, astro_time_t time)
 {
     const double dt = 1.0 / 86400.0;
     astro_time_t t1, t2;
     astro_func_result_t result;
     shadow_t shadow1, shadow2;
-    const astro_observer_t *observer = (const astro_observer_t *) context;
+    const local_shadow_context_t *local = (const local_shadow_context_t *) context;
 
     t1 = Astronomy_AddDays(time, -dt);
     t2 = Astronomy_AddDays(time, +dt);
 
-    shadow1 = LocalMoonShadow(t1, *observer);
+    shadow1 = LocalMoonShadow(local->table, t1, local->observer);
     if (shadow1.status != ASTRO_SUCCESS)
         return FuncError(shadow1.status);
 
-    shadow2 = LocalMoonShadow(t2, *observer);
+    shadow2 = LocalMoonShadow(local->table, t2, local->observer);
     if (shadow2.status != ASTRO_SUCCESS)
         return FuncError(shadow2.status);
 
@@ -12172,10 +16698,14 @@ static astro_func_result_t local_shadow_distance_slope(void *context, astro_time
 }
 
 
-static shadow_t PeakLocalMoonShadow(astro_time_t search_center_time, astro_observer_t observer)
+static shadow_t PeakLocalMoonShadow(
+    const shadow_table_t *table,
+    astro_time_t search_center_time,
+    astro_observer_t observer)
 {
     astro_time_t t1, t2;
     astro_search_result_t result;
+    local_shadow_context_t local;
     const double window = 0.2;
 
     /*
@@ -12186,11 +16716,13 @@ static shadow_t PeakLocalMoonShadow(astro_time_t search_center_time, astro_obser
     t1 = Astronomy_AddDays(search_center_time, -window);
     t2 = Astronomy_AddDays(search_center_time, +window);
 
-    result = Astronomy_Search(local_shadow_distance_slope, &observer, t1, t2, 1.0);
+    local.table = table;
+    local.observer = observer;
+    result = Astronomy_Search(local_shadow_distance_slope, &local, t1, t2, 1.0);
     if (result.status != ASTRO_SUCCESS)
         return ShadowError(result.status);
 
-    return LocalMoonShadow(result.time, observer);
+    return LocalMoonShadow(table, result.time, observer);
 }
 
 
@@ -12214,6 +16746,7 @@ typedef struct
     local_distance_func     func;
     double                  direction;
     astro_observer_t        observer;
+    const shadow_table_t   *table;
 }
 eclipse_transition_t;
 /* @endcond */
@@ -12225,7 +16758,7 @@ static astro_func_result_t local_eclipse_func(void *context, astro_time_t time)
     shadow_t shadow;
     astro_func_result_t result;
 
-    shadow = LocalMoonShadow(time, trans->observer);
+    shadow = LocalMoonShadow(trans->table, time, trans->observer);
     if (shadow.status != ASTRO_SUCCESS)
         return FuncError(shadow.status);
 
@@ -12276,6 +16809,7 @@ static astro_status_t CalcEvent(
 
 
 static astro_status_t LocalEclipseTransition(
+    const shadow_table_t *table,
     astro_observer_t observer,
     double direction,
     local_distance_func func,
@@ -12289,6 +16823,7 @@ static astro_status_t LocalEclipseTransition(
     trans.func = func;
     trans.direction = direction;
     trans.observer = observer;
+    trans.table = table;
 
     search = Astronomy_Search(local_eclipse_func, &trans, t1, t2, 1.0);
     if (search.status != ASTRO_SUCCESS)
@@ -12303,6 +16838,7 @@ static astro_status_t LocalEclipseTransition(
 
 
 static astro_local_solar_eclipse_t LocalEclipse(
+    const shadow_table_t *table,
     shadow_t shadow,
     astro_observer_t observer)
 {
@@ -12319,11 +16855,11 @@ static astro_local_solar_eclipse_t LocalEclipse(
     t1 = Astronomy_AddDays(shadow.time, -PARTIAL_WINDOW);
     t2 = Astronomy_AddDays(shadow.time, +PARTIAL_WINDOW);
 
-    status = LocalEclipseTransition(observer, +1.0, local_partial_distance, t1, shadow.time, &eclipse.partial_begin);
+    status = LocalEclipseTransition(table, observer, +1.0, local_partial_distance, t1, shadow.time, &eclipse.partial_begin);
     if (status != ASTRO_SUCCESS)
         return LocalSolarEclipseError(status);
 
-    status = LocalEclipseTransition(observer, -1.0, local_partial_distance, shadow.time, t2, &eclipse.partial_end);
+    status = LocalEclipseTransition(table, observer, -1.0, local_partial_distance, shadow.time, t2, &eclipse.partial_end);
     if (status != ASTRO_SUCCESS)
         return LocalSolarEclipseError(status);
 
@@ -12332,11 +16868,11 @@ static astro_local_solar_eclipse_t LocalEclipse(
         t1 = Astronomy_AddDays(shadow.time, -TOTAL_WINDOW);
         t2 = Astronomy_AddDays(shadow.time, +TOTAL_WINDOW);
 
-        status = LocalEclipseTransition(observer, +1.0, local_total_distance, t1, shadow.time, &eclipse.total_begin);
+        status = LocalEclipseTransition(table, observer, +1.0, local_total_distance, t1, shadow.time, &eclipse.total_begin);
         if (status != ASTRO_SUCCESS)
             return LocalSolarEclipseError(status);
 
-        status = LocalEclipseTransition(observer, -1.0, local_total_distance, shadow.time, t2, &eclipse.total_end);
+        status = LocalEclipseTransition(table, observer, -1.0, local_total_distance, shadow.time, t2, &eclipse.total_end);
         if (status != ASTRO_SUCCESS)
             return LocalSolarEclipseError(status);
 
@@ -12358,6 +16894,48 @@ static astro_local_solar_eclipse_t LocalEclipse(
 }
 
 
+/*
+    Determines whether there is a solar eclipse visible to `observer`
+    at the new moon at `newmoon`.
+    Returns `kind` = ECLIPSE_NONE with `status` = ASTRO_SUCCESS if there is none,
+    including an eclipse that happens completely at night.
+*/
+static astro_local_solar_eclipse_t LocalSolarEclipseAtNewMoon(astro_time_t newmoon, astro_observer_t observer)
+{
+    const double PruneLatitude = 1.8;   /* Moon's ecliptic latitude beyond which eclipse is impossible */
+    shadow_t shadow;
+    double eclip_lat, eclip_lon, distance;
+    astro_local_solar_eclipse_t eclipse;
+
+    /* Pruning: if the new moon's ecliptic latitude is too large, a solar eclipse is not possible. */
+    CalcMoon(newmoon.tt / 36525.0, &eclip_lon, &eclip_lat, &distance);
+    if (RAD2DEG * fabs(eclip_lat) < PruneLatitude)
+    {
+        /* Search near the new moon for the time when the observer */
+        /* is closest to the line passing through the centers of the Sun and Moon. */
+        shadow = PeakLocalMoonShadow(NULL, newmoon, observer);
+        if (shadow.status != ASTRO_SUCCESS)
+            return LocalSolarEclipseError(shadow.status);
+
+        if (shadow.r < shadow.p)
+        {
+            /* This is at least a partial solar eclipse for the observer. */
+            eclipse = LocalEclipse(NULL, shadow, observer);
+
+            /* If any error occurs, something is really wrong and we should bail out. */
+            if (eclipse.status != ASTRO_SUCCESS)
+                return eclipse;
+
+            /* Ignore any eclipse that happens completely at night. */
+            /* More precisely, the center of the Sun must be above the horizon */
+            /* at the beginning or the end of the eclipse, or we skip the event. */
+            if (eclipse.partial_begin.altitude > 0.0 || eclipse.partial_end.altitude > 0.0)
+                return eclipse;
+        }
+    }
+    return LocalSolarEclipseError(ASTRO_SUCCESS);
+}
+
 /**
  * @brief Searches for a solar eclipse visible at a specific location on the Earth's surface.
  *
@@ -12386,11 +16964,8 @@ astro_local_solar_eclipse_t Astronomy_SearchLocalSolarEclipse(
     astro_time_t startTime,
     astro_observer_t observer)
 {
-    const double PruneLatitude = 1.8;   /* Moon's ecliptic latitude beyond which eclipse is impossible */
     astro_time_t nmtime;
     astro_search_result_t newmoon;
-    shadow_t shadow;
-    double eclip_lat, eclip_lon, distance;
     astro_local_solar_eclipse_t eclipse;
 
     /* Iterate through consecutive new moons until we find a solar eclipse visible somewhere on Earth. */
@@ -12402,32 +16977,9 @@ astro_local_solar_eclipse_t Astronomy_SearchLocalSolarEclipse(
         if (newmoon.status != ASTRO_SUCCESS)
             return LocalSolarEclipseError(newmoon.status);
 
-        /* Pruning: if the new moon's ecliptic latitude is too large, a solar eclipse is not possible. */
-        CalcMoon(newmoon.time.tt / 36525.0, &eclip_lon, &eclip_lat, &distance);
-        if (RAD2DEG * fabs(eclip_lat) < PruneLatitude)
-        {
-            /* Search near the new moon for the time when the observer */
-            /* is closest to the line passing through the centers of the Sun and Moon. */
-            shadow = PeakLocalMoonShadow(newmoon.time, observer);
-            if (shadow.status != ASTRO_SUCCESS)
-                return LocalSolarEclipseError(shadow.status);
-
-            if (shadow.r < shadow.p)
-            {
-                /* This is at least a partial solar eclipse for the observer. */
-                eclipse = LocalEclipse(shadow, observer);
-
-                /* If any error occurs, something is really wrong and we should bail out. */
-                if (eclipse.status != ASTRO_SUCCESS)
-                    return eclipse;
-
-                /* Ignore any eclipse that happens completely at night. */
-                /* More precisely, the center of the Sun must be above the horizon */
-                /* at the beginning or the end of the eclipse, or we skip the event. */
-                if (eclipse.partial_begin.altitude > 0.0 || eclipse.partial_end.altitude > 0.0)
-                    return eclipse;
-            }
-        }
+        eclipse = LocalSolarEclipseAtNewMoon(newmoon.time, observer);
+        if (eclipse.status != ASTRO_SUCCESS || eclipse.kind != ECLIPSE_NONE)
+            return eclipse;
 
         /* We didn't find an eclipse on this new moon, so search for the next one. */
         nmtime = Astronomy_AddDays(newmoon.time, 10.0);
@@ -12464,6 +17016,370 @@ astro_local_solar_eclipse_t Astronomy_NextLocalSolarEclipse(
 }
 
 
+/** @cond DOXYGEN_SKIP */
+typedef astro_status_t (* lunation_func_t) (void *context, astro_time_t time);
+/** @endcond */
+
+/*
+    Calls `func` for every time from `startTime` up to (but not including) `endTime`
+    that the Moon reaches the phase `targetLon`, in order. After the first one,
+    the phases are searched in blocks with Astronomy_SearchMoonPhaseBatch:
+    each search starts half a lunation after the previous phase found (advanced
+    by whole lunations) and covers one lunation.
+*/
+static astro_status_t MoonPhaseSeries(
+    double targetLon,
+    astro_time_t startTime,
+    astro_time_t endTime,
+    lunation_func_t func,
+    void *context)
+{
+    double target[MOON_PHASE_BATCH];
+    double limit[MOON_PHASE_BATCH];
+    astro_time_t start[MOON_PHASE_BATCH];
+    astro_search_result_t found[MOON_PHASE_BATCH];
+    astro_search_result_t first;
+    astro_time_t last;
+    astro_status_t status;
+    int n, k;
+
+    if (endTime.ut <= startTime.ut)
+        return ASTRO_SUCCESS;
+
+    first = Astronomy_SearchMoonPhase(targetLon, startTime, 40.0);
+    if (first.status != ASTRO_SUCCESS)
+        return first.status;
+
+    last = first.time;
+    if (last.ut >= endTime.ut)
+        return ASTRO_SUCCESS;
+
+    status = func(context, last);
+    if (status != ASTRO_SUCCESS)
+        return status;
+
+    for(;;)
+    {
+        n = 1 + (int)ceil((endTime.ut - last.ut) / MEAN_SYNODIC_MONTH);
+        if (n > MOON_PHASE_BATCH)
+            n = MOON_PHASE_BATCH;
+
+        for (k=0; k < n; ++k)
+        {
+            target[k] = targetLon;
+            start[k] = Astronomy_AddDays(last, (k + 0.5) * MEAN_SYNODIC_MONTH);
+            limit[k] = MEAN_SYNODIC_MONTH;
+        }
+
+        status = Astronomy_SearchMoonPhaseBatch(n, target, start, limit, found);
+        if (status != ASTRO_SUCCESS)
+            return status;
+
+        for (k=0; k < n; ++k)
+        {
+            if (found[k].status != ASTRO_SUCCESS)
+                return found[k].status;
+
+            if (found[k].time.ut <= last.ut)
+                return ASTRO_INTERNAL_ERROR;    /* the series must move forward */
+
+            if (found[k].time.ut >= endTime.ut)
+                return ASTRO_SUCCESS;
+
+            last = found[k].time;
+            status = func(context, last);
+            if (status != ASTRO_SUCCESS)
+                return status;
+        }
+    }
+}
+
+/** @cond DOXYGEN_SKIP */
+typedef struct
+{
+    int capacity;
+    int count;
+    astro_lunar_eclipse_t *eclipse;
+}
+lunar_catalog_t;
+
+typedef struct
+{
+    int capacity;
+    int count;
+    astro_global_solar_eclipse_t *eclipse;
+}
+global_catalog_t;
+
+typedef struct
+{
+    int capacity;
+    int count;
+    astro_observer_t observer;
+    astro_local_solar_eclipse_t *eclipse;
+}
+local_catalog_t;
+/** @endcond */
+
+static astro_status_t lunar_catalog_add(void *context, astro_time_t fullmoon)
+{
+    lunar_catalog_t *catalog = (lunar_catalog_t *) context;
+    astro_lunar_eclipse_t eclipse = LunarEclipseAtFullMoon(fullmoon);
+    if (eclipse.status != ASTRO_SUCCESS)
+        return eclipse.status;
+    if (eclipse.kind == ECLIPSE_NONE)
+        return ASTRO_SUCCESS;
+    if (catalog->count == catalog->capacity)
+        return ASTRO_BUFFER_TOO_SMALL;
+    catalog->eclipse[catalog->count++] = eclipse;
+    return ASTRO_SUCCESS;
+}
+
+static astro_status_t global_catalog_add(void *context, astro_time_t newmoon)
+{
+    global_catalog_t *catalog = (global_catalog_t *) context;
+    astro_global_solar_eclipse_t eclipse = GlobalSolarEclipseAtNewMoon(newmoon);
+    if (eclipse.status != ASTRO_SUCCESS)
+        return eclipse.status;
+    if (eclipse.kind == ECLIPSE_NONE)
+        return ASTRO_SUCCESS;
+    if (catalog->count == catalog->capacity)
+        return ASTRO_BUFFER_TOO_SMALL;
+    catalog->eclipse[catalog->count++] = eclipse;
+    return ASTRO_SUCCESS;
+}
+
+static astro_status_t local_catalog_add(void *context, astro_time_t newmoon)
+{
+    local_catalog_t *catalog = (local_catalog_t *) context;
+    astro_local_solar_eclipse_t eclipse = LocalSolarEclipseAtNewMoon(newmoon, catalog->observer);
+    if (eclipse.status != ASTRO_SUCCESS)
+        return eclipse.status;
+    if (eclipse.kind == ECLIPSE_NONE)
+        return ASTRO_SUCCESS;
+    if (catalog->count == catalog->capacity)
+        return ASTRO_BUFFER_TOO_SMALL;
+    catalog->eclipse[catalog->count++] = eclipse;
+    return ASTRO_SUCCESS;
+}
+
+/**
+ * @brief Lists the lunar eclipses at the full moons in a range of time.
+ *
+ * Finds every full moon from `startTime` up to (but not including) `endTime`
+ * and stores the lunar eclipse at each full moon that has one, in order.
+ * This gives the same eclipses as calling #Astronomy_SearchLunarEclipse
+ * and then #Astronomy_NextLunarEclipse until the full moons pass `endTime`,
+ * but each full moon is searched from the one before it, with the following
+ * ones searched together through #Astronomy_SearchMoonPhaseBatch.
+ * Because the ranges are defined by full moons, the catalogs of adjacent
+ * ranges can be computed independently and concatenated.
+ *
+ * @param startTime     The beginning of the range.
+ * @param endTime       The end of the range.
+ * @param capacity      The number of elements in `eclipse`. There can be at most one eclipse
+ *                      per full moon, so `2 + (endTime.ut - startTime.ut) / 29.5` is always enough.
+ * @param eclipse       An array of at least `capacity` elements that receives the eclipses.
+ * @param count         Receives the number of eclipses stored in `eclipse`.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every eclipse in the range was stored,
+ *      `ASTRO_BUFFER_TOO_SMALL` if there were more than `capacity`,
+ *      or another error code if a search failed.
+ */
+astro_status_t Astronomy_LunarEclipseCatalog(
+    astro_time_t startTime,
+    astro_time_t endTime,
+    int capacity,
+    astro_lunar_eclipse_t *eclipse,
+    int *count)
+{
+    lunar_catalog_t catalog;
+    astro_status_t status;
+
+    if (count == NULL || capacity < 0 || (capacity > 0 && eclipse == NULL))
+        return ASTRO_INVALID_PARAMETER;
+
+    catalog.capacity = capacity;
+    catalog.count = 0;
+    catalog.eclipse = eclipse;
+    status = MoonPhaseSeries(180.0, startTime, endTime, lunar_catalog_add, &catalog);
+    *count = catalog.count;
+    return status;
+}
+
+/**
+ * @brief Lists the solar eclipses visible anywhere on the Earth at the new moons in a range of time.
+ *
+ * Finds every new moon from `startTime` up to (but not including) `endTime`
+ * and stores the solar eclipse at each new moon that has one, in order,
+ * like calling #Astronomy_SearchGlobalSolarEclipse and then
+ * #Astronomy_NextGlobalSolarEclipse. See #Astronomy_LunarEclipseCatalog
+ * for how the new moons are searched.
+ *
+ * @param startTime     The beginning of the range.
+ * @param endTime       The end of the range.
+ * @param capacity      The number of elements in `eclipse`. There can be at most one eclipse
+ *                      per new moon, so `2 + (endTime.ut - startTime.ut) / 29.5` is always enough.
+ * @param eclipse       An array of at least `capacity` elements that receives the eclipses.
+ * @param count         Receives the number of eclipses stored in `eclipse`.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every eclipse in the range was stored,
+ *      `ASTRO_BUFFER_TOO_SMALL` if there were more than `capacity`,
+ *      or another error code if a search failed.
+ */
+astro_status_t Astronomy_GlobalSolarEclipseCatalog(
+    astro_time_t startTime,
+    astro_time_t endTime,
+    int capacity,
+    astro_global_solar_eclipse_t *eclipse,
+    int *count)
+{
+    global_catalog_t catalog;
+    astro_status_t status;
+
+    if (count == NULL || capacity < 0 || (capacity > 0 && eclipse == NULL))
+        return ASTRO_INVALID_PARAMETER;
+
+    catalog.capacity = capacity;
+    catalog.count = 0;
+    catalog.eclipse = eclipse;
+    status = MoonPhaseSeries(0.0, startTime, endTime, global_catalog_add, &catalog);
+    *count = catalog.count;
+    return status;
+}
+
+/**
+ * @brief Lists the solar eclipses visible at a location at the new moons in a range of time.
+ *
+ * Finds every new moon from `startTime` up to (but not including) `endTime`
+ * and stores the solar eclipse seen by `observer` at each new moon that has one,
+ * in order, like calling #Astronomy_SearchLocalSolarEclipse and then
+ * #Astronomy_NextLocalSolarEclipse. As with those functions, eclipses that
+ * happen completely at night are skipped. See #Astronomy_LunarEclipseCatalog
+ * for how the new moons are searched.
+ *
+ * @param startTime     The beginning of the range.
+ * @param endTime       The end of the range.
+ * @param observer      The geographic location of the observer.
+ * @param capacity      The number of elements in `eclipse`. There can be at most one eclipse
+ *                      per new moon, so `2 + (endTime.ut - startTime.ut) / 29.5` is always enough.
+ * @param eclipse       An array of at least `capacity` elements that receives the eclipses.
+ * @param count         Receives the number of eclipses stored in `eclipse`.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every eclipse in the range was stored,
+ *      `ASTRO_BUFFER_TOO_SMALL` if there were more than `capacity`,
+ *      or another error code if a search failed.
+ */
+astro_status_t Astronomy_LocalSolarEclipseCatalog(
+    astro_time_t startTime,
+    astro_time_t endTime,
+    astro_observer_t observer,
+    int capacity,
+    astro_local_solar_eclipse_t *eclipse,
+    int *count)
+{
+    local_catalog_t catalog;
+    astro_status_t status;
+
+    if (count == NULL || capacity < 0 || (capacity > 0 && eclipse == NULL))
+        return ASTRO_INVALID_PARAMETER;
+
+    catalog.capacity = capacity;
+    catalog.count = 0;
+    catalog.observer = observer;
+    catalog.eclipse = eclipse;
+    status = MoonPhaseSeries(0.0, startTime, endTime, local_catalog_add, &catalog);
+    *count = catalog.count;
+    return status;
+}
+
+/**
+ * @brief Finds how a solar eclipse appears from many locations on the Earth's surface.
+ *
+ * Given the peak of a solar eclipse found by #Astronomy_SearchGlobalSolarEclipse,
+ * #Astronomy_NextGlobalSolarEclipse or #Astronomy_GlobalSolarEclipseCatalog,
+ * fills `eclipse[i]` with the local circumstances of that eclipse for `observer[i]`,
+ * for each `i` in `0 .. count-1`.
+ *
+ * The Sun and Moon are calculated once, on a 10-minute grid of times around `peakTime`,
+ * and every observer's shadow calculations interpolate them; only the observer's
+ * own position and the Sun's altitude at each contact are calculated per observer.
+ * This makes a map of an eclipse's visibility far cheaper than calling
+ * #Astronomy_SearchLocalSolarEclipse for every location. The contact times
+ * agree with that function's to within two seconds.
+ *
+ * An observer who does not see the eclipse, including one for whom it happens
+ * completely at night, gets `status` = `ASTRO_SUCCESS` and `kind` = `ECLIPSE_NONE`.
+ *
+ * @param peakTime      The `peak` time of a global solar eclipse.
+ * @param count         The number of observers.
+ * @param observer      An array of `count` geographic locations.
+ * @param eclipse       An array of `count` results. Check the `status` and `kind` fields of each one.
+ *
+ * @return
+ *      `ASTRO_SUCCESS` if every element of `eclipse` was filled in,
+ *      `ASTRO_INVALID_PARAMETER` if `count` is negative or an array is missing,
+ *      or another error code if the Sun and Moon could not be calculated.
+ */
+astro_status_t Astronomy_LocalSolarEclipseGrid(
+    astro_time_t peakTime,
+    int count,
+    const astro_observer_t *observer,
+    astro_local_solar_eclipse_t *eclipse)
+{
+    shadow_table_t *table;
+    shadow_t shadow;
+    astro_status_t status;
+    int i;
+
+    if (count < 0)
+        return ASTRO_INVALID_PARAMETER;
+
+    if (count == 0)
+        return ASTRO_SUCCESS;
+
+    if (observer == NULL || eclipse == NULL)
+        return ASTRO_INVALID_PARAMETER;
+
+    table = (shadow_table_t *) malloc(sizeof(shadow_table_t));
+    if (table == NULL)
+        return ASTRO_OUT_OF_MEMORY;
+
+    status = ShadowTableInit(table, peakTime);
+    if (status == ASTRO_SUCCESS)
+    {
+        for (i=0; i < count; ++i)
+        {
+            /* Search near the global peak for the time when the observer */
+            /* is closest to the line passing through the centers of the Sun and Moon. */
+            shadow = PeakLocalMoonShadow(table, peakTime, observer[i]);
+            if (shadow.status != ASTRO_SUCCESS)
+            {
+                eclipse[i] = LocalSolarEclipseError(shadow.status);
+                continue;
+            }
+
+            eclipse[i] = LocalSolarEclipseError(ASTRO_SUCCESS);
+            if (shadow.r < shadow.p)
+            {
+                /* This is at least a partial solar eclipse for the observer. */
+                eclipse[i] = LocalEclipse(table, shadow, observer[i]);
+
+                /* As in Astronomy_SearchLocalSolarEclipse, ignore an eclipse that happens completely at night. */
+                if (eclipse[i].status == ASTRO_SUCCESS && !(eclipse[i].partial_begin.altitude > 0.0 || eclipse[i].partial_end.altitude > 0.0))
+                    eclipse[i] = LocalSolarEclipseError(ASTRO_SUCCESS);
+            }
+        }
+    }
+
+    free(table);
+    return status;
+}
+
+
 static astro_func_result_t planet_transit_bound(void *context, astro_time_t time)
 {
     shadow_t shadow;
@@ -12759,23 +17675,23 @@ astro_node_event_t Astronomy_NextMoonNode(astro_node_event_t prevNode)
 /**
  * @brief Frees up all dynamic memory allocated by Astronomy Engine.
  *
- * Astronomy Engine uses dynamic memory allocation in only one place:
- * it makes calculation of Pluto's orbit more efficient by caching 11 KB
- * segments and recycling them. To force purging this cache and
- * freeing all the dynamic memory, you can call this function at any time.
- * It is always safe to call, although it will slow down the very next
- * calculation of Pluto's position for a nearby time value.
+ * Astronomy Engine allocates dynamic memory in only two places.
+ * It makes calculation of Pluto's orbit more efficient by caching 16 KB
+ * segments and recycling them (see #Astronomy_PlutoCacheWarm), and
+ * #Astronomy_EphemerisCompile stores its polynomials in a table.
+ * To force purging both and freeing all the dynamic memory, you can call
+ * this function at any time. It is always safe to call, although it will
+ * slow down the very next calculation of Pluto's position for a nearby time value.
  * Calling this function before your program exits is optional, but
  * it will be helpful for leak-checkers like valgrind.
+ *
+ * This function is not thread-safe: do not call it while another thread
+ * may be calculating positions.
  */
 void Astronomy_Reset(void)
 {
-    int i;
-    for (i=0; i < PLUTO_NUM_STATES-1; ++i)
-    {
-        free(pluto_cache[i]);
-        pluto_cache[i] = NULL;
-    }
+    Astronomy_PlutoCacheFree();
+    Astronomy_EphemerisFree();
 }
 
 
@@ -628,6 +628,23 @@ astro_func_result_t;
  */
 typedef astro_func_result_t (* astro_search_func_t) (void *context, astro_time_t time);
 
+/**
+ * @brief A pointer to a function that is to be passed as a callback to #Astronomy_SearchBatch.
+ *
+ * Like #astro_search_func_t, but evaluates the function at `count` times in one call.
+ * For each `k` in `0 .. count-1`, the callback stores in `result[k]` the value at `time[k]`
+ * of the function for the time window with index `bracket[k]` in the arrays passed to
+ * #Astronomy_SearchBatch. Windows may need different functions, for example different
+ * target longitudes, which the callback can look up by `bracket[k]` in its `context`.
+ */
+typedef void (* astro_search_batch_func_t) (
+    void *context,
+    int count,
+    const int *bracket,
+    const astro_time_t *time,
+    astro_func_result_t *result
+);
+
 /**
  * @brief A pointer to a function that calculates Delta T.
  *
@@ -644,8 +661,11 @@ typedef double (* astro_deltat_func) (double ut);
 
 double Astronomy_DeltaT_EspenakMeeus(double ut);
 double Astronomy_DeltaT_JplHorizons(double ut);
+double Astronomy_DeltaT_Table(double ut);
 
 void Astronomy_SetDeltaTFunction(astro_deltat_func func);
+void Astronomy_SetThreadDeltaTFunction(astro_deltat_func func);
+astro_deltat_func Astronomy_GetDeltaTFunction(void);
 
 /**
  * @brief Indicates whether a body (especially Mercury or Venus) is best seen in the morning or evening.
@@ -1156,9 +1176,52 @@ astro_node_event_t;
 typedef struct astro_grav_sim_s astro_grav_sim_t;
 
 
+/**
+ * @brief A data type used for simulating the gravitational forces on many small bodies.
+ *
+ * This is the opaque state of #Astronomy_GravBatchInit, a variant of
+ * #astro_grav_sim_t that keeps the small bodies in separate coordinate arrays.
+ */
+typedef struct astro_grav_batch_s astro_grav_batch_t;
+
+/**
+ * @brief A function that moves all the small bodies across one step of a structure-of-arrays simulation.
+ *
+ * #Astronomy_GravBatchUpdateAdaptive calls a function of this type after each
+ * call to #Astronomy_GravBatchPrepare. It must call #Astronomy_GravBatchAdvance
+ * exactly once for every small body, for example over ranges of bodies on several
+ * threads, and store the largest of the errors reported in `*maxError`.
+ */
+typedef astro_status_t (* astro_grav_advance_func_t) (void *context, astro_grav_batch_t *batch, double *maxError);
+
+
+/**
+ * @brief Describes the compiled planetary ephemeris.
+ *
+ * This structure is returned by #Astronomy_EphemerisInfo.
+ */
+typedef struct
+{
+    astro_status_t  status;     /**< `ASTRO_SUCCESS` if an ephemeris is active, or `ASTRO_NOT_INITIALIZED` if not. */
+    astro_time_t    start;      /**< The beginning of the compiled time range. */
+    astro_time_t    stop;       /**< The end of the compiled time range. */
+    size_t          bytes;      /**< The memory occupied by the ephemeris, in bytes. */
+}
+astro_ephemeris_info_t;
+
+
 /*---------- functions ----------*/
 
 void Astronomy_Reset(void);
+astro_status_t Astronomy_PlutoCacheWarm(astro_time_t startTime, astro_time_t stopTime);
+int Astronomy_PlutoCacheCount(void);
+size_t Astronomy_PlutoCacheSegmentBytes(void);
+void Astronomy_PlutoCacheFree(void);
+astro_status_t Astronomy_EphemerisCompile(astro_time_t startTime, astro_time_t stopTime);
+void Astronomy_EphemerisFree(void);
+astro_ephemeris_info_t Astronomy_EphemerisInfo(void);
+astro_status_t Astronomy_EphemerisWrite(const char *filename);
+astro_status_t Astronomy_EphemerisLoad(const char *filename);
 double Astronomy_VectorLength(astro_vector_t vector);
 astro_angle_result_t Astronomy_AngleBetween(astro_vector_t a, astro_vector_t b);
 const char *Astronomy_BodyName(astro_body_t body);
@@ -1175,14 +1238,25 @@ astro_time_t Astronomy_TimeFromDays(double ut);
 astro_time_t Astronomy_TerrestrialTime(double tt);
 astro_time_t Astronomy_AddDays(astro_time_t time, double days);
 double Astronomy_SiderealTime(astro_time_t *time);
+astro_status_t Astronomy_SiderealTimeBatch(
+    int count,
+    const astro_time_t *time,
+    double *angle,
+    double *gmst,
+    double *gast
+);
 astro_func_result_t Astronomy_HelioDistance(astro_body_t body, astro_time_t time);
 astro_vector_t Astronomy_HelioVector(astro_body_t body, astro_time_t time);
+astro_status_t Astronomy_HelioVectorBatch(astro_body_t body, int count, const astro_time_t *time, astro_vector_t *vector);
 astro_vector_t Astronomy_GeoVector(astro_body_t body, astro_time_t time, astro_aberration_t aberration);
+astro_status_t Astronomy_GeoVectorBatch(astro_body_t body, int count, const astro_time_t *time, astro_aberration_t aberration, astro_vector_t *vector);
 astro_vector_t Astronomy_GeoMoon(astro_time_t time);
+astro_status_t Astronomy_GeoMoonBatch(int count, const astro_time_t *time, astro_vector_t *vector);
 astro_spherical_t Astronomy_EclipticGeoMoon(astro_time_t time);
 astro_state_vector_t Astronomy_GeoMoonState(astro_time_t time);
 astro_state_vector_t Astronomy_GeoEmbState(astro_time_t time);
 astro_libration_t Astronomy_Libration(astro_time_t time);
+astro_status_t Astronomy_LibrationBatch(int count, const astro_time_t *time, astro_libration_t *lib, astro_vector_t *vector);
 astro_state_vector_t Astronomy_BaryState(astro_body_t body, astro_time_t time);
 astro_state_vector_t Astronomy_HelioState(astro_body_t body, astro_time_t time);
 
@@ -1205,6 +1279,7 @@ astro_state_vector_t Astronomy_LagrangePointFast(
 );
 
 astro_jupiter_moons_t Astronomy_JupiterMoons(astro_time_t time);
+astro_status_t Astronomy_JupiterMoonsBatch(int count, const astro_time_t *time, astro_jupiter_moons_t *moons);
 
 astro_equatorial_t Astronomy_Equator(
     astro_body_t body,
@@ -1214,6 +1289,16 @@ astro_equatorial_t Astronomy_Equator(
     astro_aberration_t aberration
 );
 
+astro_status_t Astronomy_EquatorBatch(
+    int count,
+    const astro_body_t *body,
+    const astro_time_t *time,
+    const astro_observer_t *observer,
+    astro_equator_date_t equdate,
+    astro_aberration_t aberration,
+    astro_equatorial_t *equ
+);
+
 astro_vector_t Astronomy_ObserverVector(
     astro_time_t *time,
     astro_observer_t observer,
@@ -1254,6 +1339,13 @@ astro_angle_result_t Astronomy_PairLongitude(astro_body_t body1, astro_body_t bo
 astro_search_result_t Astronomy_SearchRelativeLongitude(astro_body_t body, double targetRelLon, astro_time_t startTime);
 astro_angle_result_t Astronomy_MoonPhase(astro_time_t time);
 astro_search_result_t Astronomy_SearchMoonPhase(double targetLon, astro_time_t startTime, double limitDays);
+astro_status_t Astronomy_SearchMoonPhaseBatch(
+    int count,
+    const double *targetLon,
+    const astro_time_t *startTime,
+    const double *limitDays,
+    astro_search_result_t *result
+);
 astro_moon_quarter_t Astronomy_SearchMoonQuarter(astro_time_t startTime);
 astro_moon_quarter_t Astronomy_NextMoonQuarter(astro_moon_quarter_t mq);
 astro_lunar_eclipse_t Astronomy_SearchLunarEclipse(astro_time_t startTime);
@@ -1262,6 +1354,34 @@ astro_global_solar_eclipse_t Astronomy_SearchGlobalSolarEclipse(astro_time_t sta
 astro_global_solar_eclipse_t Astronomy_NextGlobalSolarEclipse(astro_time_t prevEclipseTime);
 astro_local_solar_eclipse_t Astronomy_SearchLocalSolarEclipse(astro_time_t startTime, astro_observer_t observer);
 astro_local_solar_eclipse_t Astronomy_NextLocalSolarEclipse(astro_time_t prevEclipseTime, astro_observer_t observer);
+astro_status_t Astronomy_LunarEclipseCatalog(
+    astro_time_t startTime,
+    astro_time_t endTime,
+    int capacity,
+    astro_lunar_eclipse_t *eclipse,
+    int *count
+);
+astro_status_t Astronomy_GlobalSolarEclipseCatalog(
+    astro_time_t startTime,
+    astro_time_t endTime,
+    int capacity,
+    astro_global_solar_eclipse_t *eclipse,
+    int *count
+);
+astro_status_t Astronomy_LocalSolarEclipseCatalog(
+    astro_time_t startTime,
+    astro_time_t endTime,
+    astro_observer_t observer,
+    int capacity,
+    astro_local_solar_eclipse_t *eclipse,
+    int *count
+);
+astro_status_t Astronomy_LocalSolarEclipseGrid(
+    astro_time_t peakTime,
+    int count,
+    const astro_observer_t *observer,
+    astro_local_solar_eclipse_t *eclipse
+);
 astro_transit_t Astronomy_SearchTransit(astro_body_t body, astro_time_t startTime);
 astro_transit_t Astronomy_NextTransit(astro_body_t body, astro_time_t prevTransitTime);
 astro_node_event_t Astronomy_SearchMoonNode(astro_time_t startTime);
@@ -1274,6 +1394,15 @@ astro_search_result_t Astronomy_Search(
     astro_time_t t2,
     double dt_tolerance_seconds);
 
+astro_status_t Astronomy_SearchBatch(
+    astro_search_batch_func_t func,
+    void *context,
+    int count,
+    const astro_time_t *t1,
+    const astro_time_t *t2,
+    double dt_tolerance_seconds,
+    astro_search_result_t *result);
+
 astro_search_result_t Astronomy_SearchSunLongitude(
     double targetLon,
     astro_time_t startTime,
@@ -1310,6 +1439,17 @@ astro_search_result_t Astronomy_SearchRiseSetEx(
     double limitDays,
     double metersAboveGround);
 
+astro_status_t Astronomy_SearchRiseSetGrid(
+    astro_body_t body,
+    astro_direction_t direction,
+    int startCount,
+    const astro_time_t *startTime,
+    int observerCount,
+    const astro_observer_t *observer,
+    double limitDays,
+    double metersAboveGround,
+    astro_search_result_t *result);
+
 astro_search_result_t Astronomy_SearchAltitude(
     astro_body_t body,
     astro_observer_t observer,
@@ -1323,6 +1463,7 @@ astro_atmosphere_t Astronomy_Atmosphere(double elevationMeters);
 astro_axis_t Astronomy_RotationAxis(astro_body_t body, astro_time_t *time);
 
 astro_seasons_t Astronomy_Seasons(int year);
+astro_status_t Astronomy_SeasonsBatch(int count, const int *year, astro_seasons_t *seasons);
 astro_illum_t Astronomy_Illumination(astro_body_t body, astro_time_t time);
 astro_illum_t Astronomy_SearchPeakMagnitude(astro_body_t body, astro_time_t startTime);
 astro_apsis_t Astronomy_SearchLunarApsis(astro_time_t startTime);
@@ -1365,6 +1506,15 @@ double Astronomy_Refraction(astro_refraction_t refraction, double altitude);
 double Astronomy_InverseRefraction(astro_refraction_t refraction, double bent_altitude);
 
 astro_constellation_t Astronomy_Constellation(double ra, double dec);
+astro_status_t Astronomy_ConstellationBatch(
+    int count,
+    const double *ra,
+    const double *dec,
+    int *index,
+    double *ra_1875,
+    double *dec_1875);
+const char *Astronomy_ConstellationSymbol(int index);
+const char *Astronomy_ConstellationName(int index);
 
 astro_status_t Astronomy_GravSimInit(
     astro_grav_sim_t **simOut,
@@ -1392,6 +1542,43 @@ astro_body_t Astronomy_GravSimOrigin(const astro_grav_sim_t *sim);
 void Astronomy_GravSimSwap(astro_grav_sim_t *sim);
 void Astronomy_GravSimFree(astro_grav_sim_t *sim);
 
+astro_status_t Astronomy_GravBatchInit(
+    astro_grav_batch_t **batchOut,
+    astro_body_t originBody,
+    astro_time_t time,
+    int numBodies,
+    const double *x, const double *y, const double *z,
+    const double *vx, const double *vy, const double *vz
+);
+
+astro_status_t Astronomy_GravBatchPrepare(astro_grav_batch_t *batch, astro_time_t time);
+astro_status_t Astronomy_GravBatchAdvance(astro_grav_batch_t *batch, int first, int count, double *maxError);
+astro_status_t Astronomy_GravBatchUpdate(astro_grav_batch_t *batch, astro_time_t time);
+
+astro_status_t Astronomy_GravBatchUpdateAdaptive(
+    astro_grav_batch_t *batch,
+    astro_time_t time,
+    double tolerance,
+    astro_grav_advance_func_t advance,
+    void *context,
+    int *numSteps
+);
+
+astro_status_t Astronomy_GravBatchState(
+    const astro_grav_batch_t *batch,
+    int first,
+    int count,
+    double *x, double *y, double *z,
+    double *vx, double *vy, double *vz
+);
+
+astro_time_t Astronomy_GravBatchTime(const astro_grav_batch_t *batch);
+int Astronomy_GravBatchNumBodies(const astro_grav_batch_t *batch);
+astro_body_t Astronomy_GravBatchOrigin(const astro_grav_batch_t *batch);
+void Astronomy_GravBatchFree(astro_grav_batch_t *batch);
+astro_status_t Astronomy_GravBatchSave(const astro_grav_batch_t *batch, const char *filename);
+astro_status_t Astronomy_GravBatchLoad(astro_grav_batch_t **batchOut, const char *filename);
+
 /**
  * @brief A function for which to solve a light-travel time problem.
  *
@@ -1,4 +1,9 @@
 #include <cpp11.hpp>
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include "astronomy/astronomy.h"
 
 using namespace cpp11;
@@ -26,6 +31,229 @@ static astro_body_t int_to_body(int body_int) {
   return static_cast<astro_body_t>(body_int);
 }
 
+// Common length of vectorised arguments. Each argument must have length 1
+// (recycled) or the common length; any zero-length argument gives zero rows.
+static R_xlen_t recycled_size(std::initializer_list<R_xlen_t> sizes) {
+  R_xlen_t n = 1;
+  for (R_xlen_t size : sizes) {
+    if (size == 0)
+      return 0;
+    if (size == 1)
+      continue;
+    if (n != 1 && size != n)
+      stop("Arguments must have length 1 or a common length (%d vs %d)",
+           static_cast<int>(n), static_cast<int>(size));
+    n = size;
+  }
+  return n;
+}
+
+// Index into a recycled argument of length `size` for output row `i`.
+static inline R_xlen_t recycle(R_xlen_t i, R_xlen_t size) {
+  return size == 1 ? 0 : i;
+}
+
+// ---------------------------------------------------------------------------
+// Epochs
+// ---------------------------------------------------------------------------
+
+// An epoch holds fully populated astro_time_t values (ut, tt, nutation angles
+// and sidereal time) for a vector of POSIXct times. It is created once by
+// astro_epoch_() and handed to R as an external pointer, so functions given an
+// epoch instead of POSIXct seconds skip the Delta T and nutation work.
+struct astro_epoch {
+  std::vector<double> posix;          // NA where the time is missing
+  std::vector<astro_time_t> time;     // only meaningful where posix is not NA
+};
+
+static const astro_epoch& epoch_from_sexp(SEXP x) {
+  external_pointer<astro_epoch> epoch(x);
+  if (epoch.get() == nullptr)
+    stop("`time` is an astro_epoch that is no longer valid; epochs cannot be saved and reloaded");
+  return *epoch;
+}
+
+// A single time argument: POSIXct seconds or an astro_epoch of length 1.
+static astro_time_t scalar_time(SEXP x) {
+  if (TYPEOF(x) == EXTPTRSXP) {
+    const astro_epoch& epoch = epoch_from_sexp(x);
+    if (epoch.posix.size() != 1)
+      stop("`time` must be an astro_epoch of length 1, not %d",
+           static_cast<int>(epoch.posix.size()));
+    if (std::isnan(epoch.posix[0]))
+      stop("`time` must not be missing");
+    return epoch.time[0];
+  }
+  double posix = as_cpp<double>(x);
+  if (std::isnan(posix))
+    stop("`time` must not be missing");
+  return posix_to_astro(posix);
+}
+
+// ---------------------------------------------------------------------------
+// Batch evaluation
+// ---------------------------------------------------------------------------
+
+// Batch kernels run off the main thread, so R vectors are copied into plain
+// buffers before any work starts and results are copied back afterwards.
+static std::vector<double> batch_input(doubles x) {
+  return std::vector<double>(x.begin(), x.end());
+}
+
+static std::vector<int> batch_input(integers x) {
+  return std::vector<int>(x.begin(), x.end());
+}
+
+static writable::doubles batch_output(const std::vector<double>& x) {
+  return writable::doubles(x.begin(), x.end());
+}
+
+static writable::integers batch_output(const std::vector<int>& x) {
+  return writable::integers(x.begin(), x.end());
+}
+
+// The times of a vectorised call, given as POSIXct seconds or an astro_epoch.
+// `posix` is NA for missing times, and `time` holds the engine time of every
+// other row. POSIXct input is converted here, once per run of equal times.
+struct batch_times {
+  std::vector<double> posix;
+  std::vector<astro_time_t> time;
+  R_xlen_t size() const { return posix.size(); }
+};
+
+static batch_times batch_input_times(SEXP x) {
+  batch_times out;
+  if (TYPEOF(x) == EXTPTRSXP) {
+    const astro_epoch& epoch = epoch_from_sexp(x);
+    out.posix = epoch.posix;
+    out.time = epoch.time;
+    return out;
+  }
+
+  out.posix = batch_input(doubles(x));
+  out.time.resize(out.posix.size());
+  for (std::size_t i = 0; i < out.posix.size(); ++i) {
+    if (std::isnan(out.posix[i]))
+      continue;
+    if (i > 0 && out.posix[i] == out.posix[i - 1])
+      out.time[i] = out.time[i - 1];
+    else
+      out.time[i] = posix_to_astro(out.posix[i]);
+  }
+  return out;
+}
+
+// Joins the worker threads when parallel_for() returns or unwinds, so that an
+// exception from a chunk never destroys a joinable std::thread (which would
+// call std::terminate and take down the R session).
+struct thread_joiner {
+  std::vector<std::thread>& threads;
+  ~thread_joiner() {
+    for (std::thread& thread : threads) {
+      if (thread.joinable())
+        thread.join();
+    }
+  }
+};
+
+// Split rows [0, n) into contiguous ranges and run `chunk(begin, end)` on up
+// to `nthreads` threads. The calling thread takes the first range and joins
+// the others before returning. Worker threads use the calling thread's Delta T
+// model. `chunk` must not call the R API. An exception thrown by any chunk is
+// rethrown on the calling thread once every worker has finished.
+template <typename F>
+static void parallel_for(R_xlen_t n, int nthreads, F chunk) {
+  if (n <= 0)
+    return;
+  R_xlen_t nt = std::min<R_xlen_t>(std::max(nthreads, 1), n);
+  R_xlen_t size = (n + nt - 1) / nt;
+  astro_deltat_func deltat = Astronomy_GetDeltaTFunction();
+
+  std::vector<std::exception_ptr> errors(nt);
+  std::vector<std::thread> workers;
+  workers.reserve(nt - 1);
+  {
+    thread_joiner joiner{workers};
+    for (R_xlen_t begin = size; begin < n; begin += size) {
+      R_xlen_t end = std::min(n, begin + size);
+      std::exception_ptr& error = errors[begin / size];
+      try {
+        workers.emplace_back([&chunk, &error, deltat, begin, end]() {
+          Astronomy_SetThreadDeltaTFunction(deltat);
+          try {
+            chunk(begin, end);
+          } catch (...) {
+            error = std::current_exception();
+          }
+        });
+      } catch (const std::system_error&) {
+        chunk(begin, end);
+      }
+    }
+    chunk(0, std::min(n, size));
+  }
+
+  for (const std::exception_ptr& error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+// Report the first failing row of a batch as an R error.
+static void check_batch_status(const std::vector<astro_status_t>& status,
+                               const char* what) {
+  for (std::size_t i = 0; i < status.size(); ++i) {
+    if (status[i] != ASTRO_SUCCESS)
+      stop("%s failed with status %d at row %d",
+           what, status[i], static_cast<int>(i + 1));
+  }
+}
+
+// Fill rows [begin, end) of a body/time vector table from one of the engine's
+// batch functions, called once per run of consecutive rows sharing a body so
+// the planets' series are evaluated several times per pass. Rows with a
+// missing time are NA and are not passed to the engine.
+template <typename F>
+static void batch_vector_rows(R_xlen_t begin, R_xlen_t end,
+                              const std::vector<int>& b_in,
+                              const batch_times& t_in,
+                              std::vector<double>& x, std::vector<double>& y,
+                              std::vector<double>& z, std::vector<double>& time,
+                              std::vector<astro_status_t>& status, F batch) {
+  const R_xlen_t max_run = 65536;
+  std::vector<astro_time_t> times;
+  std::vector<astro_vector_t> vecs;
+
+  R_xlen_t i = begin;
+  while (i < end) {
+    int b = b_in[recycle(i, b_in.size())];
+    R_xlen_t run_end = i;
+    times.clear();
+    for (; run_end < end && run_end - i < max_run &&
+           b_in[recycle(run_end, b_in.size())] == b; ++run_end) {
+      R_xlen_t j = recycle(run_end, t_in.size());
+      time[run_end] = t_in.posix[j];
+      if (!std::isnan(t_in.posix[j]))
+        times.push_back(t_in.time[j]);
+    }
+
+    vecs.resize(times.size());
+    batch(int_to_body(b), static_cast<int>(times.size()), times.data(), vecs.data());
+
+    for (std::size_t k = 0; i < run_end; ++i) {
+      if (std::isnan(time[i])) {
+        x[i] = y[i] = z[i] = NA_REAL;
+        continue;
+      }
+      const astro_vector_t& vec = vecs[k++];
+      status[i] = vec.status;
+      x[i] = vec.x;
+      y[i] = vec.y;
+      z[i] = vec.z;
+    }
+  }
+}
+
 // ---------------------------------------------------------------------------
 // [[cpp11::register]]
 // Time utilities
@@ -44,6 +272,159 @@ double astro_current_time_() {
   return astro_to_posix(t);
 }
 
+// Delta T models selectable from R, in the order of the codes used by
+// astro_delta_t_model(). The model is set for the calling (R main) thread
+// only; parallel_for() hands it on to its worker threads.
+static const astro_deltat_func deltat_models[] = {
+  Astronomy_DeltaT_EspenakMeeus,
+  Astronomy_DeltaT_JplHorizons,
+  Astronomy_DeltaT_Table
+};
+static const int n_deltat_models = sizeof(deltat_models) / sizeof(deltat_models[0]);
+
+static astro_deltat_func deltat_model(int code) {
+  if (code < 0 || code >= n_deltat_models)
+    stop("Unknown Delta T model code %d", code);
+  return deltat_models[code];
+}
+
+// Returns the code of the Delta T model in use, or -1 if another program has
+// installed a function that is not one of the models above.
+[[cpp11::register]]
+int astro_get_delta_t_model_() {
+  astro_deltat_func current = Astronomy_GetDeltaTFunction();
+  for (int code = 0; code < n_deltat_models; ++code) {
+    if (deltat_models[code] == current)
+      return code;
+  }
+  return -1;
+}
+
+[[cpp11::register]]
+void astro_set_delta_t_model_(int code) {
+  Astronomy_SetThreadDeltaTFunction(deltat_model(code));
+}
+
+// Delta T in seconds for each POSIXct time under the given model.
+[[cpp11::register]]
+doubles astro_delta_t_(doubles time_posix, int code) {
+  astro_deltat_func func = deltat_model(code);
+  std::vector<double> t_in = batch_input(time_posix);
+  std::vector<double> out(t_in.size());
+  for (std::size_t i = 0; i < t_in.size(); ++i) {
+    double ut = (t_in[i] - 946728000.0) / 86400.0;
+    out[i] = std::isnan(ut) ? NA_REAL : func(ut);
+  }
+  return batch_output(out);
+}
+
+// Build an epoch from POSIXct seconds. Astronomy_SiderealTime() fills in the
+// nutation angles as well as the sidereal time, so every later use of the
+// epoch starts from a fully populated astro_time_t.
+[[cpp11::register]]
+SEXP astro_epoch_(doubles time_posix) {
+  astro_epoch* epoch = new astro_epoch();
+  epoch->posix = batch_input(time_posix);
+  epoch->time.resize(epoch->posix.size());
+  for (std::size_t i = 0; i < epoch->posix.size(); ++i) {
+    if (std::isnan(epoch->posix[i]))
+      continue;
+    if (i > 0 && epoch->posix[i] == epoch->posix[i - 1]) {
+      epoch->time[i] = epoch->time[i - 1];
+      continue;
+    }
+    epoch->time[i] = posix_to_astro(epoch->posix[i]);
+    Astronomy_SiderealTime(&epoch->time[i]);
+  }
+  return external_pointer<astro_epoch>(epoch);
+}
+
+[[cpp11::register]]
+doubles astro_epoch_time_(SEXP epoch) {
+  return batch_output(epoch_from_sexp(epoch).posix);
+}
+
+// Subset an epoch by 1-based row numbers; NA rows give missing times.
+[[cpp11::register]]
+SEXP astro_epoch_subset_(SEXP epoch, integers i) {
+  const astro_epoch& from = epoch_from_sexp(epoch);
+  astro_epoch* out = new astro_epoch();
+  out->posix.resize(i.size(), NA_REAL);
+  out->time.resize(i.size());
+  for (R_xlen_t k = 0; k < i.size(); ++k) {
+    int row = i[k];
+    if (row == NA_INTEGER || row < 1 || row > static_cast<int>(from.posix.size()))
+      continue;
+    out->posix[k] = from.posix[row - 1];
+    out->time[k] = from.time[row - 1];
+  }
+  return external_pointer<astro_epoch>(out);
+}
+
+// ---------------------------------------------------------------------------
+// Sidereal time
+// ---------------------------------------------------------------------------
+
+// Vectorised over `time` (POSIXct seconds or an epoch) and `longitude`
+// (recycled). Greenwich sidereal time is computed once per element of `time`
+// by Astronomy_SiderealTimeBatch on `nthreads` threads, then shifted by each
+// row's longitude to give local sidereal time in hours.
+[[cpp11::register]]
+doubles astro_sidereal_time_vec_(SEXP time, doubles longitude, bool apparent,
+                                 int nthreads) {
+  batch_times t_in = batch_input_times(time);
+  std::vector<double> lon_in = batch_input(longitude);
+  R_xlen_t nt = t_in.size();
+  R_xlen_t n = recycled_size({nt, (R_xlen_t) lon_in.size()});
+
+  std::vector<double> gst(nt);
+  std::vector<astro_status_t> status(nt, ASTRO_SUCCESS);
+  parallel_for(nt, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    int count = static_cast<int>(end - begin);
+    astro_status_t batch_status = Astronomy_SiderealTimeBatch(
+      count, &t_in.time[begin], nullptr,
+      apparent ? nullptr : &gst[begin],
+      apparent ? &gst[begin] : nullptr
+    );
+    std::fill(status.begin() + begin, status.begin() + end, batch_status);
+  });
+  check_batch_status(status, "Astronomy_SiderealTimeBatch");
+
+  std::vector<double> lst(n);
+  for (R_xlen_t i = 0; i < n; ++i) {
+    R_xlen_t j = recycle(i, nt);
+    double lon = lon_in[recycle(i, lon_in.size())];
+    if (std::isnan(t_in.posix[j]) || std::isnan(lon)) {
+      lst[i] = NA_REAL;
+      continue;
+    }
+    lst[i] = std::fmod(gst[j] + lon / 15.0, 24.0);
+    if (lst[i] < 0.0)
+      lst[i] += 24.0;
+  }
+  return batch_output(lst);
+}
+
+// Earth Rotation Angle in degrees, vectorised over `time`.
+[[cpp11::register]]
+doubles astro_earth_rotation_angle_vec_(SEXP time) {
+  batch_times t_in = batch_input_times(time);
+  R_xlen_t nt = t_in.size();
+
+  std::vector<double> angle(nt);
+  astro_status_t status = Astronomy_SiderealTimeBatch(
+    static_cast<int>(nt), t_in.time.data(), angle.data(), nullptr, nullptr
+  );
+  if (status != ASTRO_SUCCESS)
+    stop("Astronomy_SiderealTimeBatch failed with status %d", status);
+
+  for (R_xlen_t i = 0; i < nt; ++i) {
+    if (std::isnan(t_in.posix[i]))
+      angle[i] = NA_REAL;
+  }
+  return batch_output(angle);
+}
+
 // ---------------------------------------------------------------------------
 // Body utilities
 // ---------------------------------------------------------------------------
@@ -63,8 +444,8 @@ int astro_body_code_(std::string name) {
 // ---------------------------------------------------------------------------
 
 [[cpp11::register]]
-list astro_helio_vector_(int body, double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+list astro_helio_vector_(int body, SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_vector_t vec = Astronomy_HelioVector(int_to_body(body), t);
   if (vec.status != ASTRO_SUCCESS)
     stop("Astronomy_HelioVector failed with status %d", vec.status);
@@ -77,11 +458,36 @@ list astro_helio_vector_(int body, double time_posix) {
   });
 }
 
+// Vectorised over `time` (POSIXct seconds or an epoch) and `body` (recycled).
+// Runs of rows sharing a body are evaluated together by
+// Astronomy_HelioVectorBatch. Missing times give missing coordinates.
+[[cpp11::register]]
+list astro_helio_vector_vec_(integers body, SEXP time) {
+  std::vector<int> b_in = batch_input(body);
+  batch_times t_in = batch_input_times(time);
+  R_xlen_t n = recycled_size({(R_xlen_t) b_in.size(), (R_xlen_t) t_in.size()});
+
+  std::vector<double> x(n), y(n), z(n), posix(n);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  batch_vector_rows(0, n, b_in, t_in, x, y, z, posix, status,
+    [](astro_body_t b, int count, const astro_time_t* t, astro_vector_t* out) {
+      Astronomy_HelioVectorBatch(b, count, t, out);
+    });
+  check_batch_status(status, "Astronomy_HelioVector");
+
+  return writable::list({
+    "x"_nm = batch_output(x),
+    "y"_nm = batch_output(y),
+    "z"_nm = batch_output(z),
+    "time"_nm = batch_output(posix)
+  });
+}
+
 [[cpp11::register]]
-list astro_equator_(int body, double time_posix, double latitude,
+list astro_equator_(int body, SEXP time, double latitude,
                     double longitude, double height,
                     bool of_date, bool aberration) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t obs = Astronomy_MakeObserver(latitude, longitude, height);
   astro_equator_date_t equdate = of_date ? EQUATOR_OF_DATE : EQUATOR_J2000;
   astro_aberration_t aber = aberration ? ABERRATION : NO_ABERRATION;
@@ -97,10 +503,76 @@ list astro_equator_(int body, double time_posix, double latitude,
   });
 }
 
+// Vectorised over body, time and observer location (all recycled) and
+// evaluated on `nthreads` threads. Each thread passes its rows to
+// Astronomy_EquatorBatch, which shares one astro_time_t between the rows with
+// the same time, so the Earth's orientation is computed once per distinct time.
 [[cpp11::register]]
-list astro_sun_position_(double time_posix) {
-  astro_time_t time = posix_to_astro(time_posix);
-  astro_ecliptic_t ecl = Astronomy_SunPosition(time);
+list astro_equator_vec_(integers body, SEXP time, doubles latitude,
+                        doubles longitude, doubles height,
+                        bool of_date, bool aberration, int nthreads) {
+  std::vector<int> b_in = batch_input(body);
+  batch_times t_in = batch_input_times(time);
+  std::vector<double> lat_in = batch_input(latitude);
+  std::vector<double> lon_in = batch_input(longitude);
+  std::vector<double> h_in = batch_input(height);
+  R_xlen_t n = recycled_size({(R_xlen_t) b_in.size(), (R_xlen_t) t_in.size(),
+                              (R_xlen_t) lat_in.size(), (R_xlen_t) lon_in.size(),
+                              (R_xlen_t) h_in.size()});
+
+  astro_equator_date_t equdate = of_date ? EQUATOR_OF_DATE : EQUATOR_J2000;
+  astro_aberration_t aber = aberration ? ABERRATION : NO_ABERRATION;
+
+  std::vector<double> ra(n), dec(n), dist(n);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  parallel_for(n, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    std::vector<astro_body_t> bodies;
+    std::vector<astro_time_t> times;
+    std::vector<astro_observer_t> observers;
+    std::vector<R_xlen_t> rows;
+    for (R_xlen_t i = begin; i < end; ++i) {
+      R_xlen_t j = recycle(i, t_in.size());
+      double posix = t_in.posix[j];
+      double lat = lat_in[recycle(i, lat_in.size())];
+      double lon = lon_in[recycle(i, lon_in.size())];
+      double h = h_in[recycle(i, h_in.size())];
+      if (std::isnan(posix) || std::isnan(lat) || std::isnan(lon) || std::isnan(h)) {
+        ra[i] = dec[i] = dist[i] = NA_REAL;
+        continue;
+      }
+
+      bodies.push_back(int_to_body(b_in[recycle(i, b_in.size())]));
+      times.push_back(t_in.time[j]);
+      observers.push_back(Astronomy_MakeObserver(lat, lon, h));
+      rows.push_back(i);
+    }
+
+    std::vector<astro_equatorial_t> eq(rows.size());
+    astro_status_t batch_status = Astronomy_EquatorBatch(
+      static_cast<int>(rows.size()), bodies.data(), times.data(),
+      observers.data(), equdate, aber, eq.data()
+    );
+    for (std::size_t k = 0; k < rows.size(); ++k) {
+      R_xlen_t i = rows[k];
+      status[i] = (batch_status != ASTRO_SUCCESS) ? batch_status : eq[k].status;
+      ra[i] = eq[k].ra;
+      dec[i] = eq[k].dec;
+      dist[i] = eq[k].dist;
+    }
+  });
+  check_batch_status(status, "Astronomy_Equator");
+
+  return writable::list({
+    "ra"_nm = batch_output(ra),
+    "dec"_nm = batch_output(dec),
+    "dist"_nm = batch_output(dist)
+  });
+}
+
+[[cpp11::register]]
+list astro_sun_position_(SEXP time) {
+  astro_time_t t = scalar_time(time);
+  astro_ecliptic_t ecl = Astronomy_SunPosition(t);
   
   if (ecl.status != ASTRO_SUCCESS)
     stop("Astronomy_SunPosition failed with status %d", ecl.status);
@@ -118,12 +590,12 @@ list astro_sun_position_(double time_posix) {
 }
 
 [[cpp11::register]]
-list astro_ecliptic_(double x, double y, double z, double time_posix) {
+list astro_ecliptic_(double x, double y, double z, SEXP time) {
   astro_vector_t eqj;
   eqj.x = x;
   eqj.y = y;
   eqj.z = z;
-  eqj.t = posix_to_astro(time_posix);
+  eqj.t = scalar_time(time);
   eqj.status = ASTRO_SUCCESS;
 
   astro_ecliptic_t eclip = Astronomy_Ecliptic(eqj);
@@ -141,8 +613,8 @@ list astro_ecliptic_(double x, double y, double z, double time_posix) {
 }
 
 [[cpp11::register]]
-double astro_ecliptic_longitude_(int body, double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+double astro_ecliptic_longitude_(int body, SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_angle_result_t result = Astronomy_EclipticLongitude(int_to_body(body), t);
   if (result.status != ASTRO_SUCCESS)
     stop("Astronomy_EclipticLongitude failed with status %d", result.status);
@@ -150,13 +622,13 @@ double astro_ecliptic_longitude_(int body, double time_posix) {
 }
 
 [[cpp11::register]]
-list astro_horizon_(double time_posix, double lat, double lon, double ra, double dec, int refraction) {
-  astro_time_t time = posix_to_astro(time_posix);
+list astro_horizon_(SEXP time, double lat, double lon, double ra, double dec, int refraction) {
+  astro_time_t t = scalar_time(time);
   astro_observer_t observer;
   observer.latitude = lat;
   observer.longitude = lon;
   
-  astro_horizon_t hor = Astronomy_Horizon(&time, observer, ra, dec, (astro_refraction_t)refraction);
+  astro_horizon_t hor = Astronomy_Horizon(&t, observer, ra, dec, (astro_refraction_t)refraction);
   
   if (std::isnan(hor.altitude) || std::isnan(hor.azimuth)) {
     stop("Astronomy_Horizon returned invalid coordinates");
@@ -170,11 +642,68 @@ list astro_horizon_(double time_posix, double lat, double lon, double ra, double
   });
 }
 
+// Vectorised over time, observer location and equatorial coordinates (all
+// recycled) and evaluated on `nthreads` threads.
+[[cpp11::register]]
+list astro_horizon_vec_(SEXP time, doubles lat, doubles lon,
+                        doubles ra, doubles dec, int refraction, int nthreads) {
+  batch_times t_in = batch_input_times(time);
+  std::vector<double> lat_in = batch_input(lat);
+  std::vector<double> lon_in = batch_input(lon);
+  std::vector<double> ra_in = batch_input(ra);
+  std::vector<double> dec_in = batch_input(dec);
+  R_xlen_t n = recycled_size({(R_xlen_t) t_in.size(), (R_xlen_t) lat_in.size(),
+                              (R_xlen_t) lon_in.size(), (R_xlen_t) ra_in.size(),
+                              (R_xlen_t) dec_in.size()});
+  astro_refraction_t refr = static_cast<astro_refraction_t>(refraction);
+
+  std::vector<double> azimuth(n), altitude(n), ra_out(n), dec_out(n);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  parallel_for(n, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    astro_time_t t = {};
+    double t_posix = NA_REAL;
+    for (R_xlen_t i = begin; i < end; ++i) {
+      R_xlen_t j = recycle(i, t_in.size());
+      double posix = t_in.posix[j];
+      double la = lat_in[recycle(i, lat_in.size())];
+      double lo = lon_in[recycle(i, lon_in.size())];
+      double r = ra_in[recycle(i, ra_in.size())];
+      double d = dec_in[recycle(i, dec_in.size())];
+      if (std::isnan(posix) || std::isnan(la) || std::isnan(lo) ||
+          std::isnan(r) || std::isnan(d)) {
+        azimuth[i] = altitude[i] = ra_out[i] = dec_out[i] = NA_REAL;
+        continue;
+      }
+
+      if (posix != t_posix) {
+        t = t_in.time[j];
+        t_posix = posix;
+      }
+      astro_observer_t observer = Astronomy_MakeObserver(la, lo, 0.0);
+      astro_horizon_t hor = Astronomy_Horizon(&t, observer, r, d, refr);
+      if (std::isnan(hor.altitude) || std::isnan(hor.azimuth))
+        status[i] = ASTRO_INVALID_PARAMETER;
+      azimuth[i] = hor.azimuth;
+      altitude[i] = hor.altitude;
+      ra_out[i] = hor.ra;
+      dec_out[i] = hor.dec;
+    }
+  });
+  check_batch_status(status, "Astronomy_Horizon");
+
+  return writable::list({
+    "azimuth"_nm = batch_output(azimuth),
+    "altitude"_nm = batch_output(altitude),
+    "ra"_nm = batch_output(ra_out),
+    "dec"_nm = batch_output(dec_out)
+  });
+}
+
 [[cpp11::register]]
-list astro_pair_longitude_(int body1, int body2, double time_posix) {
-  astro_time_t time = posix_to_astro(time_posix);
+list astro_pair_longitude_(int body1, int body2, SEXP time) {
+  astro_time_t t = scalar_time(time);
   
-  astro_angle_result_t result = Astronomy_PairLongitude((astro_body_t)body1, (astro_body_t)body2, time);
+  astro_angle_result_t result = Astronomy_PairLongitude((astro_body_t)body1, (astro_body_t)body2, t);
   
   if (result.status != ASTRO_SUCCESS) {
     stop("Astronomy_PairLongitude failed with status %d", result.status);
@@ -186,10 +715,10 @@ list astro_pair_longitude_(int body1, int body2, double time_posix) {
 }
 
 [[cpp11::register]]
-list astro_geo_vector_(int body, double time_posix, int aberration) {
-  astro_time_t time = posix_to_astro(time_posix);
+list astro_geo_vector_(int body, SEXP time, int aberration) {
+  astro_time_t t = scalar_time(time);
   
-  astro_vector_t vector = Astronomy_GeoVector((astro_body_t)body, time, (astro_aberration_t)aberration);
+  astro_vector_t vector = Astronomy_GeoVector((astro_body_t)body, t, (astro_aberration_t)aberration);
   
   if (vector.status != ASTRO_SUCCESS) {
     stop("Astronomy_GeoVector failed with status %d", vector.status);
@@ -203,11 +732,40 @@ list astro_geo_vector_(int body, double time_posix, int aberration) {
   });
 }
 
+// Vectorised over `time` (POSIXct seconds or an epoch) and `body` (recycled)
+// and evaluated on `nthreads` threads, each passing its runs of rows sharing
+// a body to Astronomy_GeoVectorBatch.
+[[cpp11::register]]
+list astro_geo_vector_vec_(integers body, SEXP time, int aberration,
+                           int nthreads) {
+  std::vector<int> b_in = batch_input(body);
+  batch_times t_in = batch_input_times(time);
+  R_xlen_t n = recycled_size({(R_xlen_t) b_in.size(), (R_xlen_t) t_in.size()});
+  astro_aberration_t aber = static_cast<astro_aberration_t>(aberration);
+
+  std::vector<double> x(n), y(n), z(n), posix(n);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  parallel_for(n, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    batch_vector_rows(begin, end, b_in, t_in, x, y, z, posix, status,
+      [aber](astro_body_t b, int count, const astro_time_t* t, astro_vector_t* out) {
+        Astronomy_GeoVectorBatch(b, count, t, aber, out);
+      });
+  });
+  check_batch_status(status, "Astronomy_GeoVector");
+
+  return writable::list({
+    "x"_nm = batch_output(x),
+    "y"_nm = batch_output(y),
+    "z"_nm = batch_output(z),
+    "time"_nm = batch_output(posix)
+  });
+}
+
 [[cpp11::register]]
-list astro_bary_state_(int body, double time_posix) {
-  astro_time_t time = posix_to_astro(time_posix);
+list astro_bary_state_(int body, SEXP time) {
+  astro_time_t t = scalar_time(time);
   
-  astro_state_vector_t state = Astronomy_BaryState((astro_body_t)body, time);
+  astro_state_vector_t state = Astronomy_BaryState((astro_body_t)body, t);
   
   if (state.status != ASTRO_SUCCESS) {
     stop("Astronomy_BaryState failed with status %d", state.status);
@@ -224,15 +782,435 @@ list astro_bary_state_(int body, double time_posix) {
   });
 }
 
+// ---------------------------------------------------------------------------
+// Jupiter's moons
+// ---------------------------------------------------------------------------
+
+// States of Io, Europa, Ganymede and Callisto at each of `time` (POSIXct
+// seconds or an epoch), with rows time x moon and the moon varying fastest.
+// The states are jovicentric; with `geocentric`, Jupiter's light-time
+// corrected geocentric position is added to the positions, and the moons are
+// evaluated at the time the light left Jupiter. Each thread passes its range
+// of times to Astronomy_GeoVectorBatch and Astronomy_JupiterMoonsBatch.
+[[cpp11::register]]
+list astro_jupiter_moons_vec_(SEXP time, bool geocentric, int aberration,
+                              int nthreads) {
+  batch_times t_in = batch_input_times(time);
+  R_xlen_t nt = t_in.size();
+  R_xlen_t rows = nt * 4;
+  astro_aberration_t aber = static_cast<astro_aberration_t>(aberration);
+
+  std::vector<double> posix(rows), x(rows), y(rows), z(rows), vx(rows), vy(rows), vz(rows);
+  std::vector<int> moon(rows);
+  std::vector<astro_status_t> status(nt, ASTRO_SUCCESS);
+  parallel_for(nt, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    int count = static_cast<int>(end - begin);
+    std::vector<astro_time_t> moon_time(t_in.time.begin() + begin, t_in.time.begin() + end);
+    std::vector<astro_vector_t> jupiter(geocentric ? count : 0);
+    std::vector<astro_jupiter_moons_t> jm(count);
+
+    if (geocentric) {
+      Astronomy_GeoVectorBatch(BODY_JUPITER, count, &t_in.time[begin], aber, jupiter.data());
+      for (int k = 0; k < count; ++k) {
+        status[begin + k] = jupiter[k].status;
+        if (jupiter[k].status == ASTRO_SUCCESS) {
+          double light_days = Astronomy_VectorLength(jupiter[k]) / C_AUDAY;
+          moon_time[k] = Astronomy_AddDays(moon_time[k], -light_days);
+        }
+      }
+    }
+    Astronomy_JupiterMoonsBatch(count, moon_time.data(), jm.data());
+
+    for (int k = 0; k < count; ++k) {
+      R_xlen_t i = begin + k;
+      const astro_state_vector_t* states[4] = {
+        &jm[k].io, &jm[k].europa, &jm[k].ganymede, &jm[k].callisto
+      };
+      bool missing = std::isnan(t_in.posix[i]);
+      for (int m = 0; m < 4; ++m) {
+        R_xlen_t r = i * 4 + m;
+        const astro_state_vector_t& s = *states[m];
+        posix[r] = t_in.posix[i];
+        moon[r] = m + 1;
+        x[r] = missing ? NA_REAL : s.x;
+        y[r] = missing ? NA_REAL : s.y;
+        z[r] = missing ? NA_REAL : s.z;
+        vx[r] = missing ? NA_REAL : s.vx;
+        vy[r] = missing ? NA_REAL : s.vy;
+        vz[r] = missing ? NA_REAL : s.vz;
+        if (geocentric && !missing) {
+          x[r] += jupiter[k].x;
+          y[r] += jupiter[k].y;
+          z[r] += jupiter[k].z;
+        }
+      }
+      if (missing)
+        status[i] = ASTRO_SUCCESS;
+    }
+  });
+  check_batch_status(status, "Astronomy_GeoVector");
+
+  return writable::list({
+    "time"_nm = batch_output(posix),
+    "moon"_nm = batch_output(moon),
+    "x"_nm = batch_output(x),
+    "y"_nm = batch_output(y),
+    "z"_nm = batch_output(z),
+    "vx"_nm = batch_output(vx),
+    "vy"_nm = batch_output(vy),
+    "vz"_nm = batch_output(vz)
+  });
+}
+
+// ---------------------------------------------------------------------------
+// Lunar libration
+// ---------------------------------------------------------------------------
+
+// Libration angles and the Moon's ecliptic position at each of `time`
+// (POSIXct seconds or an epoch), on `nthreads` threads. The lunar series is
+// summed once per time by Astronomy_LibrationBatch(), which can also return
+// the Moon's geocentric EQJ vector from the same evaluation.
+[[cpp11::register]]
+list astro_libration_vec_(SEXP time, bool vector, int nthreads) {
+  batch_times t_in = batch_input_times(time);
+  R_xlen_t nt = t_in.size();
+
+  std::vector<astro_libration_t> lib(nt);
+  std::vector<astro_vector_t> moon(vector ? nt : 0);
+  parallel_for(nt, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    Astronomy_LibrationBatch(static_cast<int>(end - begin), &t_in.time[begin],
+                             &lib[begin], vector ? &moon[begin] : nullptr);
+  });
+
+  std::vector<double> elat(nt), elon(nt), mlat(nt), mlon(nt), dist_km(nt), diam_deg(nt);
+  std::vector<double> x(vector ? nt : 0), y(vector ? nt : 0), z(vector ? nt : 0);
+  for (R_xlen_t i = 0; i < nt; ++i) {
+    bool missing = std::isnan(t_in.posix[i]);
+    elat[i] = missing ? NA_REAL : lib[i].elat;
+    elon[i] = missing ? NA_REAL : lib[i].elon;
+    mlat[i] = missing ? NA_REAL : lib[i].mlat;
+    mlon[i] = missing ? NA_REAL : lib[i].mlon;
+    dist_km[i] = missing ? NA_REAL : lib[i].dist_km;
+    diam_deg[i] = missing ? NA_REAL : lib[i].diam_deg;
+    if (vector) {
+      x[i] = missing ? NA_REAL : moon[i].x;
+      y[i] = missing ? NA_REAL : moon[i].y;
+      z[i] = missing ? NA_REAL : moon[i].z;
+    }
+  }
+
+  writable::list result({
+    "time"_nm = batch_output(t_in.posix),
+    "elat"_nm = batch_output(elat),
+    "elon"_nm = batch_output(elon),
+    "mlat"_nm = batch_output(mlat),
+    "mlon"_nm = batch_output(mlon),
+    "dist_km"_nm = batch_output(dist_km),
+    "diam_deg"_nm = batch_output(diam_deg)
+  });
+  if (vector) {
+    result.push_back("x"_nm = batch_output(x));
+    result.push_back("y"_nm = batch_output(y));
+    result.push_back("z"_nm = batch_output(z));
+  }
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// Pluto orbit cache
+// ---------------------------------------------------------------------------
+
+// A missing start or stop time warms every segment on that side.
+[[cpp11::register]]
+void astro_pluto_cache_warm_(double start_posix, double stop_posix) {
+  astro_time_t start_time = std::isnan(start_posix)
+    ? Astronomy_TimeFromDays(-1.0e7) : posix_to_astro(start_posix);
+  astro_time_t stop_time = std::isnan(stop_posix)
+    ? Astronomy_TimeFromDays(+1.0e7) : posix_to_astro(stop_posix);
+
+  astro_status_t status = Astronomy_PlutoCacheWarm(start_time, stop_time);
+  if (status != ASTRO_SUCCESS)
+    stop("Astronomy_PlutoCacheWarm failed with status %d", status);
+}
+
+[[cpp11::register]]
+list astro_pluto_cache_info_() {
+  int segments = Astronomy_PlutoCacheCount();
+  double bytes = static_cast<double>(segments) * Astronomy_PlutoCacheSegmentBytes();
+  return writable::list({
+    "segments"_nm = segments,
+    "bytes"_nm = bytes
+  });
+}
+
+[[cpp11::register]]
+void astro_pluto_cache_free_() {
+  Astronomy_PlutoCacheFree();
+}
+
+// ---------------------------------------------------------------------------
+// Compiled planetary ephemeris
+// ---------------------------------------------------------------------------
+
+[[cpp11::register]]
+void astro_ephemeris_compile_(double start_posix, double stop_posix) {
+  if (std::isnan(start_posix) || std::isnan(stop_posix))
+    stop("`start` and `stop` must not be missing");
+
+  astro_status_t status = Astronomy_EphemerisCompile(
+    posix_to_astro(start_posix), posix_to_astro(stop_posix)
+  );
+  if (status != ASTRO_SUCCESS)
+    stop("Astronomy_EphemerisCompile failed with status %d", status);
+}
+
+[[cpp11::register]]
+list astro_ephemeris_info_() {
+  astro_ephemeris_info_t info = Astronomy_EphemerisInfo();
+  bool active = info.status == ASTRO_SUCCESS;
+  return writable::list({
+    "start"_nm = active ? astro_to_posix(info.start) : NA_REAL,
+    "stop"_nm = active ? astro_to_posix(info.stop) : NA_REAL,
+    "bytes"_nm = static_cast<double>(info.bytes)
+  });
+}
+
+[[cpp11::register]]
+void astro_ephemeris_free_() {
+  Astronomy_EphemerisFree();
+}
+
+[[cpp11::register]]
+void astro_ephemeris_write_(std::string path) {
+  astro_status_t status = Astronomy_EphemerisWrite(path.c_str());
+  if (status != ASTRO_SUCCESS)
+    stop("Astronomy_EphemerisWrite failed with status %d", status);
+}
+
+[[cpp11::register]]
+void astro_ephemeris_load_(std::string path) {
+  astro_status_t status = Astronomy_EphemerisLoad(path.c_str());
+  if (status != ASTRO_SUCCESS)
+    stop("Astronomy_EphemerisLoad failed with status %d", status);
+}
+
+// ---------------------------------------------------------------------------
+// Gravity simulator
+// ---------------------------------------------------------------------------
+
+// A gravity simulation handed to R as an external pointer. It is advanced in
+// place, so every copy of the R object refers to the same simulation. The
+// engine's structure-of-arrays simulator is used, so a step can be split
+// across threads by ranges of bodies.
+struct astro_grav_sim {
+  astro_grav_batch_t* sim = nullptr;
+  bool broken = false;    // a failed update leaves the engine state unusable
+  ~astro_grav_sim() { Astronomy_GravBatchFree(sim); }
+};
+
+static astro_grav_sim& grav_sim_from_sexp(SEXP x) {
+  external_pointer<astro_grav_sim> sim(x);
+  if (sim.get() == nullptr || sim->sim == nullptr)
+    stop("`sim` is an astro_grav_sim that is no longer valid; use astro_grav_sim_save() to keep a simulation across sessions");
+  if (sim->broken)
+    stop("`sim` failed at an earlier step and can no longer be advanced");
+  return *sim;
+}
+
+// Start a simulation of small bodies whose states at `time_posix` are given
+// relative to `origin`, in EQJ coordinates (AU and AU/day).
+[[cpp11::register]]
+SEXP astro_grav_sim_(int origin, double time_posix, doubles x, doubles y,
+                     doubles z, doubles vx, doubles vy, doubles vz) {
+  if (std::isnan(time_posix))
+    stop("`time` must not be missing");
+  R_xlen_t n = recycled_size({x.size(), y.size(), z.size(),
+                              vx.size(), vy.size(), vz.size()});
+
+  std::vector<double> rx(n), ry(n), rz(n), rvx(n), rvy(n), rvz(n);
+  for (R_xlen_t i = 0; i < n; ++i) {
+    rx[i] = x[recycle(i, x.size())];
+    ry[i] = y[recycle(i, y.size())];
+    rz[i] = z[recycle(i, z.size())];
+    rvx[i] = vx[recycle(i, vx.size())];
+    rvy[i] = vy[recycle(i, vy.size())];
+    rvz[i] = vz[recycle(i, vz.size())];
+    if (std::isnan(rx[i]) || std::isnan(ry[i]) || std::isnan(rz[i]) ||
+        std::isnan(rvx[i]) || std::isnan(rvy[i]) || std::isnan(rvz[i]))
+      stop("State vectors must not be missing (row %d)", static_cast<int>(i + 1));
+  }
+
+  astro_grav_sim* sim = new astro_grav_sim();
+  astro_status_t status = Astronomy_GravBatchInit(
+    &sim->sim, int_to_body(origin), posix_to_astro(time_posix),
+    static_cast<int>(n), rx.data(), ry.data(), rz.data(),
+    rvx.data(), rvy.data(), rvz.data()
+  );
+  if (status != ASTRO_SUCCESS) {
+    delete sim;
+    stop("Astronomy_GravBatchInit failed with status %d", status);
+  }
+  return external_pointer<astro_grav_sim>(sim);
+}
+
+[[cpp11::register]]
+list astro_grav_sim_info_(SEXP sim) {
+  external_pointer<astro_grav_sim> ptr(sim);
+  bool valid = ptr.get() != nullptr && ptr->sim != nullptr;
+  return writable::list({
+    "time"_nm = valid ? astro_to_posix(Astronomy_GravBatchTime(ptr->sim)) : NA_REAL,
+    "origin"_nm = valid ? static_cast<int>(Astronomy_GravBatchOrigin(ptr->sim)) : NA_INTEGER,
+    "bodies"_nm = valid ? Astronomy_GravBatchNumBodies(ptr->sim) : NA_INTEGER,
+    "broken"_nm = valid && ptr->broken
+  });
+}
+
+// Moves every body across a step started by Astronomy_GravBatchPrepare(),
+// split across threads, for Astronomy_GravBatchUpdateAdaptive().
+struct grav_sim_advance {
+  astro_grav_batch_t* sim;
+  int nthreads;
+  std::vector<astro_status_t> status;   // indexed by the first body of each chunk
+  std::vector<double> error;
+};
+
+static astro_status_t grav_sim_advance_all(void* context, astro_grav_batch_t* batch,
+                                           double* max_error) {
+  grav_sim_advance& a = *static_cast<grav_sim_advance*>(context);
+  int nbody = Astronomy_GravBatchNumBodies(batch);
+  std::fill(a.status.begin(), a.status.end(), ASTRO_SUCCESS);
+  std::fill(a.error.begin(), a.error.end(), 0.0);
+  parallel_for(nbody, a.nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    a.status[begin] = Astronomy_GravBatchAdvance(batch, static_cast<int>(begin),
+                                                 static_cast<int>(end - begin),
+                                                 &a.error[begin]);
+  });
+  // Chunks that were not started keep an error of 0, so they cannot hide a NaN.
+  *max_error = 0.0;
+  for (int b = 0; b < nbody; ++b) {
+    if (a.status[b] != ASTRO_SUCCESS)
+      return a.status[b];
+    if (!(a.error[b] <= *max_error))
+      *max_error = a.error[b];
+  }
+  return ASTRO_SUCCESS;
+}
+
+// Advance the simulation through each of `time_posix` in turn, returning the
+// state of every small body after every step. Rows are step x body, with the
+// body varying fastest. The planets are moved once per step on this thread;
+// the bodies are then split across `nthreads` threads. With a `tolerance`
+// (AU, NA for none) each output time is reached in as many internal steps as
+// that local error allows. The simulation is left at the last time.
+[[cpp11::register]]
+list astro_grav_sim_step_to_(SEXP sim, doubles time_posix, int nthreads,
+                             double tolerance) {
+  astro_grav_sim& g = grav_sim_from_sexp(sim);
+  std::vector<double> t_in = batch_input(time_posix);
+  for (std::size_t k = 0; k < t_in.size(); ++k) {
+    if (std::isnan(t_in[k]))
+      stop("`time` must not be missing (step %d)", static_cast<int>(k + 1));
+  }
+
+  int nbody = Astronomy_GravBatchNumBodies(g.sim);
+  R_xlen_t rows = static_cast<R_xlen_t>(t_in.size()) * nbody;
+  std::vector<double> time(rows), x(rows), y(rows), z(rows), vx(rows), vy(rows), vz(rows);
+  std::vector<int> body(rows);
+  std::vector<int> steps(t_in.size(), 1);
+  std::vector<astro_status_t> chunk_status(nbody);
+  bool adaptive = !std::isnan(tolerance);
+  if (adaptive && !(tolerance > 0.0))
+    stop("`tolerance` must be positive");
+  grav_sim_advance advance{g.sim, nthreads, std::vector<astro_status_t>(nbody),
+                           std::vector<double>(nbody)};
+
+  for (std::size_t k = 0; k < t_in.size(); ++k) {
+    astro_status_t status;
+    R_xlen_t offset = static_cast<R_xlen_t>(k) * nbody;
+    if (adaptive) {
+      status = Astronomy_GravBatchUpdateAdaptive(g.sim, posix_to_astro(t_in[k]), tolerance,
+                                                 grav_sim_advance_all, &advance, &steps[k]);
+      if (status == ASTRO_NO_CONVERGE)
+        stop("`tolerance` could not be met with the smallest internal step at step %d; "
+             "the simulation is left at its last accepted step", static_cast<int>(k + 1));
+      if (status == ASTRO_SUCCESS && nbody > 0) {
+        status = Astronomy_GravBatchState(g.sim, 0, nbody, &x[offset], &y[offset], &z[offset],
+                                          &vx[offset], &vy[offset], &vz[offset]);
+      }
+    } else {
+      status = Astronomy_GravBatchPrepare(g.sim, posix_to_astro(t_in[k]));
+      std::fill(chunk_status.begin(), chunk_status.end(), ASTRO_SUCCESS);
+    }
+    if (!adaptive && status == ASTRO_SUCCESS) {
+      parallel_for(nbody, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+        int first = static_cast<int>(begin);
+        int count = static_cast<int>(end - begin);
+        astro_status_t s = Astronomy_GravBatchAdvance(g.sim, first, count, nullptr);
+        if (s == ASTRO_SUCCESS) {
+          R_xlen_t r = offset + begin;
+          s = Astronomy_GravBatchState(g.sim, first, count, &x[r], &y[r], &z[r],
+                                       &vx[r], &vy[r], &vz[r]);
+        }
+        chunk_status[begin] = s;
+      });
+      for (int b = 0; b < nbody && status == ASTRO_SUCCESS; ++b)
+        status = chunk_status[b];
+    }
+    if (status != ASTRO_SUCCESS) {
+      g.broken = true;
+      stop("Astronomy_GravBatchUpdate failed with status %d at step %d",
+           status, static_cast<int>(k + 1));
+    }
+    for (int b = 0; b < nbody; ++b) {
+      time[offset + b] = t_in[k];
+      body[offset + b] = b + 1;
+    }
+  }
+
+  writable::list result({
+    "time"_nm = batch_output(time),
+    "body"_nm = batch_output(body),
+    "x"_nm = batch_output(x),
+    "y"_nm = batch_output(y),
+    "z"_nm = batch_output(z),
+    "vx"_nm = batch_output(vx),
+    "vy"_nm = batch_output(vy),
+    "vz"_nm = batch_output(vz)
+  });
+  result.attr("steps") = batch_output(steps);
+  return result;
+}
+
+// Write a snapshot of the simulation's current step to `path`.
+[[cpp11::register]]
+void astro_grav_sim_save_(SEXP sim, std::string path) {
+  astro_grav_sim& g = grav_sim_from_sexp(sim);
+  astro_status_t status = Astronomy_GravBatchSave(g.sim, path.c_str());
+  if (status != ASTRO_SUCCESS)
+    stop("Astronomy_GravBatchSave failed with status %d", status);
+}
+
+// Restore a simulation from a snapshot written by astro_grav_sim_save_().
+[[cpp11::register]]
+SEXP astro_grav_sim_load_(std::string path) {
+  astro_grav_sim* sim = new astro_grav_sim();
+  astro_status_t status = Astronomy_GravBatchLoad(&sim->sim, path.c_str());
+  if (status != ASTRO_SUCCESS) {
+    delete sim;
+    stop("Astronomy_GravBatchLoad failed with status %d", status);
+  }
+  return external_pointer<astro_grav_sim>(sim);
+}
+
 // ---------------------------------------------------------------------------
 // Geographic helper functions
 // ---------------------------------------------------------------------------
 
 [[cpp11::register]]
-list astro_observer_vector_(double time_posix, double latitude, 
+list astro_observer_vector_(SEXP time, double latitude, 
                             double longitude, double height,
                             bool of_date) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t observer = Astronomy_MakeObserver(latitude, longitude, height);
   astro_equator_date_t equdate = of_date ? EQUATOR_OF_DATE : EQUATOR_J2000;
 
@@ -250,10 +1228,10 @@ list astro_observer_vector_(double time_posix, double latitude,
 }
 
 [[cpp11::register]]
-list astro_observer_state_(double time_posix, double latitude,
+list astro_observer_state_(SEXP time, double latitude,
                            double longitude, double height,
                            bool of_date) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t observer = Astronomy_MakeObserver(latitude, longitude, height);
   astro_equator_date_t equdate = of_date ? EQUATOR_OF_DATE : EQUATOR_J2000;
 
@@ -322,6 +1300,167 @@ SEXP astro_search_rise_set_ex_(int body, double latitude, double longitude,
   return cpp11::as_sexp(astro_to_posix(result.time));
 }
 
+// Vectorised rise/set search over observers and start times, recycled to a
+// common length. Each run of consecutive rows sharing a start time is solved by
+// one Astronomy_SearchRiseSetGrid call, which evaluates the body once per
+// sample time for all of the run's observers. Events that do not occur within
+// `limit_days` are NA.
+[[cpp11::register]]
+doubles astro_search_rise_set_vec_(int body, doubles latitude, doubles longitude,
+                                   doubles height, doubles time_posix,
+                                   int direction, double limit_days,
+                                   double meters_above_ground) {
+  std::vector<double> lat_in = batch_input(latitude);
+  std::vector<double> lon_in = batch_input(longitude);
+  std::vector<double> h_in = batch_input(height);
+  std::vector<double> t_in = batch_input(time_posix);
+  R_xlen_t n = recycled_size({(R_xlen_t) lat_in.size(), (R_xlen_t) lon_in.size(),
+                              (R_xlen_t) h_in.size(), (R_xlen_t) t_in.size()});
+
+  astro_body_t c_body = int_to_body(body);
+  astro_direction_t c_direction = static_cast<astro_direction_t>(direction);
+  std::vector<double> time(n, NA_REAL);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  std::vector<astro_observer_t> observers;
+  std::vector<R_xlen_t> rows;
+  std::vector<astro_search_result_t> result;
+
+  R_xlen_t i = 0;
+  while (i < n) {
+    double posix = t_in[recycle(i, t_in.size())];
+    if (std::isnan(posix)) {
+      ++i;
+      continue;
+    }
+
+    observers.clear();
+    rows.clear();
+    for (; i < n && t_in[recycle(i, t_in.size())] == posix; ++i) {
+      double lat = lat_in[recycle(i, lat_in.size())];
+      double lon = lon_in[recycle(i, lon_in.size())];
+      double h = h_in[recycle(i, h_in.size())];
+      if (std::isnan(lat) || std::isnan(lon) || std::isnan(h))
+        continue;
+      observers.push_back(Astronomy_MakeObserver(lat, lon, h));
+      rows.push_back(i);
+    }
+    astro_time_t start = posix_to_astro(posix);
+    result.resize(observers.size());
+    astro_status_t grid_status = Astronomy_SearchRiseSetGrid(
+      c_body, c_direction, 1, &start, static_cast<int>(observers.size()),
+      observers.data(), limit_days, meters_above_ground, result.data()
+    );
+    for (std::size_t k = 0; k < rows.size(); ++k) {
+      if (grid_status != ASTRO_SUCCESS)
+        status[rows[k]] = grid_status;
+      else if (result[k].status == ASTRO_SUCCESS)
+        time[rows[k]] = astro_to_posix(result[k].time);
+      else if (result[k].status != ASTRO_SEARCH_FAILURE)
+        status[rows[k]] = result[k].status;
+    }
+  }
+  check_batch_status(status, "Astronomy_SearchRiseSetEx");
+
+  return batch_output(time);
+}
+
+// Rise or set times for every combination of body, direction, start time and
+// site. Sites are the recycled rows of latitude/longitude/height. Rows are
+// ordered with the site varying fastest, then the start time, direction and
+// body. For each body and direction the start times are split across
+// `nthreads` threads, which pass each start time with all the sites to
+// Astronomy_SearchRiseSetGrid so the body's position is shared between sites.
+// Events that do not occur within `limit_days` are NA.
+[[cpp11::register]]
+list astro_rise_set_table_(integers body, integers direction, doubles start_posix,
+                           doubles latitude, doubles longitude, doubles height,
+                           double limit_days, double meters_above_ground,
+                           int nthreads) {
+  std::vector<int> b_in = batch_input(body);
+  std::vector<int> d_in = batch_input(direction);
+  std::vector<double> s_in = batch_input(start_posix);
+  std::vector<double> lat_in = batch_input(latitude);
+  std::vector<double> lon_in = batch_input(longitude);
+  std::vector<double> h_in = batch_input(height);
+  R_xlen_t nsite = recycled_size({(R_xlen_t) lat_in.size(), (R_xlen_t) lon_in.size(),
+                                  (R_xlen_t) h_in.size()});
+  R_xlen_t nstart = s_in.size();
+  R_xlen_t nbody = b_in.size();
+  R_xlen_t ndir = d_in.size();
+  R_xlen_t n = nbody * ndir * nstart * nsite;
+
+  // Only sites and start times without missing values reach the engine.
+  std::vector<astro_observer_t> observers;
+  std::vector<R_xlen_t> site_index;
+  for (R_xlen_t k = 0; k < nsite; ++k) {
+    double lat = lat_in[recycle(k, lat_in.size())];
+    double lon = lon_in[recycle(k, lon_in.size())];
+    double h = h_in[recycle(k, h_in.size())];
+    if (std::isnan(lat) || std::isnan(lon) || std::isnan(h))
+      continue;
+    observers.push_back(Astronomy_MakeObserver(lat, lon, h));
+    site_index.push_back(k);
+  }
+  std::vector<astro_time_t> starts;
+  std::vector<R_xlen_t> start_index;
+  for (R_xlen_t i = 0; i < nstart; ++i) {
+    if (std::isnan(s_in[i]))
+      continue;
+    starts.push_back(posix_to_astro(s_in[i]));
+    start_index.push_back(i);
+  }
+  R_xlen_t nobs = observers.size();
+  R_xlen_t nvalid = starts.size();
+
+  std::vector<int> site_out(n), body_out(n), dir_out(n);
+  std::vector<double> start_out(n), time_out(n, NA_REAL);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  for (R_xlen_t b = 0; b < nbody; ++b) {
+    for (R_xlen_t d = 0; d < ndir; ++d) {
+      R_xlen_t base = (b * ndir + d) * nstart * nsite;
+      for (R_xlen_t i = 0; i < nstart; ++i) {
+        for (R_xlen_t k = 0; k < nsite; ++k) {
+          R_xlen_t row = base + i * nsite + k;
+          site_out[row] = static_cast<int>(k + 1);
+          body_out[row] = b_in[b];
+          dir_out[row] = d_in[d];
+          start_out[row] = s_in[i];
+        }
+      }
+
+      astro_body_t c_body = int_to_body(b_in[b]);
+      astro_direction_t c_direction = static_cast<astro_direction_t>(d_in[d]);
+      parallel_for(nvalid, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+        std::vector<astro_search_result_t> result(nobs);
+        for (R_xlen_t i = begin; i < end; ++i) {
+          astro_status_t grid_status = Astronomy_SearchRiseSetGrid(
+            c_body, c_direction, 1, &starts[i], static_cast<int>(nobs),
+            observers.data(), limit_days, meters_above_ground, result.data()
+          );
+          for (R_xlen_t k = 0; k < nobs; ++k) {
+            R_xlen_t row = base + start_index[i] * nsite + site_index[k];
+            if (grid_status != ASTRO_SUCCESS)
+              status[row] = grid_status;
+            else if (result[k].status == ASTRO_SUCCESS)
+              time_out[row] = astro_to_posix(result[k].time);
+            else if (result[k].status != ASTRO_SEARCH_FAILURE)
+              status[row] = result[k].status;
+          }
+        }
+      });
+    }
+  }
+  check_batch_status(status, "Astronomy_SearchRiseSetEx");
+
+  return writable::list({
+    "site"_nm = batch_output(site_out),
+    "body"_nm = batch_output(body_out),
+    "direction"_nm = batch_output(dir_out),
+    "start"_nm = batch_output(start_out),
+    "time"_nm = batch_output(time_out)
+  });
+}
+
 [[cpp11::register]]
 SEXP astro_search_altitude_(int body, double latitude, double longitude,
                             double height, double time_posix, int direction,
@@ -386,8 +1525,8 @@ double astro_hour_angle_(int body, double latitude, double longitude,
 // ---------------------------------------------------------------------------
 
 [[cpp11::register]]
-double astro_moon_phase_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+double astro_moon_phase_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_angle_result_t result = Astronomy_MoonPhase(t);
   if (result.status != ASTRO_SUCCESS)
     stop("Astronomy_MoonPhase failed with status %d", result.status);
@@ -405,6 +1544,57 @@ double astro_search_moon_phase_(double target_lon, double start_time_posix, doub
   return astro_to_posix(result.time);
 }
 
+// Vectorised over `target_lon`, `start_posix` and `limit_days` (all recycled)
+// and evaluated on `nthreads` threads, each passing its rows to
+// Astronomy_SearchMoonPhaseBatch. Rows with no such phase within the limit,
+// or with missing inputs, give NA.
+[[cpp11::register]]
+doubles astro_search_moon_phase_vec_(doubles target_lon, doubles start_posix,
+                                     doubles limit_days, int nthreads) {
+  std::vector<double> lon_in = batch_input(target_lon);
+  std::vector<double> t_in = batch_input(start_posix);
+  std::vector<double> lim_in = batch_input(limit_days);
+  R_xlen_t n = recycled_size({(R_xlen_t) lon_in.size(), (R_xlen_t) t_in.size(),
+                              (R_xlen_t) lim_in.size()});
+
+  std::vector<double> time(n, NA_REAL);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  parallel_for(n, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    std::vector<double> lon, lim;
+    std::vector<astro_time_t> start;
+    std::vector<R_xlen_t> rows;
+    for (R_xlen_t i = begin; i < end; ++i) {
+      double l = lon_in[recycle(i, lon_in.size())];
+      double t = t_in[recycle(i, t_in.size())];
+      double d = lim_in[recycle(i, lim_in.size())];
+      if (std::isnan(l) || std::isnan(t) || std::isnan(d))
+        continue;
+      lon.push_back(l);
+      start.push_back(posix_to_astro(t));
+      lim.push_back(d);
+      rows.push_back(i);
+    }
+
+    std::vector<astro_search_result_t> found(rows.size());
+    astro_status_t batch_status = Astronomy_SearchMoonPhaseBatch(
+      static_cast<int>(rows.size()), lon.data(), start.data(), lim.data(),
+      found.data()
+    );
+    for (std::size_t k = 0; k < rows.size(); ++k) {
+      R_xlen_t i = rows[k];
+      if (batch_status != ASTRO_SUCCESS)
+        status[i] = batch_status;
+      else if (found[k].status == ASTRO_SUCCESS)
+        time[i] = astro_to_posix(found[k].time);
+      else if (found[k].status != ASTRO_NO_MOON_QUARTER)
+        status[i] = found[k].status;
+    }
+  });
+  check_batch_status(status, "Astronomy_SearchMoonPhase");
+
+  return batch_output(time);
+}
+
 [[cpp11::register]]
 cpp11::list astro_search_moon_quarter_(double start_time_posix) {
   astro_time_t start_t = posix_to_astro(start_time_posix);
@@ -436,6 +1626,73 @@ cpp11::list astro_next_moon_quarter_(int quarter, double time_posix) {
   });
 }
 
+// Lists the lunar quarters from `start_posix` up to `end_posix` as columns
+// `quarter` and `time`. After the first quarter, the following ones are
+// searched in blocks with Astronomy_SearchMoonPhaseBatch, carrying the last
+// quarter found forward: each search starts half a quarter-lunation before its
+// quarter's mean time and looks at most a quarter-lunation ahead.
+[[cpp11::register]]
+list astro_moon_quarters_(double start_posix, double end_posix) {
+  if (std::isnan(start_posix) || std::isnan(end_posix))
+    stop("`start` and `end` must not be missing");
+
+  const double quarter_days = 29.530588 / 4.0;
+  const int block = 64;
+  std::vector<int> quarter_out;
+  std::vector<double> time_out;
+
+  astro_time_t end_t = posix_to_astro(end_posix);
+  astro_moon_quarter_t mq = Astronomy_SearchMoonQuarter(posix_to_astro(start_posix));
+  if (mq.status != ASTRO_SUCCESS)
+    stop("Astronomy_SearchMoonQuarter failed with status %d", mq.status);
+
+  astro_time_t last = mq.time;
+  int last_quarter = mq.quarter;
+  bool done = last.ut > end_t.ut;
+  if (!done) {
+    quarter_out.push_back(last_quarter);
+    time_out.push_back(astro_to_posix(last));
+  }
+
+  double target[block], limit[block];
+  astro_time_t start[block];
+  astro_search_result_t found[block];
+  while (!done) {
+    int count = static_cast<int>(std::ceil((end_t.ut - last.ut) / quarter_days)) + 1;
+    if (count > block)
+      count = block;
+    for (int j = 0; j < count; ++j) {
+      target[j] = 90.0 * ((last_quarter + j + 1) % 4);
+      start[j] = Astronomy_AddDays(last, (j + 0.5) * quarter_days);
+      limit[j] = quarter_days;
+    }
+
+    astro_status_t status = Astronomy_SearchMoonPhaseBatch(count, target, start, limit, found);
+    for (int j = 0; status == ASTRO_SUCCESS && j < count; ++j) {
+      if (found[j].status != ASTRO_SUCCESS) {
+        status = found[j].status;
+      } else if (found[j].time.ut <= last.ut) {
+        status = ASTRO_WRONG_MOON_QUARTER;
+      } else if (found[j].time.ut > end_t.ut) {
+        done = true;
+        break;
+      } else {
+        last = found[j].time;
+        last_quarter = (last_quarter + 1) % 4;
+        quarter_out.push_back(last_quarter);
+        time_out.push_back(astro_to_posix(last));
+      }
+    }
+    if (status != ASTRO_SUCCESS)
+      stop("Astronomy_SearchMoonPhase failed with status %d", status);
+  }
+
+  return writable::list({
+    "quarter"_nm = batch_output(quarter_out),
+    "time"_nm = batch_output(time_out)
+  });
+}
+
 // ---------------------------------------------------------------------------
 // Eclipses and Transits
 // ---------------------------------------------------------------------------
@@ -562,6 +1819,250 @@ list next_local_solar_eclipse_(double prev_eclipse_time, double latitude, double
   return local_eclipse_to_list(eclipse);
 }
 
+// Runs one of the Astronomy_*EclipseCatalog functions, passed as `catalog`,
+// over [start_posix, end_posix). The span is split into `nthreads` consecutive
+// ranges, which hold independent sets of lunations, searched on separate
+// threads; their eclipses are concatenated in time order.
+template <typename T, typename F>
+static std::vector<T> eclipse_catalog(double start_posix, double end_posix,
+                                      int nthreads, F catalog, const char* what) {
+  if (std::isnan(start_posix) || std::isnan(end_posix))
+    stop("`start` and `end` must not be missing");
+
+  R_xlen_t npiece = std::max(nthreads, 1);
+  double span = (end_posix - start_posix) / npiece;
+  std::vector<std::vector<T>> pieces(npiece);
+  std::vector<astro_status_t> status(npiece, ASTRO_SUCCESS);
+  parallel_for(npiece, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    for (R_xlen_t i = begin; i < end; ++i) {
+      astro_time_t t1 = posix_to_astro(start_posix + i * span);
+      astro_time_t t2 = posix_to_astro(i + 1 == npiece ? end_posix : start_posix + (i + 1) * span);
+      // At most one eclipse per lunation.
+      int capacity = 2 + static_cast<int>(std::ceil(std::max(t2.ut - t1.ut, 0.0) / 29.5));
+      int count = 0;
+      pieces[i].resize(capacity);
+      status[i] = catalog(t1, t2, capacity, pieces[i].data(), &count);
+      pieces[i].resize(count);
+    }
+  });
+  for (astro_status_t s : status) {
+    if (s != ASTRO_SUCCESS)
+      stop("%s failed with status %d", what, s);
+  }
+
+  std::vector<T> out;
+  for (const std::vector<T>& piece : pieces)
+    out.insert(out.end(), piece.begin(), piece.end());
+  return out;
+}
+
+[[cpp11::register]]
+list astro_lunar_eclipses_(double start_posix, double end_posix, int nthreads) {
+  std::vector<astro_lunar_eclipse_t> eclipse = eclipse_catalog<astro_lunar_eclipse_t>(
+    start_posix, end_posix, nthreads, Astronomy_LunarEclipseCatalog,
+    "Astronomy_LunarEclipseCatalog"
+  );
+
+  std::size_t n = eclipse.size();
+  std::vector<int> kind(n);
+  std::vector<double> obscuration(n), peak(n), sd_total(n), sd_partial(n), sd_penum(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    kind[i] = static_cast<int>(eclipse[i].kind);
+    obscuration[i] = eclipse[i].obscuration;
+    peak[i] = astro_to_posix(eclipse[i].peak);
+    sd_total[i] = eclipse[i].sd_total;
+    sd_partial[i] = eclipse[i].sd_partial;
+    sd_penum[i] = eclipse[i].sd_penum;
+  }
+
+  return writable::list({
+    "kind"_nm = batch_output(kind),
+    "obscuration"_nm = batch_output(obscuration),
+    "peak"_nm = batch_output(peak),
+    "sd_total"_nm = batch_output(sd_total),
+    "sd_partial"_nm = batch_output(sd_partial),
+    "sd_penum"_nm = batch_output(sd_penum)
+  });
+}
+
+[[cpp11::register]]
+list astro_global_solar_eclipses_(double start_posix, double end_posix, int nthreads) {
+  std::vector<astro_global_solar_eclipse_t> eclipse = eclipse_catalog<astro_global_solar_eclipse_t>(
+    start_posix, end_posix, nthreads, Astronomy_GlobalSolarEclipseCatalog,
+    "Astronomy_GlobalSolarEclipseCatalog"
+  );
+
+  std::size_t n = eclipse.size();
+  std::vector<int> kind(n);
+  std::vector<double> obscuration(n), peak(n), distance(n), latitude(n), longitude(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    kind[i] = static_cast<int>(eclipse[i].kind);
+    obscuration[i] = eclipse[i].obscuration;
+    peak[i] = astro_to_posix(eclipse[i].peak);
+    distance[i] = eclipse[i].distance;
+    latitude[i] = eclipse[i].latitude;
+    longitude[i] = eclipse[i].longitude;
+  }
+
+  return writable::list({
+    "kind"_nm = batch_output(kind),
+    "obscuration"_nm = batch_output(obscuration),
+    "peak"_nm = batch_output(peak),
+    "distance"_nm = batch_output(distance),
+    "latitude"_nm = batch_output(latitude),
+    "longitude"_nm = batch_output(longitude)
+  });
+}
+
+// Columns of local solar eclipse results, one row per eclipse. The total phase
+// events of a partial eclipse, and every field of an eclipse that was not seen
+// (kind ECLIPSE_NONE), are NA.
+struct local_eclipse_columns {
+  std::vector<int> kind;
+  std::vector<double> obscuration;
+  std::vector<double> partial_begin, total_begin, peak, total_end, partial_end;
+  std::vector<double> partial_begin_alt, total_begin_alt, peak_alt, total_end_alt,
+    partial_end_alt;
+
+  void push_back(const astro_local_solar_eclipse_t& e) {
+    bool seen = e.kind != ECLIPSE_NONE;
+    bool central = e.kind == ECLIPSE_ANNULAR || e.kind == ECLIPSE_TOTAL;
+    kind.push_back(static_cast<int>(e.kind));
+    obscuration.push_back(seen ? e.obscuration : NA_REAL);
+    push_event(e.partial_begin, seen, partial_begin, partial_begin_alt);
+    push_event(e.total_begin, central, total_begin, total_begin_alt);
+    push_event(e.peak, seen, peak, peak_alt);
+    push_event(e.total_end, central, total_end, total_end_alt);
+    push_event(e.partial_end, seen, partial_end, partial_end_alt);
+  }
+
+  static void push_event(const astro_eclipse_event_t& evt, bool valid,
+                         std::vector<double>& time, std::vector<double>& altitude) {
+    time.push_back(valid ? astro_to_posix(evt.time) : NA_REAL);
+    altitude.push_back(valid ? evt.altitude : NA_REAL);
+  }
+};
+
+[[cpp11::register]]
+list astro_local_solar_eclipses_(double start_posix, double end_posix, double latitude,
+                                 double longitude, double height, int nthreads) {
+  astro_observer_t observer = Astronomy_MakeObserver(latitude, longitude, height);
+  std::vector<astro_local_solar_eclipse_t> eclipse = eclipse_catalog<astro_local_solar_eclipse_t>(
+    start_posix, end_posix, nthreads,
+    [observer](astro_time_t t1, astro_time_t t2, int capacity,
+               astro_local_solar_eclipse_t* out, int* count) {
+      return Astronomy_LocalSolarEclipseCatalog(t1, t2, observer, capacity, out, count);
+    },
+    "Astronomy_LocalSolarEclipseCatalog"
+  );
+
+  local_eclipse_columns col;
+  for (const astro_local_solar_eclipse_t& e : eclipse)
+    col.push_back(e);
+
+  return writable::list({
+    "kind"_nm = batch_output(col.kind),
+    "obscuration"_nm = batch_output(col.obscuration),
+    "partial_begin"_nm = batch_output(col.partial_begin),
+    "partial_begin_altitude"_nm = batch_output(col.partial_begin_alt),
+    "total_begin"_nm = batch_output(col.total_begin),
+    "total_begin_altitude"_nm = batch_output(col.total_begin_alt),
+    "peak"_nm = batch_output(col.peak),
+    "peak_altitude"_nm = batch_output(col.peak_alt),
+    "total_end"_nm = batch_output(col.total_end),
+    "total_end_altitude"_nm = batch_output(col.total_end_alt),
+    "partial_end"_nm = batch_output(col.partial_end),
+    "partial_end_altitude"_nm = batch_output(col.partial_end_alt)
+  });
+}
+
+// Local circumstances of every solar eclipse in [start_posix, end_posix) for
+// every site, one row per eclipse and site with the site varying fastest.
+// The global eclipses are catalogued first; then, for each one, the sites are
+// split across `nthreads` threads, which pass them to
+// Astronomy_LocalSolarEclipseGrid so the Sun and Moon are shared between
+// sites. Sites that do not see an eclipse have kind 0 and NA times; sites
+// with missing coordinates are NA throughout.
+[[cpp11::register]]
+list astro_local_solar_eclipse_grid_(double start_posix, double end_posix,
+                                     doubles latitude, doubles longitude,
+                                     doubles height, int nthreads) {
+  std::vector<astro_global_solar_eclipse_t> global = eclipse_catalog<astro_global_solar_eclipse_t>(
+    start_posix, end_posix, nthreads, Astronomy_GlobalSolarEclipseCatalog,
+    "Astronomy_GlobalSolarEclipseCatalog"
+  );
+
+  std::vector<double> lat_in = batch_input(latitude);
+  std::vector<double> lon_in = batch_input(longitude);
+  std::vector<double> h_in = batch_input(height);
+  R_xlen_t nsite = recycled_size({(R_xlen_t) lat_in.size(), (R_xlen_t) lon_in.size(),
+                                  (R_xlen_t) h_in.size()});
+
+  std::vector<astro_observer_t> observers;
+  std::vector<R_xlen_t> site_index;
+  for (R_xlen_t k = 0; k < nsite; ++k) {
+    double lat = lat_in[recycle(k, lat_in.size())];
+    double lon = lon_in[recycle(k, lon_in.size())];
+    double h = h_in[recycle(k, h_in.size())];
+    if (std::isnan(lat) || std::isnan(lon) || std::isnan(h))
+      continue;
+    observers.push_back(Astronomy_MakeObserver(lat, lon, h));
+    site_index.push_back(k);
+  }
+  R_xlen_t nobs = observers.size();
+
+  std::vector<int> site_out;
+  std::vector<double> eclipse_out;
+  local_eclipse_columns col;
+  std::vector<astro_local_solar_eclipse_t> local(nobs);
+  astro_local_solar_eclipse_t missing = {};
+  missing.kind = ECLIPSE_NONE;
+  for (const astro_global_solar_eclipse_t& g : global) {
+    std::vector<astro_status_t> status(nobs, ASTRO_SUCCESS);
+    parallel_for(nobs, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+      astro_status_t grid_status = Astronomy_LocalSolarEclipseGrid(
+        g.peak, static_cast<int>(end - begin), &observers[begin], &local[begin]
+      );
+      for (R_xlen_t k = begin; k < end; ++k) {
+        if (grid_status != ASTRO_SUCCESS)
+          status[k] = grid_status;
+        else if (local[k].status != ASTRO_SUCCESS)
+          status[k] = local[k].status;
+      }
+    });
+    check_batch_status(status, "Astronomy_LocalSolarEclipseGrid");
+
+    R_xlen_t j = 0;
+    for (R_xlen_t k = 0; k < nsite; ++k) {
+      site_out.push_back(static_cast<int>(k + 1));
+      eclipse_out.push_back(astro_to_posix(g.peak));
+      if (j < nobs && site_index[j] == k) {
+        col.push_back(local[j++]);
+      } else {
+        col.push_back(missing);
+        col.kind.back() = NA_INTEGER;
+      }
+    }
+  }
+
+  return writable::list({
+    "site"_nm = batch_output(site_out),
+    "eclipse"_nm = batch_output(eclipse_out),
+    "kind"_nm = batch_output(col.kind),
+    "obscuration"_nm = batch_output(col.obscuration),
+    "partial_begin"_nm = batch_output(col.partial_begin),
+    "partial_begin_altitude"_nm = batch_output(col.partial_begin_alt),
+    "total_begin"_nm = batch_output(col.total_begin),
+    "total_begin_altitude"_nm = batch_output(col.total_begin_alt),
+    "peak"_nm = batch_output(col.peak),
+    "peak_altitude"_nm = batch_output(col.peak_alt),
+    "total_end"_nm = batch_output(col.total_end),
+    "total_end_altitude"_nm = batch_output(col.total_end_alt),
+    "partial_end"_nm = batch_output(col.partial_end),
+    "partial_end_altitude"_nm = batch_output(col.partial_end_alt)
+  });
+}
+
 [[cpp11::register]]
 list astro_search_transit_(int body, double start_time_posix) {
   astro_time_t startTime = posix_to_astro(start_time_posix);
@@ -683,9 +2184,9 @@ list next_planet_apsis_(int body, list apsis_list) {
 // ---------------------------------------------------------------------------
 
 [[cpp11::register]]
-list astro_illumination_(int body, double time_posix) {
+list astro_illumination_(int body, SEXP time) {
   astro_body_t c_body = static_cast<astro_body_t>(body);
-  astro_time_t c_time = posix_to_astro(time_posix);
+  astro_time_t c_time = scalar_time(time);
   
   astro_illum_t illum = Astronomy_Illumination(c_body, c_time);
   if (illum.status != ASTRO_SUCCESS)
@@ -818,6 +2319,55 @@ list astro_seasons_(int year) {
   });
 }
 
+// Vectorised over `year`, returning one column per season change. The years are
+// split across `nthreads` threads, which pass their runs of years without
+// missing values to Astronomy_SeasonsBatch; consecutive years are seeded from
+// the year before. Missing years give NA.
+[[cpp11::register]]
+list astro_seasons_vec_(integers year, int nthreads) {
+  std::vector<int> y_in = batch_input(year);
+  R_xlen_t n = y_in.size();
+
+  std::vector<double> mar(n, NA_REAL), jun(n, NA_REAL), sep(n, NA_REAL), dec(n, NA_REAL);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  parallel_for(n, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    std::vector<int> years;
+    std::vector<R_xlen_t> rows;
+    for (R_xlen_t i = begin; i < end; ++i) {
+      if (y_in[i] == NA_INTEGER)
+        continue;
+      years.push_back(y_in[i]);
+      rows.push_back(i);
+    }
+
+    std::vector<astro_seasons_t> found(rows.size());
+    astro_status_t batch_status = Astronomy_SeasonsBatch(
+      static_cast<int>(rows.size()), years.data(), found.data()
+    );
+    for (std::size_t k = 0; k < rows.size(); ++k) {
+      R_xlen_t i = rows[k];
+      if (batch_status != ASTRO_SUCCESS) {
+        status[i] = batch_status;
+      } else if (found[k].status != ASTRO_SUCCESS) {
+        status[i] = found[k].status;
+      } else {
+        mar[i] = astro_to_posix(found[k].mar_equinox);
+        jun[i] = astro_to_posix(found[k].jun_solstice);
+        sep[i] = astro_to_posix(found[k].sep_equinox);
+        dec[i] = astro_to_posix(found[k].dec_solstice);
+      }
+    }
+  });
+  check_batch_status(status, "Astronomy_Seasons");
+
+  return writable::list({
+    "mar_equinox"_nm = batch_output(mar),
+    "jun_solstice"_nm = batch_output(jun),
+    "sep_equinox"_nm = batch_output(sep),
+    "dec_solstice"_nm = batch_output(dec)
+  });
+}
+
 // ---------------------------------------------------------------------------
 // Lunar apsis (perigee / apogee)
 // ---------------------------------------------------------------------------
@@ -855,13 +2405,77 @@ list astro_constellation_(double ra, double dec) {
   });
 }
 
+[[cpp11::register]]
+list astro_constellation_vec_(doubles ra, doubles dec, int nthreads) {
+  std::vector<double> ra_in = batch_input(ra);
+  std::vector<double> dec_in = batch_input(dec);
+  R_xlen_t n = recycled_size({(R_xlen_t) ra_in.size(), (R_xlen_t) dec_in.size()});
+
+  std::vector<int> code(n, NA_INTEGER);
+  std::vector<double> ra_1875(n, NA_REAL), dec_1875(n, NA_REAL);
+  std::vector<astro_status_t> status(n, ASTRO_SUCCESS);
+  parallel_for(n, nthreads, [&](R_xlen_t begin, R_xlen_t end) {
+    std::vector<double> r, d;
+    std::vector<R_xlen_t> rows;
+    for (R_xlen_t i = begin; i < end; ++i) {
+      double a = ra_in[recycle(i, ra_in.size())];
+      double b = dec_in[recycle(i, dec_in.size())];
+      if (std::isnan(a) || std::isnan(b))
+        continue;
+      r.push_back(a);
+      d.push_back(b);
+      rows.push_back(i);
+    }
+
+    std::vector<int> index(rows.size());
+    std::vector<double> b_ra(rows.size()), b_dec(rows.size());
+    astro_status_t batch_status = Astronomy_ConstellationBatch(
+      static_cast<int>(rows.size()), r.data(), d.data(),
+      index.data(), b_ra.data(), b_dec.data()
+    );
+    for (std::size_t k = 0; k < rows.size(); ++k) {
+      R_xlen_t i = rows[k];
+      if (batch_status != ASTRO_SUCCESS) {
+        status[i] = batch_status;
+      } else if (index[k] < 0) {
+        status[i] = ASTRO_INVALID_PARAMETER;
+      } else {
+        code[i] = index[k] + 1;
+        ra_1875[i] = b_ra[k];
+        dec_1875[i] = b_dec[k];
+      }
+    }
+  });
+  check_batch_status(status, "Astronomy_Constellation");
+
+  return writable::list({
+    "code"_nm = batch_output(code),
+    "ra_1875"_nm = batch_output(ra_1875),
+    "dec_1875"_nm = batch_output(dec_1875)
+  });
+}
+
+[[cpp11::register]]
+list astro_constellations_() {
+  writable::strings symbol, name;
+  for (int i = 0; *Astronomy_ConstellationSymbol(i) != '\0'; ++i) {
+    symbol.push_back(Astronomy_ConstellationSymbol(i));
+    name.push_back(Astronomy_ConstellationName(i));
+  }
+
+  return writable::list({
+    "symbol"_nm = symbol,
+    "name"_nm = name
+  });
+}
+
 // ---------------------------------------------------------------------------
 // Heliocentric distance
 // ---------------------------------------------------------------------------
 
 [[cpp11::register]]
-double astro_helio_distance_(int body, double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+double astro_helio_distance_(int body, SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_func_result_t result = Astronomy_HelioDistance(int_to_body(body), t);
   if (result.status != ASTRO_SUCCESS)
     stop("Astronomy_HelioDistance failed with status %d", result.status);
@@ -1028,9 +2642,9 @@ static list equatorial_to_list(astro_equatorial_t equ) {
 }
 
 [[cpp11::register]]
-list astro_vector_from_sphere_(list sphere, double time_posix) {
+list astro_vector_from_sphere_(list sphere, SEXP time) {
   astro_spherical_t sph = list_to_spherical(sphere);
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_vector_t vec = Astronomy_VectorFromSphere(sph, t);
   return vector_to_list(vec);
 }
@@ -1050,9 +2664,9 @@ list astro_equator_from_vector_(list vector) {
 }
 
 [[cpp11::register]]
-list astro_vector_from_horizon_(list sphere, double time_posix, int refraction) {
+list astro_vector_from_horizon_(list sphere, SEXP time, int refraction) {
   astro_spherical_t sph = list_to_spherical(sphere);
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_refraction_t ref = static_cast<astro_refraction_t>(refraction);
   astro_vector_t vec = Astronomy_VectorFromHorizon(sph, t, ref);
   return vector_to_list(vec);
@@ -1071,45 +2685,45 @@ list astro_horizon_from_vector_(list vector, int refraction) {
 // ---------------------------------------------------------------------------
 
 [[cpp11::register]]
-doubles astro_rotation_eqd_eqj_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_eqd_eqj_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_EQD_EQJ(&t);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_eqd_ect_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_eqd_ect_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_EQD_ECT(&t);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_eqd_ecl_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_eqd_ecl_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_EQD_ECL(&t);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_eqd_hor_(double time_posix, double latitude,
+doubles astro_rotation_eqd_hor_(SEXP time, double latitude,
                                 double longitude, double height) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t obs = Astronomy_MakeObserver(latitude, longitude, height);
   astro_rotation_t rot = Astronomy_Rotation_EQD_HOR(&t, obs);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_eqj_eqd_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_eqj_eqd_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_EQJ_EQD(&t);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_eqj_ect_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_eqj_ect_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_EQJ_ECT(&t);
   return rotation_to_matrix(rot);
 }
@@ -1121,31 +2735,31 @@ doubles astro_rotation_eqj_ecl_() {
 }
 
 [[cpp11::register]]
-doubles astro_rotation_eqj_hor_(double time_posix, double latitude,
+doubles astro_rotation_eqj_hor_(SEXP time, double latitude,
                                 double longitude, double height) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t obs = Astronomy_MakeObserver(latitude, longitude, height);
   astro_rotation_t rot = Astronomy_Rotation_EQJ_HOR(&t, obs);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_ect_eqd_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_ect_eqd_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_ECT_EQD(&t);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_ect_eqj_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_ect_eqj_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_ECT_EQJ(&t);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_ecl_eqd_(double time_posix) {
-  astro_time_t t = posix_to_astro(time_posix);
+doubles astro_rotation_ecl_eqd_(SEXP time) {
+  astro_time_t t = scalar_time(time);
   astro_rotation_t rot = Astronomy_Rotation_ECL_EQD(&t);
   return rotation_to_matrix(rot);
 }
@@ -1157,36 +2771,36 @@ doubles astro_rotation_ecl_eqj_() {
 }
 
 [[cpp11::register]]
-doubles astro_rotation_ecl_hor_(double time_posix, double latitude,
+doubles astro_rotation_ecl_hor_(SEXP time, double latitude,
                                 double longitude, double height) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t obs = Astronomy_MakeObserver(latitude, longitude, height);
   astro_rotation_t rot = Astronomy_Rotation_ECL_HOR(&t, obs);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_hor_eqd_(double time_posix, double latitude,
+doubles astro_rotation_hor_eqd_(SEXP time, double latitude,
                                 double longitude, double height) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t obs = Astronomy_MakeObserver(latitude, longitude, height);
   astro_rotation_t rot = Astronomy_Rotation_HOR_EQD(&t, obs);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_hor_eqj_(double time_posix, double latitude,
+doubles astro_rotation_hor_eqj_(SEXP time, double latitude,
                                 double longitude, double height) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t obs = Astronomy_MakeObserver(latitude, longitude, height);
   astro_rotation_t rot = Astronomy_Rotation_HOR_EQJ(&t, obs);
   return rotation_to_matrix(rot);
 }
 
 [[cpp11::register]]
-doubles astro_rotation_hor_ecl_(double time_posix, double latitude,
+doubles astro_rotation_hor_ecl_(SEXP time, double latitude,
                                 double longitude, double height) {
-  astro_time_t t = posix_to_astro(time_posix);
+  astro_time_t t = scalar_time(time);
   astro_observer_t obs = Astronomy_MakeObserver(latitude, longitude, height);
   astro_rotation_t rot = Astronomy_Rotation_HOR_ECL(&t, obs);
   return rotation_to_matrix(rot);
@@ -20,6 +20,63 @@ extern "C" SEXP _astronomyengine_astro_current_time_() {
   END_CPP11
 }
 // astronomy_wrapper.cpp
+int astro_get_delta_t_model_();
+extern "C" SEXP _astronomyengine_astro_get_delta_t_model_() {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_get_delta_t_model_());
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+void astro_set_delta_t_model_(int code);
+extern "C" SEXP _astronomyengine_astro_set_delta_t_model_(SEXP code) {
+  BEGIN_CPP11
+    astro_set_delta_t_model_(cpp11::as_cpp<cpp11::decay_t<int>>(code));
+    return R_NilValue;
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+doubles astro_delta_t_(doubles time_posix, int code);
+extern "C" SEXP _astronomyengine_astro_delta_t_(SEXP time_posix, SEXP code) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_delta_t_(cpp11::as_cpp<cpp11::decay_t<doubles>>(time_posix), cpp11::as_cpp<cpp11::decay_t<int>>(code)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+SEXP astro_epoch_(doubles time_posix);
+extern "C" SEXP _astronomyengine_astro_epoch_(SEXP time_posix) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_epoch_(cpp11::as_cpp<cpp11::decay_t<doubles>>(time_posix)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+doubles astro_epoch_time_(SEXP epoch);
+extern "C" SEXP _astronomyengine_astro_epoch_time_(SEXP epoch) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_epoch_time_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(epoch)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+SEXP astro_epoch_subset_(SEXP epoch, integers i);
+extern "C" SEXP _astronomyengine_astro_epoch_subset_(SEXP epoch, SEXP i) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_epoch_subset_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(epoch), cpp11::as_cpp<cpp11::decay_t<integers>>(i)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+doubles astro_sidereal_time_vec_(SEXP time, doubles longitude, bool apparent, int nthreads);
+extern "C" SEXP _astronomyengine_astro_sidereal_time_vec_(SEXP time, SEXP longitude, SEXP apparent, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_sidereal_time_vec_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<doubles>>(longitude), cpp11::as_cpp<cpp11::decay_t<bool>>(apparent), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+doubles astro_earth_rotation_angle_vec_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_earth_rotation_angle_vec_(SEXP time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_earth_rotation_angle_vec_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
 std::string astro_body_name_(int body);
 extern "C" SEXP _astronomyengine_astro_body_name_(SEXP body) {
   BEGIN_CPP11
@@ -34,80 +91,220 @@ extern "C" SEXP _astronomyengine_astro_body_code_(SEXP name) {
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_helio_vector_(int body, double time_posix);
-extern "C" SEXP _astronomyengine_astro_helio_vector_(SEXP body, SEXP time_posix) {
+list astro_helio_vector_(int body, SEXP time);
+extern "C" SEXP _astronomyengine_astro_helio_vector_(SEXP body, SEXP time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_helio_vector_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_helio_vector_vec_(integers body, SEXP time);
+extern "C" SEXP _astronomyengine_astro_helio_vector_vec_(SEXP body, SEXP time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_helio_vector_vec_(cpp11::as_cpp<cpp11::decay_t<integers>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_equator_(int body, SEXP time, double latitude, double longitude, double height, bool of_date, bool aberration);
+extern "C" SEXP _astronomyengine_astro_equator_(SEXP body, SEXP time, SEXP latitude, SEXP longitude, SEXP height, SEXP of_date, SEXP aberration) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_equator_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height), cpp11::as_cpp<cpp11::decay_t<bool>>(of_date), cpp11::as_cpp<cpp11::decay_t<bool>>(aberration)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_equator_vec_(integers body, SEXP time, doubles latitude, doubles longitude, doubles height, bool of_date, bool aberration, int nthreads);
+extern "C" SEXP _astronomyengine_astro_equator_vec_(SEXP body, SEXP time, SEXP latitude, SEXP longitude, SEXP height, SEXP of_date, SEXP aberration, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_equator_vec_(cpp11::as_cpp<cpp11::decay_t<integers>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<doubles>>(latitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(longitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(height), cpp11::as_cpp<cpp11::decay_t<bool>>(of_date), cpp11::as_cpp<cpp11::decay_t<bool>>(aberration), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_sun_position_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_sun_position_(SEXP time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_sun_position_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_ecliptic_(double x, double y, double z, SEXP time);
+extern "C" SEXP _astronomyengine_astro_ecliptic_(SEXP x, SEXP y, SEXP z, SEXP time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_ecliptic_(cpp11::as_cpp<cpp11::decay_t<double>>(x), cpp11::as_cpp<cpp11::decay_t<double>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(z), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+double astro_ecliptic_longitude_(int body, SEXP time);
+extern "C" SEXP _astronomyengine_astro_ecliptic_longitude_(SEXP body, SEXP time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_ecliptic_longitude_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_horizon_(SEXP time, double lat, double lon, double ra, double dec, int refraction);
+extern "C" SEXP _astronomyengine_astro_horizon_(SEXP time, SEXP lat, SEXP lon, SEXP ra, SEXP dec, SEXP refraction) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_horizon_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon), cpp11::as_cpp<cpp11::decay_t<double>>(ra), cpp11::as_cpp<cpp11::decay_t<double>>(dec), cpp11::as_cpp<cpp11::decay_t<int>>(refraction)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_horizon_vec_(SEXP time, doubles lat, doubles lon, doubles ra, doubles dec, int refraction, int nthreads);
+extern "C" SEXP _astronomyengine_astro_horizon_vec_(SEXP time, SEXP lat, SEXP lon, SEXP ra, SEXP dec, SEXP refraction, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_horizon_vec_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<doubles>>(lat), cpp11::as_cpp<cpp11::decay_t<doubles>>(lon), cpp11::as_cpp<cpp11::decay_t<doubles>>(ra), cpp11::as_cpp<cpp11::decay_t<doubles>>(dec), cpp11::as_cpp<cpp11::decay_t<int>>(refraction), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_pair_longitude_(int body1, int body2, SEXP time);
+extern "C" SEXP _astronomyengine_astro_pair_longitude_(SEXP body1, SEXP body2, SEXP time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_pair_longitude_(cpp11::as_cpp<cpp11::decay_t<int>>(body1), cpp11::as_cpp<cpp11::decay_t<int>>(body2), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_geo_vector_(int body, SEXP time, int aberration);
+extern "C" SEXP _astronomyengine_astro_geo_vector_(SEXP body, SEXP time, SEXP aberration) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_geo_vector_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<int>>(aberration)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_geo_vector_vec_(integers body, SEXP time, int aberration, int nthreads);
+extern "C" SEXP _astronomyengine_astro_geo_vector_vec_(SEXP body, SEXP time, SEXP aberration, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_helio_vector_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_geo_vector_vec_(cpp11::as_cpp<cpp11::decay_t<integers>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<int>>(aberration), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_equator_(int body, double time_posix, double latitude, double longitude, double height, bool of_date, bool aberration);
-extern "C" SEXP _astronomyengine_astro_equator_(SEXP body, SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height, SEXP of_date, SEXP aberration) {
+list astro_bary_state_(int body, SEXP time);
+extern "C" SEXP _astronomyengine_astro_bary_state_(SEXP body, SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_equator_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height), cpp11::as_cpp<cpp11::decay_t<bool>>(of_date), cpp11::as_cpp<cpp11::decay_t<bool>>(aberration)));
+    return cpp11::as_sexp(astro_bary_state_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_sun_position_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_sun_position_(SEXP time_posix) {
+list astro_jupiter_moons_vec_(SEXP time, bool geocentric, int aberration, int nthreads);
+extern "C" SEXP _astronomyengine_astro_jupiter_moons_vec_(SEXP time, SEXP geocentric, SEXP aberration, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_sun_position_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_jupiter_moons_vec_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<bool>>(geocentric), cpp11::as_cpp<cpp11::decay_t<int>>(aberration), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_ecliptic_(double x, double y, double z, double time_posix);
-extern "C" SEXP _astronomyengine_astro_ecliptic_(SEXP x, SEXP y, SEXP z, SEXP time_posix) {
+list astro_libration_vec_(SEXP time, bool vector, int nthreads);
+extern "C" SEXP _astronomyengine_astro_libration_vec_(SEXP time, SEXP vector, SEXP nthreads) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_ecliptic_(cpp11::as_cpp<cpp11::decay_t<double>>(x), cpp11::as_cpp<cpp11::decay_t<double>>(y), cpp11::as_cpp<cpp11::decay_t<double>>(z), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_libration_vec_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<bool>>(vector), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-double astro_ecliptic_longitude_(int body, double time_posix);
-extern "C" SEXP _astronomyengine_astro_ecliptic_longitude_(SEXP body, SEXP time_posix) {
+void astro_pluto_cache_warm_(double start_posix, double stop_posix);
+extern "C" SEXP _astronomyengine_astro_pluto_cache_warm_(SEXP start_posix, SEXP stop_posix) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_ecliptic_longitude_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    astro_pluto_cache_warm_(cpp11::as_cpp<cpp11::decay_t<double>>(start_posix), cpp11::as_cpp<cpp11::decay_t<double>>(stop_posix));
+    return R_NilValue;
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_horizon_(double time_posix, double lat, double lon, double ra, double dec, int refraction);
-extern "C" SEXP _astronomyengine_astro_horizon_(SEXP time_posix, SEXP lat, SEXP lon, SEXP ra, SEXP dec, SEXP refraction) {
+list astro_pluto_cache_info_();
+extern "C" SEXP _astronomyengine_astro_pluto_cache_info_() {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_horizon_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(lat), cpp11::as_cpp<cpp11::decay_t<double>>(lon), cpp11::as_cpp<cpp11::decay_t<double>>(ra), cpp11::as_cpp<cpp11::decay_t<double>>(dec), cpp11::as_cpp<cpp11::decay_t<int>>(refraction)));
+    return cpp11::as_sexp(astro_pluto_cache_info_());
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_pair_longitude_(int body1, int body2, double time_posix);
-extern "C" SEXP _astronomyengine_astro_pair_longitude_(SEXP body1, SEXP body2, SEXP time_posix) {
+void astro_pluto_cache_free_();
+extern "C" SEXP _astronomyengine_astro_pluto_cache_free_() {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_pair_longitude_(cpp11::as_cpp<cpp11::decay_t<int>>(body1), cpp11::as_cpp<cpp11::decay_t<int>>(body2), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    astro_pluto_cache_free_();
+    return R_NilValue;
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_geo_vector_(int body, double time_posix, int aberration);
-extern "C" SEXP _astronomyengine_astro_geo_vector_(SEXP body, SEXP time_posix, SEXP aberration) {
+void astro_ephemeris_compile_(double start_posix, double stop_posix);
+extern "C" SEXP _astronomyengine_astro_ephemeris_compile_(SEXP start_posix, SEXP stop_posix) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_geo_vector_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<int>>(aberration)));
+    astro_ephemeris_compile_(cpp11::as_cpp<cpp11::decay_t<double>>(start_posix), cpp11::as_cpp<cpp11::decay_t<double>>(stop_posix));
+    return R_NilValue;
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_bary_state_(int body, double time_posix);
-extern "C" SEXP _astronomyengine_astro_bary_state_(SEXP body, SEXP time_posix) {
+list astro_ephemeris_info_();
+extern "C" SEXP _astronomyengine_astro_ephemeris_info_() {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_bary_state_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_ephemeris_info_());
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_observer_vector_(double time_posix, double latitude, double longitude, double height, bool of_date);
-extern "C" SEXP _astronomyengine_astro_observer_vector_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height, SEXP of_date) {
+void astro_ephemeris_free_();
+extern "C" SEXP _astronomyengine_astro_ephemeris_free_() {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_observer_vector_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height), cpp11::as_cpp<cpp11::decay_t<bool>>(of_date)));
+    astro_ephemeris_free_();
+    return R_NilValue;
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_observer_state_(double time_posix, double latitude, double longitude, double height, bool of_date);
-extern "C" SEXP _astronomyengine_astro_observer_state_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height, SEXP of_date) {
+void astro_ephemeris_write_(std::string path);
+extern "C" SEXP _astronomyengine_astro_ephemeris_write_(SEXP path) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_observer_state_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height), cpp11::as_cpp<cpp11::decay_t<bool>>(of_date)));
+    astro_ephemeris_write_(cpp11::as_cpp<cpp11::decay_t<std::string>>(path));
+    return R_NilValue;
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+void astro_ephemeris_load_(std::string path);
+extern "C" SEXP _astronomyengine_astro_ephemeris_load_(SEXP path) {
+  BEGIN_CPP11
+    astro_ephemeris_load_(cpp11::as_cpp<cpp11::decay_t<std::string>>(path));
+    return R_NilValue;
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+SEXP astro_grav_sim_(int origin, double time_posix, doubles x, doubles y, doubles z, doubles vx, doubles vy, doubles vz);
+extern "C" SEXP _astronomyengine_astro_grav_sim_(SEXP origin, SEXP time_posix, SEXP x, SEXP y, SEXP z, SEXP vx, SEXP vy, SEXP vz) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_grav_sim_(cpp11::as_cpp<cpp11::decay_t<int>>(origin), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<doubles>>(x), cpp11::as_cpp<cpp11::decay_t<doubles>>(y), cpp11::as_cpp<cpp11::decay_t<doubles>>(z), cpp11::as_cpp<cpp11::decay_t<doubles>>(vx), cpp11::as_cpp<cpp11::decay_t<doubles>>(vy), cpp11::as_cpp<cpp11::decay_t<doubles>>(vz)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_grav_sim_info_(SEXP sim);
+extern "C" SEXP _astronomyengine_astro_grav_sim_info_(SEXP sim) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_grav_sim_info_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(sim)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_grav_sim_step_to_(SEXP sim, doubles time_posix, int nthreads, double tolerance);
+extern "C" SEXP _astronomyengine_astro_grav_sim_step_to_(SEXP sim, SEXP time_posix, SEXP nthreads, SEXP tolerance) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_grav_sim_step_to_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(sim), cpp11::as_cpp<cpp11::decay_t<doubles>>(time_posix), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads), cpp11::as_cpp<cpp11::decay_t<double>>(tolerance)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+void astro_grav_sim_save_(SEXP sim, std::string path);
+extern "C" SEXP _astronomyengine_astro_grav_sim_save_(SEXP sim, SEXP path) {
+  BEGIN_CPP11
+    astro_grav_sim_save_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(sim), cpp11::as_cpp<cpp11::decay_t<std::string>>(path));
+    return R_NilValue;
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+SEXP astro_grav_sim_load_(std::string path);
+extern "C" SEXP _astronomyengine_astro_grav_sim_load_(SEXP path) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_grav_sim_load_(cpp11::as_cpp<cpp11::decay_t<std::string>>(path)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_observer_vector_(SEXP time, double latitude, double longitude, double height, bool of_date);
+extern "C" SEXP _astronomyengine_astro_observer_vector_(SEXP time, SEXP latitude, SEXP longitude, SEXP height, SEXP of_date) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_observer_vector_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height), cpp11::as_cpp<cpp11::decay_t<bool>>(of_date)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_observer_state_(SEXP time, double latitude, double longitude, double height, bool of_date);
+extern "C" SEXP _astronomyengine_astro_observer_state_(SEXP time, SEXP latitude, SEXP longitude, SEXP height, SEXP of_date) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_observer_state_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height), cpp11::as_cpp<cpp11::decay_t<bool>>(of_date)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -132,6 +329,20 @@ extern "C" SEXP _astronomyengine_astro_search_rise_set_ex_(SEXP body, SEXP latit
   END_CPP11
 }
 // astronomy_wrapper.cpp
+doubles astro_search_rise_set_vec_(int body, doubles latitude, doubles longitude, doubles height, doubles time_posix, int direction, double limit_days, double meters_above_ground);
+extern "C" SEXP _astronomyengine_astro_search_rise_set_vec_(SEXP body, SEXP latitude, SEXP longitude, SEXP height, SEXP time_posix, SEXP direction, SEXP limit_days, SEXP meters_above_ground) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_search_rise_set_vec_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<doubles>>(latitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(longitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(height), cpp11::as_cpp<cpp11::decay_t<doubles>>(time_posix), cpp11::as_cpp<cpp11::decay_t<int>>(direction), cpp11::as_cpp<cpp11::decay_t<double>>(limit_days), cpp11::as_cpp<cpp11::decay_t<double>>(meters_above_ground)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_rise_set_table_(integers body, integers direction, doubles start_posix, doubles latitude, doubles longitude, doubles height, double limit_days, double meters_above_ground, int nthreads);
+extern "C" SEXP _astronomyengine_astro_rise_set_table_(SEXP body, SEXP direction, SEXP start_posix, SEXP latitude, SEXP longitude, SEXP height, SEXP limit_days, SEXP meters_above_ground, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_rise_set_table_(cpp11::as_cpp<cpp11::decay_t<integers>>(body), cpp11::as_cpp<cpp11::decay_t<integers>>(direction), cpp11::as_cpp<cpp11::decay_t<doubles>>(start_posix), cpp11::as_cpp<cpp11::decay_t<doubles>>(latitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(longitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(height), cpp11::as_cpp<cpp11::decay_t<double>>(limit_days), cpp11::as_cpp<cpp11::decay_t<double>>(meters_above_ground), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
 SEXP astro_search_altitude_(int body, double latitude, double longitude, double height, double time_posix, int direction, double limit_days, double altitude);
 extern "C" SEXP _astronomyengine_astro_search_altitude_(SEXP body, SEXP latitude, SEXP longitude, SEXP height, SEXP time_posix, SEXP direction, SEXP limit_days, SEXP altitude) {
   BEGIN_CPP11
@@ -153,10 +364,10 @@ extern "C" SEXP _astronomyengine_astro_hour_angle_(SEXP body, SEXP latitude, SEX
   END_CPP11
 }
 // astronomy_wrapper.cpp
-double astro_moon_phase_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_moon_phase_(SEXP time_posix) {
+double astro_moon_phase_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_moon_phase_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_moon_phase_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_moon_phase_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -167,6 +378,13 @@ extern "C" SEXP _astronomyengine_astro_search_moon_phase_(SEXP target_lon, SEXP
   END_CPP11
 }
 // astronomy_wrapper.cpp
+doubles astro_search_moon_phase_vec_(doubles target_lon, doubles start_posix, doubles limit_days, int nthreads);
+extern "C" SEXP _astronomyengine_astro_search_moon_phase_vec_(SEXP target_lon, SEXP start_posix, SEXP limit_days, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_search_moon_phase_vec_(cpp11::as_cpp<cpp11::decay_t<doubles>>(target_lon), cpp11::as_cpp<cpp11::decay_t<doubles>>(start_posix), cpp11::as_cpp<cpp11::decay_t<doubles>>(limit_days), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
 cpp11::list astro_search_moon_quarter_(double start_time_posix);
 extern "C" SEXP _astronomyengine_astro_search_moon_quarter_(SEXP start_time_posix) {
   BEGIN_CPP11
@@ -181,6 +399,13 @@ extern "C" SEXP _astronomyengine_astro_next_moon_quarter_(SEXP quarter, SEXP tim
   END_CPP11
 }
 // astronomy_wrapper.cpp
+list astro_moon_quarters_(double start_posix, double end_posix);
+extern "C" SEXP _astronomyengine_astro_moon_quarters_(SEXP start_posix, SEXP end_posix) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_moon_quarters_(cpp11::as_cpp<cpp11::decay_t<double>>(start_posix), cpp11::as_cpp<cpp11::decay_t<double>>(end_posix)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
 list astro_search_lunar_eclipse_(double start_time_posix);
 extern "C" SEXP _astronomyengine_astro_search_lunar_eclipse_(SEXP start_time_posix) {
   BEGIN_CPP11
@@ -223,6 +448,34 @@ extern "C" SEXP _astronomyengine_next_local_solar_eclipse_(SEXP prev_eclipse_tim
   END_CPP11
 }
 // astronomy_wrapper.cpp
+list astro_lunar_eclipses_(double start_posix, double end_posix, int nthreads);
+extern "C" SEXP _astronomyengine_astro_lunar_eclipses_(SEXP start_posix, SEXP end_posix, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_lunar_eclipses_(cpp11::as_cpp<cpp11::decay_t<double>>(start_posix), cpp11::as_cpp<cpp11::decay_t<double>>(end_posix), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_global_solar_eclipses_(double start_posix, double end_posix, int nthreads);
+extern "C" SEXP _astronomyengine_astro_global_solar_eclipses_(SEXP start_posix, SEXP end_posix, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_global_solar_eclipses_(cpp11::as_cpp<cpp11::decay_t<double>>(start_posix), cpp11::as_cpp<cpp11::decay_t<double>>(end_posix), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_local_solar_eclipses_(double start_posix, double end_posix, double latitude, double longitude, double height, int nthreads);
+extern "C" SEXP _astronomyengine_astro_local_solar_eclipses_(SEXP start_posix, SEXP end_posix, SEXP latitude, SEXP longitude, SEXP height, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_local_solar_eclipses_(cpp11::as_cpp<cpp11::decay_t<double>>(start_posix), cpp11::as_cpp<cpp11::decay_t<double>>(end_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_local_solar_eclipse_grid_(double start_posix, double end_posix, doubles latitude, doubles longitude, doubles height, int nthreads);
+extern "C" SEXP _astronomyengine_astro_local_solar_eclipse_grid_(SEXP start_posix, SEXP end_posix, SEXP latitude, SEXP longitude, SEXP height, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_local_solar_eclipse_grid_(cpp11::as_cpp<cpp11::decay_t<double>>(start_posix), cpp11::as_cpp<cpp11::decay_t<double>>(end_posix), cpp11::as_cpp<cpp11::decay_t<doubles>>(latitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(longitude), cpp11::as_cpp<cpp11::decay_t<doubles>>(height), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
 list astro_search_transit_(int body, double start_time_posix);
 extern "C" SEXP _astronomyengine_astro_search_transit_(SEXP body, SEXP start_time_posix) {
   BEGIN_CPP11
@@ -265,10 +518,10 @@ extern "C" SEXP _astronomyengine_next_planet_apsis_(SEXP body, SEXP apsis_list)
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_illumination_(int body, double time_posix);
-extern "C" SEXP _astronomyengine_astro_illumination_(SEXP body, SEXP time_posix) {
+list astro_illumination_(int body, SEXP time);
+extern "C" SEXP _astronomyengine_astro_illumination_(SEXP body, SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_illumination_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_illumination_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -321,6 +574,13 @@ extern "C" SEXP _astronomyengine_astro_seasons_(SEXP year) {
   END_CPP11
 }
 // astronomy_wrapper.cpp
+list astro_seasons_vec_(integers year, int nthreads);
+extern "C" SEXP _astronomyengine_astro_seasons_vec_(SEXP year, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_seasons_vec_(cpp11::as_cpp<cpp11::decay_t<integers>>(year), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
 list astro_search_lunar_apsis_(double time_posix);
 extern "C" SEXP _astronomyengine_astro_search_lunar_apsis_(SEXP time_posix) {
   BEGIN_CPP11
@@ -335,10 +595,24 @@ extern "C" SEXP _astronomyengine_astro_constellation_(SEXP ra, SEXP dec) {
   END_CPP11
 }
 // astronomy_wrapper.cpp
-double astro_helio_distance_(int body, double time_posix);
-extern "C" SEXP _astronomyengine_astro_helio_distance_(SEXP body, SEXP time_posix) {
+list astro_constellation_vec_(doubles ra, doubles dec, int nthreads);
+extern "C" SEXP _astronomyengine_astro_constellation_vec_(SEXP ra, SEXP dec, SEXP nthreads) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_constellation_vec_(cpp11::as_cpp<cpp11::decay_t<doubles>>(ra), cpp11::as_cpp<cpp11::decay_t<doubles>>(dec), cpp11::as_cpp<cpp11::decay_t<int>>(nthreads)));
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+list astro_constellations_();
+extern "C" SEXP _astronomyengine_astro_constellations_() {
+  BEGIN_CPP11
+    return cpp11::as_sexp(astro_constellations_());
+  END_CPP11
+}
+// astronomy_wrapper.cpp
+double astro_helio_distance_(int body, SEXP time);
+extern "C" SEXP _astronomyengine_astro_helio_distance_(SEXP body, SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_helio_distance_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_helio_distance_(cpp11::as_cpp<cpp11::decay_t<int>>(body), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -384,10 +658,10 @@ extern "C" SEXP _astronomyengine_astro_rotate_vector_(SEXP rotation, SEXP vector
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_vector_from_sphere_(list sphere, double time_posix);
-extern "C" SEXP _astronomyengine_astro_vector_from_sphere_(SEXP sphere, SEXP time_posix) {
+list astro_vector_from_sphere_(list sphere, SEXP time);
+extern "C" SEXP _astronomyengine_astro_vector_from_sphere_(SEXP sphere, SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_vector_from_sphere_(cpp11::as_cpp<cpp11::decay_t<list>>(sphere), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_vector_from_sphere_(cpp11::as_cpp<cpp11::decay_t<list>>(sphere), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -405,10 +679,10 @@ extern "C" SEXP _astronomyengine_astro_equator_from_vector_(SEXP vector) {
   END_CPP11
 }
 // astronomy_wrapper.cpp
-list astro_vector_from_horizon_(list sphere, double time_posix, int refraction);
-extern "C" SEXP _astronomyengine_astro_vector_from_horizon_(SEXP sphere, SEXP time_posix, SEXP refraction) {
+list astro_vector_from_horizon_(list sphere, SEXP time, int refraction);
+extern "C" SEXP _astronomyengine_astro_vector_from_horizon_(SEXP sphere, SEXP time, SEXP refraction) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_vector_from_horizon_(cpp11::as_cpp<cpp11::decay_t<list>>(sphere), cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<int>>(refraction)));
+    return cpp11::as_sexp(astro_vector_from_horizon_(cpp11::as_cpp<cpp11::decay_t<list>>(sphere), cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<int>>(refraction)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -419,45 +693,45 @@ extern "C" SEXP _astronomyengine_astro_horizon_from_vector_(SEXP vector, SEXP re
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_eqd_eqj_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_eqd_eqj_(SEXP time_posix) {
+doubles astro_rotation_eqd_eqj_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_eqd_eqj_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_eqd_eqj_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_eqd_eqj_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_eqd_ect_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_eqd_ect_(SEXP time_posix) {
+doubles astro_rotation_eqd_ect_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_eqd_ect_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_eqd_ect_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_eqd_ect_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_eqd_ecl_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_eqd_ecl_(SEXP time_posix) {
+doubles astro_rotation_eqd_ecl_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_eqd_ecl_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_eqd_ecl_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_eqd_ecl_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_eqd_hor_(double time_posix, double latitude, double longitude, double height);
-extern "C" SEXP _astronomyengine_astro_rotation_eqd_hor_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height) {
+doubles astro_rotation_eqd_hor_(SEXP time, double latitude, double longitude, double height);
+extern "C" SEXP _astronomyengine_astro_rotation_eqd_hor_(SEXP time, SEXP latitude, SEXP longitude, SEXP height) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_eqd_hor_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
+    return cpp11::as_sexp(astro_rotation_eqd_hor_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_eqj_eqd_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_eqj_eqd_(SEXP time_posix) {
+doubles astro_rotation_eqj_eqd_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_eqj_eqd_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_eqj_eqd_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_eqj_eqd_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_eqj_ect_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_eqj_ect_(SEXP time_posix) {
+doubles astro_rotation_eqj_ect_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_eqj_ect_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_eqj_ect_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_eqj_ect_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -468,31 +742,31 @@ extern "C" SEXP _astronomyengine_astro_rotation_eqj_ecl_() {
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_eqj_hor_(double time_posix, double latitude, double longitude, double height);
-extern "C" SEXP _astronomyengine_astro_rotation_eqj_hor_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height) {
+doubles astro_rotation_eqj_hor_(SEXP time, double latitude, double longitude, double height);
+extern "C" SEXP _astronomyengine_astro_rotation_eqj_hor_(SEXP time, SEXP latitude, SEXP longitude, SEXP height) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_eqj_hor_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
+    return cpp11::as_sexp(astro_rotation_eqj_hor_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_ect_eqd_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_ect_eqd_(SEXP time_posix) {
+doubles astro_rotation_ect_eqd_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_ect_eqd_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_ect_eqd_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_ect_eqd_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_ect_eqj_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_ect_eqj_(SEXP time_posix) {
+doubles astro_rotation_ect_eqj_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_ect_eqj_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_ect_eqj_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_ect_eqj_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_ecl_eqd_(double time_posix);
-extern "C" SEXP _astronomyengine_astro_rotation_ecl_eqd_(SEXP time_posix) {
+doubles astro_rotation_ecl_eqd_(SEXP time);
+extern "C" SEXP _astronomyengine_astro_rotation_ecl_eqd_(SEXP time) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_ecl_eqd_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix)));
+    return cpp11::as_sexp(astro_rotation_ecl_eqd_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -503,31 +777,31 @@ extern "C" SEXP _astronomyengine_astro_rotation_ecl_eqj_() {
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_ecl_hor_(double time_posix, double latitude, double longitude, double height);
-extern "C" SEXP _astronomyengine_astro_rotation_ecl_hor_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height) {
+doubles astro_rotation_ecl_hor_(SEXP time, double latitude, double longitude, double height);
+extern "C" SEXP _astronomyengine_astro_rotation_ecl_hor_(SEXP time, SEXP latitude, SEXP longitude, SEXP height) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_ecl_hor_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
+    return cpp11::as_sexp(astro_rotation_ecl_hor_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_hor_eqd_(double time_posix, double latitude, double longitude, double height);
-extern "C" SEXP _astronomyengine_astro_rotation_hor_eqd_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height) {
+doubles astro_rotation_hor_eqd_(SEXP time, double latitude, double longitude, double height);
+extern "C" SEXP _astronomyengine_astro_rotation_hor_eqd_(SEXP time, SEXP latitude, SEXP longitude, SEXP height) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_hor_eqd_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
+    return cpp11::as_sexp(astro_rotation_hor_eqd_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_hor_eqj_(double time_posix, double latitude, double longitude, double height);
-extern "C" SEXP _astronomyengine_astro_rotation_hor_eqj_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height) {
+doubles astro_rotation_hor_eqj_(SEXP time, double latitude, double longitude, double height);
+extern "C" SEXP _astronomyengine_astro_rotation_hor_eqj_(SEXP time, SEXP latitude, SEXP longitude, SEXP height) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_hor_eqj_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
+    return cpp11::as_sexp(astro_rotation_hor_eqj_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
-doubles astro_rotation_hor_ecl_(double time_posix, double latitude, double longitude, double height);
-extern "C" SEXP _astronomyengine_astro_rotation_hor_ecl_(SEXP time_posix, SEXP latitude, SEXP longitude, SEXP height) {
+doubles astro_rotation_hor_ecl_(SEXP time, double latitude, double longitude, double height);
+extern "C" SEXP _astronomyengine_astro_rotation_hor_ecl_(SEXP time, SEXP latitude, SEXP longitude, SEXP height) {
   BEGIN_CPP11
-    return cpp11::as_sexp(astro_rotation_hor_ecl_(cpp11::as_cpp<cpp11::decay_t<double>>(time_posix), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
+    return cpp11::as_sexp(astro_rotation_hor_ecl_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(time), cpp11::as_cpp<cpp11::decay_t<double>>(latitude), cpp11::as_cpp<cpp11::decay_t<double>>(longitude), cpp11::as_cpp<cpp11::decay_t<double>>(height)));
   END_CPP11
 }
 // astronomy_wrapper.cpp
@@ -553,23 +827,52 @@ static const R_CallMethodDef CallEntries[] = {
     {"_astronomyengine_astro_body_name_",                   (DL_FUNC) &_astronomyengine_astro_body_name_,                   1},
     {"_astronomyengine_astro_combine_rotation_",            (DL_FUNC) &_astronomyengine_astro_combine_rotation_,            2},
     {"_astronomyengine_astro_constellation_",               (DL_FUNC) &_astronomyengine_astro_constellation_,               2},
+    {"_astronomyengine_astro_constellation_vec_",           (DL_FUNC) &_astronomyengine_astro_constellation_vec_,           3},
+    {"_astronomyengine_astro_constellations_",              (DL_FUNC) &_astronomyengine_astro_constellations_,              0},
     {"_astronomyengine_astro_current_time_",                (DL_FUNC) &_astronomyengine_astro_current_time_,                0},
+    {"_astronomyengine_astro_delta_t_",                     (DL_FUNC) &_astronomyengine_astro_delta_t_,                     2},
+    {"_astronomyengine_astro_earth_rotation_angle_vec_",    (DL_FUNC) &_astronomyengine_astro_earth_rotation_angle_vec_,    1},
     {"_astronomyengine_astro_ecliptic_",                    (DL_FUNC) &_astronomyengine_astro_ecliptic_,                    4},
     {"_astronomyengine_astro_ecliptic_longitude_",          (DL_FUNC) &_astronomyengine_astro_ecliptic_longitude_,          2},
     {"_astronomyengine_astro_elongation_",                  (DL_FUNC) &_astronomyengine_astro_elongation_,                  2},
+    {"_astronomyengine_astro_ephemeris_compile_",           (DL_FUNC) &_astronomyengine_astro_ephemeris_compile_,           2},
+    {"_astronomyengine_astro_ephemeris_free_",              (DL_FUNC) &_astronomyengine_astro_ephemeris_free_,              0},
+    {"_astronomyengine_astro_ephemeris_info_",              (DL_FUNC) &_astronomyengine_astro_ephemeris_info_,              0},
+    {"_astronomyengine_astro_ephemeris_load_",              (DL_FUNC) &_astronomyengine_astro_ephemeris_load_,              1},
+    {"_astronomyengine_astro_ephemeris_write_",             (DL_FUNC) &_astronomyengine_astro_ephemeris_write_,             1},
+    {"_astronomyengine_astro_epoch_",                       (DL_FUNC) &_astronomyengine_astro_epoch_,                       1},
+    {"_astronomyengine_astro_epoch_subset_",                (DL_FUNC) &_astronomyengine_astro_epoch_subset_,                2},
+    {"_astronomyengine_astro_epoch_time_",                  (DL_FUNC) &_astronomyengine_astro_epoch_time_,                  1},
     {"_astronomyengine_astro_equator_",                     (DL_FUNC) &_astronomyengine_astro_equator_,                     7},
     {"_astronomyengine_astro_equator_from_vector_",         (DL_FUNC) &_astronomyengine_astro_equator_from_vector_,         1},
+    {"_astronomyengine_astro_equator_vec_",                 (DL_FUNC) &_astronomyengine_astro_equator_vec_,                 8},
     {"_astronomyengine_astro_geo_vector_",                  (DL_FUNC) &_astronomyengine_astro_geo_vector_,                  3},
+    {"_astronomyengine_astro_geo_vector_vec_",              (DL_FUNC) &_astronomyengine_astro_geo_vector_vec_,              4},
+    {"_astronomyengine_astro_get_delta_t_model_",           (DL_FUNC) &_astronomyengine_astro_get_delta_t_model_,           0},
+    {"_astronomyengine_astro_global_solar_eclipses_",       (DL_FUNC) &_astronomyengine_astro_global_solar_eclipses_,       3},
+    {"_astronomyengine_astro_grav_sim_",                    (DL_FUNC) &_astronomyengine_astro_grav_sim_,                    8},
+    {"_astronomyengine_astro_grav_sim_info_",               (DL_FUNC) &_astronomyengine_astro_grav_sim_info_,               1},
+    {"_astronomyengine_astro_grav_sim_load_",               (DL_FUNC) &_astronomyengine_astro_grav_sim_load_,               1},
+    {"_astronomyengine_astro_grav_sim_save_",               (DL_FUNC) &_astronomyengine_astro_grav_sim_save_,               2},
+    {"_astronomyengine_astro_grav_sim_step_to_",            (DL_FUNC) &_astronomyengine_astro_grav_sim_step_to_,            4},
     {"_astronomyengine_astro_helio_distance_",              (DL_FUNC) &_astronomyengine_astro_helio_distance_,              2},
     {"_astronomyengine_astro_helio_vector_",                (DL_FUNC) &_astronomyengine_astro_helio_vector_,                2},
+    {"_astronomyengine_astro_helio_vector_vec_",            (DL_FUNC) &_astronomyengine_astro_helio_vector_vec_,            2},
     {"_astronomyengine_astro_horizon_",                     (DL_FUNC) &_astronomyengine_astro_horizon_,                     6},
     {"_astronomyengine_astro_horizon_from_vector_",         (DL_FUNC) &_astronomyengine_astro_horizon_from_vector_,         2},
+    {"_astronomyengine_astro_horizon_vec_",                 (DL_FUNC) &_astronomyengine_astro_horizon_vec_,                 7},
     {"_astronomyengine_astro_hour_angle_",                  (DL_FUNC) &_astronomyengine_astro_hour_angle_,                  5},
     {"_astronomyengine_astro_identity_matrix_",             (DL_FUNC) &_astronomyengine_astro_identity_matrix_,             0},
     {"_astronomyengine_astro_illumination_",                (DL_FUNC) &_astronomyengine_astro_illumination_,                2},
     {"_astronomyengine_astro_inverse_rotation_",            (DL_FUNC) &_astronomyengine_astro_inverse_rotation_,            1},
+    {"_astronomyengine_astro_jupiter_moons_vec_",           (DL_FUNC) &_astronomyengine_astro_jupiter_moons_vec_,           4},
+    {"_astronomyengine_astro_libration_vec_",               (DL_FUNC) &_astronomyengine_astro_libration_vec_,               3},
+    {"_astronomyengine_astro_local_solar_eclipse_grid_",    (DL_FUNC) &_astronomyengine_astro_local_solar_eclipse_grid_,    6},
+    {"_astronomyengine_astro_local_solar_eclipses_",        (DL_FUNC) &_astronomyengine_astro_local_solar_eclipses_,        6},
+    {"_astronomyengine_astro_lunar_eclipses_",              (DL_FUNC) &_astronomyengine_astro_lunar_eclipses_,              3},
     {"_astronomyengine_astro_make_time_",                   (DL_FUNC) &_astronomyengine_astro_make_time_,                   6},
     {"_astronomyengine_astro_moon_phase_",                  (DL_FUNC) &_astronomyengine_astro_moon_phase_,                  1},
+    {"_astronomyengine_astro_moon_quarters_",               (DL_FUNC) &_astronomyengine_astro_moon_quarters_,               2},
     {"_astronomyengine_astro_next_lunar_eclipse_",          (DL_FUNC) &_astronomyengine_astro_next_lunar_eclipse_,          1},
     {"_astronomyengine_astro_next_moon_quarter_",           (DL_FUNC) &_astronomyengine_astro_next_moon_quarter_,           2},
     {"_astronomyengine_astro_next_transit_",                (DL_FUNC) &_astronomyengine_astro_next_transit_,                2},
@@ -578,6 +881,10 @@ static const R_CallMethodDef CallEntries[] = {
     {"_astronomyengine_astro_observer_vector_",             (DL_FUNC) &_astronomyengine_astro_observer_vector_,             5},
     {"_astronomyengine_astro_pair_longitude_",              (DL_FUNC) &_astronomyengine_astro_pair_longitude_,              3},
     {"_astronomyengine_astro_pivot_",                       (DL_FUNC) &_astronomyengine_astro_pivot_,                       3},
+    {"_astronomyengine_astro_pluto_cache_free_",            (DL_FUNC) &_astronomyengine_astro_pluto_cache_free_,            0},
+    {"_astronomyengine_astro_pluto_cache_info_",            (DL_FUNC) &_astronomyengine_astro_pluto_cache_info_,            0},
+    {"_astronomyengine_astro_pluto_cache_warm_",            (DL_FUNC) &_astronomyengine_astro_pluto_cache_warm_,            2},
+    {"_astronomyengine_astro_rise_set_table_",              (DL_FUNC) &_astronomyengine_astro_rise_set_table_,              9},
     {"_astronomyengine_astro_rotate_vector_",               (DL_FUNC) &_astronomyengine_astro_rotate_vector_,               2},
     {"_astronomyengine_astro_rotation_ecl_eqd_",            (DL_FUNC) &_astronomyengine_astro_rotation_ecl_eqd_,            1},
     {"_astronomyengine_astro_rotation_ecl_eqj_",            (DL_FUNC) &_astronomyengine_astro_rotation_ecl_eqj_,            0},
@@ -604,13 +911,18 @@ static const R_CallMethodDef CallEntries[] = {
     {"_astronomyengine_astro_search_lunar_eclipse_",        (DL_FUNC) &_astronomyengine_astro_search_lunar_eclipse_,        1},
     {"_astronomyengine_astro_search_max_elongation_",       (DL_FUNC) &_astronomyengine_astro_search_max_elongation_,       2},
     {"_astronomyengine_astro_search_moon_phase_",           (DL_FUNC) &_astronomyengine_astro_search_moon_phase_,           3},
+    {"_astronomyengine_astro_search_moon_phase_vec_",       (DL_FUNC) &_astronomyengine_astro_search_moon_phase_vec_,       4},
     {"_astronomyengine_astro_search_moon_quarter_",         (DL_FUNC) &_astronomyengine_astro_search_moon_quarter_,         1},
     {"_astronomyengine_astro_search_peak_magnitude_",       (DL_FUNC) &_astronomyengine_astro_search_peak_magnitude_,       2},
     {"_astronomyengine_astro_search_relative_longitude_",   (DL_FUNC) &_astronomyengine_astro_search_relative_longitude_,   3},
     {"_astronomyengine_astro_search_rise_set_ex_",          (DL_FUNC) &_astronomyengine_astro_search_rise_set_ex_,          8},
+    {"_astronomyengine_astro_search_rise_set_vec_",         (DL_FUNC) &_astronomyengine_astro_search_rise_set_vec_,         8},
     {"_astronomyengine_astro_search_sun_longitude_",        (DL_FUNC) &_astronomyengine_astro_search_sun_longitude_,        3},
     {"_astronomyengine_astro_search_transit_",              (DL_FUNC) &_astronomyengine_astro_search_transit_,              2},
     {"_astronomyengine_astro_seasons_",                     (DL_FUNC) &_astronomyengine_astro_seasons_,                     1},
+    {"_astronomyengine_astro_seasons_vec_",                 (DL_FUNC) &_astronomyengine_astro_seasons_vec_,                 2},
+    {"_astronomyengine_astro_set_delta_t_model_",           (DL_FUNC) &_astronomyengine_astro_set_delta_t_model_,           1},
+    {"_astronomyengine_astro_sidereal_time_vec_",           (DL_FUNC) &_astronomyengine_astro_sidereal_time_vec_,           4},
     {"_astronomyengine_astro_sphere_from_vector_",          (DL_FUNC) &_astronomyengine_astro_sphere_from_vector_,          1},
     {"_astronomyengine_astro_sun_position_",                (DL_FUNC) &_astronomyengine_astro_sun_position_,                1},
     {"_astronomyengine_astro_vector_from_horizon_",         (DL_FUNC) &_astronomyengine_astro_vector_from_horizon_,         3},